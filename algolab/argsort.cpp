@@ -0,0 +1 @@
+#include "argsort.h"
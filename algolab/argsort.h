@@ -0,0 +1,171 @@
+#pragma once
+
+#include <vector>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <ranges>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include "sort_ranges.h"
+#include "radix_sort.h"
+
+namespace algolab {
+
+/**
+ * @brief Argsort and key-index sorting for wide records
+ * @details
+ * Sorting large structs in place moves whole records on every swap. Under
+ * algolab::sort_key the sort runs on compact (key, index) pairs instead:
+ *  - argsort returns the permutation that sorts a range by a projected key,
+ *  - applyPermutation reorders a range by a permutation in place, following its
+ *    cycles so that each record is moved once (plus one temporary per cycle),
+ *  - sortByKey combines both: the records are gathered into sorted order in a
+ *    single pass after the pairs are sorted.
+ * Indices are 32-bit while the range has fewer than 2^32 elements, which keeps
+ * (int key, index) pairs at 8 bytes. Arithmetic keys of up to 32 bits under the
+ * default ascending order are packed with their index into one 64-bit radix key and
+ * sorted with the LSD radix sort; wider arithmetic keys are compared through their
+ * radix keys. Equal keys keep their input order.
+ */
+
+namespace sort_key {
+
+namespace detail {
+
+template <typename Key, typename Index>
+struct KeyIndex {
+    Key key;
+    Index index;
+};
+
+// Sorts the pairs by less (a strict total order) and returns their indices in sorted order
+template <typename Key, typename Index, typename Less>
+std::vector<size_t> sortedIndices(std::vector<KeyIndex<Key, Index>>& pairs, Less less) {
+    ranges::introSortAll(pairs, less);
+
+    std::vector<size_t> perm(pairs.size());
+    for (size_t j = 0; j < pairs.size(); ++j) {
+        perm[j] = pairs[j].index;
+    }
+    return perm;
+}
+
+template <typename Index, typename R, typename Comp, typename Proj>
+std::vector<size_t> argsort(R& records, Comp& comp, Proj& proj) {
+    using Key = std::remove_cvref_t<std::invoke_result_t<Proj&, std::ranges::range_reference_t<R>>>;
+    const size_t n = static_cast<size_t>(std::ranges::size(records));
+
+    // Arithmetic key, ascending: folded radix keys compare as the keys do, -0.0 equal to +0.0
+    constexpr bool radixKeyed = std::is_arithmetic_v<Key> && !std::is_same_v<Key, bool>
+        && (std::is_same_v<Comp, std::ranges::less> || std::is_same_v<Comp, std::less<>>
+            || std::is_same_v<Comp, std::less<Key>>);
+
+    if constexpr (radixKeyed && sizeof(Key) <= 4 && sizeof(Index) == 4) {
+        // Up to 32 bits: (radix key << 32 | index) sorts as the pair does
+        std::vector<uint64_t> packed;
+        packed.reserve(n);
+        uint64_t i = 0;
+        for (auto&& record : records) {
+            uint64_t key = sort_radix::toFoldedRadixKey(static_cast<Key>(std::invoke(proj, record)));
+            packed.push_back(key << 32 | i++);
+        }
+        sort_radix::radixSortAll(packed);
+
+        std::vector<size_t> perm(n);
+        for (size_t j = 0; j < n; ++j) {
+            perm[j] = static_cast<uint32_t>(packed[j]);
+        }
+        return perm;
+    } else if constexpr (radixKeyed) {
+        // Wider keys: (radix key, index) pairs, one integer comparison per step
+        using Radix = sort_radix::radix_key_t<Key>;
+        std::vector<KeyIndex<Radix, Index>> pairs;
+        pairs.reserve(n);
+        Index i = 0;
+        for (auto&& record : records) {
+            pairs.push_back({sort_radix::toFoldedRadixKey(static_cast<Key>(std::invoke(proj, record))), i++});
+        }
+        return sortedIndices(pairs, [](const KeyIndex<Radix, Index>& a, const KeyIndex<Radix, Index>& b) {
+            return a.key < b.key || (a.key == b.key && a.index < b.index);
+        });
+    } else {
+        std::vector<KeyIndex<Key, Index>> pairs;
+        pairs.reserve(n);
+        Index i = 0;
+        for (auto&& record : records) {
+            pairs.push_back({std::invoke(proj, record), i++});
+        }
+
+        // Ties are broken by index, which makes the order total and the sort stable
+        return sortedIndices(pairs, [&comp](const KeyIndex<Key, Index>& a, const KeyIndex<Key, Index>& b) {
+            if (std::invoke(comp, a.key, b.key)) return true;
+            if (std::invoke(comp, b.key, a.key)) return false;
+            return a.index < b.index;
+        });
+    }
+}
+
+} // namespace detail
+
+// Permutation perm such that records[perm[0]], records[perm[1]]... is sorted by key
+template <std::ranges::random_access_range R, typename Comp = std::ranges::less, typename Proj = std::identity>
+    requires std::ranges::sized_range<R>
+std::vector<size_t> argsort(R&& records, Comp comp = {}, Proj proj = {}) {
+    if (std::ranges::size(records) <= std::numeric_limits<uint32_t>::max()) {
+        return detail::argsort<uint32_t>(records, comp, proj);
+    }
+    return detail::argsort<size_t>(records, comp, proj);
+}
+
+// Reorders records in place so that the new records[i] is the old records[perm[i]]
+// Each cycle of perm is followed once; perm is taken by value and used as the visited marks.
+// Throws std::invalid_argument if perm is not a permutation of 0..n-1; records then hold
+// every input record, in an unspecified order.
+template <std::ranges::random_access_range R>
+    requires std::ranges::sized_range<R>
+void applyPermutation(R&& records, std::vector<size_t> perm) {
+    const size_t n = static_cast<size_t>(std::ranges::size(records));
+    if (perm.size() != n) {
+        throw std::invalid_argument("applyPermutation: permutation size does not match the range");
+    }
+
+    auto first = std::ranges::begin(records);
+    using D = std::ranges::range_difference_t<R>;
+    for (size_t start = 0; start < n; ++start) {
+        if (perm[start] == start) continue;
+
+        auto held = std::ranges::iter_move(first + static_cast<D>(start));
+        size_t hole = start;
+        while (true) {
+            size_t from = perm[hole];
+            // Out of range, or reaching an index already placed: perm is not a permutation
+            if (from >= n || (from != start && perm[from] == from)) {
+                // The cycle's only hole takes back the record moved out of its start
+                first[static_cast<D>(hole)] = std::move(held);
+                throw std::invalid_argument("applyPermutation: not a permutation");
+            }
+            perm[hole] = hole;
+            if (from == start) break;
+            first[static_cast<D>(hole)] = std::ranges::iter_move(first + static_cast<D>(from));
+            hole = from;
+        }
+        first[static_cast<D>(hole)] = std::move(held);
+    }
+}
+
+// Stable sort of records by a projected key: sorts (key, index) pairs, then moves
+// every record once into place
+template <std::ranges::random_access_range R, typename Comp = std::ranges::less, typename Proj = std::identity>
+    requires std::ranges::sized_range<R>
+void sortByKey(R&& records, Comp comp = {}, Proj proj = {}) {
+    applyPermutation(records, argsort(records, std::move(comp), std::move(proj)));
+}
+
+} // namespace sort_key
+
+} // namespace algolab
@@ -0,0 +1 @@
+#include "block_partition.h"
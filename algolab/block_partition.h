@@ -0,0 +1,241 @@
+#pragma once
+
+#include <vector>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+namespace algolab {
+
+/**
+ * @brief Branchless block partitioning (BlockQuicksort)
+ * @details
+ * Classic Hoare/Lomuto loops branch on every comparison, which mispredicts about
+ * half of the time on random keys. The block partitioner instead scans a block of
+ * BLOCK_PARTITION_SIZE elements on each side and only records, without branching,
+ * the offsets of the elements that sit on the wrong side:
+ *     offsets[count] = i; count += !(element < pivot);
+ * The recorded elements are then swapped pairwise, so the only data-dependent
+ * branches left are the loop exits.
+ * Reference: Edelkamp & Weiss, "BlockQuicksort: How Branch Mispredictions don't
+ * affect Quicksort" (2016), with the block handling layout popularised by pdqsort.
+ */
+
+// Selects the partitioning routine used by the quicksort family
+enum class PartitionScheme {
+    Classic, // Hoare (introsort) or Lomuto (iterative quicksort)
+    Block    // Branchless block partitioning
+};
+
+constexpr int BLOCK_PARTITION_SIZE = 64;
+
+namespace detail {
+
+// Swaps the num elements recorded at first + offsetsL[i] and last - offsetsR[i]
+// When both blocks have the same count a plain swap loop is used, otherwise
+// a cyclic rotation that needs one temporary instead of three moves per pair.
+template <typename T>
+void swapOffsets(T* first, T* last, const unsigned char* offsetsL, const unsigned char* offsetsR,
+                 size_t num, bool useSwaps) {
+    if (useSwaps) {
+        for (size_t i = 0; i < num; ++i) {
+            std::swap(first[offsetsL[i]], *(last - offsetsR[i]));
+        }
+    } else if (num > 0) {
+        T* l = first + offsetsL[0];
+        T* r = last - offsetsR[0];
+        T tmp(std::move(*l));
+        *l = std::move(*r);
+        for (size_t i = 1; i < num; ++i) {
+            l = first + offsetsL[i];
+            *r = std::move(*l);
+            r = last - offsetsR[i];
+            *l = std::move(*r);
+        }
+        *r = std::move(tmp);
+    }
+}
+
+} // namespace detail
+
+// Partitions [begin, end) around the pivot stored in *begin
+// Elements smaller than the pivot end up on its left, the others on its right.
+// Requires an element not smaller than the pivot at end - 1 (median-of-three guarantees it).
+// Returns the final position of the pivot; alreadyPartitioned is set when no
+// element had to be moved.
+template <typename T>
+T* blockPartitionRange(T* begin, T* end, bool& alreadyPartitioned) {
+    T pivot(std::move(*begin));
+    T* first = begin;
+    T* last = end;
+
+    // Skip the prefix and suffix that are already on the right side
+    while (*++first < pivot) {}
+    if (first - 1 == begin) {
+        while (first < last && !(*--last < pivot)) {}
+    } else {
+        while (!(*--last < pivot)) {}
+    }
+
+    alreadyPartitioned = first >= last;
+    if (!alreadyPartitioned) {
+        std::swap(*first, *last);
+        ++first;
+
+        alignas(64) unsigned char offsetsL[BLOCK_PARTITION_SIZE];
+        alignas(64) unsigned char offsetsR[BLOCK_PARTITION_SIZE];
+
+        T* offsetsLBase = first;
+        T* offsetsRBase = last;
+        size_t numL = 0;
+        size_t numR = 0;
+        size_t startL = 0;
+        size_t startR = 0;
+
+        while (first < last) {
+            // Only refill the blocks that are empty, splitting what is left when both are
+            size_t numUnknown = static_cast<size_t>(last - first);
+            size_t leftSplit = numL == 0 ? (numR == 0 ? numUnknown / 2 : numUnknown) : 0;
+            size_t rightSplit = numR == 0 ? (numUnknown - leftSplit) : 0;
+
+            if (leftSplit >= BLOCK_PARTITION_SIZE) {
+                for (size_t i = 0; i < BLOCK_PARTITION_SIZE; ++i) {
+                    offsetsL[numL] = static_cast<unsigned char>(i);
+                    numL += !(*first < pivot);
+                    ++first;
+                }
+            } else {
+                for (size_t i = 0; i < leftSplit; ++i) {
+                    offsetsL[numL] = static_cast<unsigned char>(i);
+                    numL += !(*first < pivot);
+                    ++first;
+                }
+            }
+
+            if (rightSplit >= BLOCK_PARTITION_SIZE) {
+                for (size_t i = 0; i < BLOCK_PARTITION_SIZE; ++i) {
+                    offsetsR[numR] = static_cast<unsigned char>(i + 1);
+                    numR += *--last < pivot;
+                }
+            } else {
+                for (size_t i = 0; i < rightSplit; ++i) {
+                    offsetsR[numR] = static_cast<unsigned char>(i + 1);
+                    numR += *--last < pivot;
+                }
+            }
+
+            size_t num = std::min(numL, numR);
+            detail::swapOffsets(offsetsLBase, offsetsRBase, offsetsL + startL, offsetsR + startR, num, numL == numR);
+            numL -= num;
+            numR -= num;
+            startL += num;
+            startR += num;
+
+            if (numL == 0) {
+                startL = 0;
+                offsetsLBase = first;
+            }
+            if (numR == 0) {
+                startR = 0;
+                offsetsRBase = last;
+            }
+        }
+
+        // One block may still hold misplaced elements: move them next to the boundary
+        if (numL) {
+            while (numL--) {
+                std::swap(offsetsLBase[offsetsL[startL + numL]], *--last);
+            }
+            first = last;
+        }
+        if (numR) {
+            while (numR--) {
+                std::swap(*(offsetsRBase - offsetsR[startR + numR]), *first);
+                ++first;
+            }
+            last = first;
+        }
+    }
+
+    T* pivotPos = first - 1;
+    *begin = std::move(*pivotPos);
+    *pivotPos = std::move(pivot);
+    return pivotPos;
+}
+
+namespace detail {
+
+// Orders arr[mid] <= arr[low] <= arr[high]: median at low, sentinel at high
+template <typename T>
+void medianToLow(std::vector<T>& arr, int low, int high) {
+    int mid = low + (high - low) / 2;
+    if (arr[low] < arr[mid]) std::swap(arr[low], arr[mid]);
+    if (arr[high] < arr[low]) std::swap(arr[high], arr[low]);
+    if (arr[low] < arr[mid]) std::swap(arr[low], arr[mid]);
+}
+
+} // namespace detail
+
+// Partitions arr[low..high] around arr[low] with the equal keys on the left, returns the
+// final pivot position: arr[low..pivot] <= pivot < arr[pivot + 1..high].
+// Meant for ranges without any key smaller than the pivot, the left side then only holds
+// keys equal to it and is already sorted (pdqsort's partition_left).
+template <typename T>
+int partitionLeft(std::vector<T>& arr, int low, int high) {
+    // A copy: arr[low] keeps the pivot value and stops the right scan
+    const T pivot = arr[low];
+    int first = low;
+    int last = high + 1;
+
+    while (pivot < arr[--last]) {}
+    if (last == high) {
+        while (first < last && !(pivot < arr[++first])) {}
+    } else {
+        while (!(pivot < arr[++first])) {}
+    }
+
+    while (first < last) {
+        std::swap(arr[first], arr[last]);
+        while (pivot < arr[--last]) {}
+        while (!(pivot < arr[++first])) {}
+    }
+
+    std::swap(arr[low], arr[last]);
+    return last;
+}
+
+// Block partition of arr[low..high] (at least 3 elements), returns the pivot index
+// The median of arr[low], arr[mid] and arr[high] becomes the pivot.
+template <typename T>
+int blockPartition(std::vector<T>& arr, int low, int high) {
+    detail::medianToLow(arr, low, high);
+
+    bool alreadyPartitioned = false;
+    T* begin = arr.data() + low;
+    T* pivotPos = blockPartitionRange(begin, arr.data() + high + 1, alreadyPartitioned);
+    return low + static_cast<int>(pivotPos - begin);
+}
+
+// Partitioning step of the Block quicksort schemes, returns the pivot index
+// leftmost is false when arr[low - 1] is a previous pivot, i.e. not greater than any key of
+// the range. When that pivot equals the new median, nothing in the range is smaller:
+// partitionLeft gathers every equal key on the left and equalLeft tells the caller that
+// arr[low..pivot] is done. Without it equal keys all go right and all-equal or
+// few-distinct inputs only lose one element per level.
+template <typename T>
+int blockPartition(std::vector<T>& arr, int low, int high, bool leftmost, bool& equalLeft) {
+    detail::medianToLow(arr, low, high);
+
+    equalLeft = !leftmost && !(arr[low - 1] < arr[low]);
+    if (equalLeft) {
+        return partitionLeft(arr, low, high);
+    }
+
+    bool alreadyPartitioned = false;
+    T* begin = arr.data() + low;
+    T* pivotPos = blockPartitionRange(begin, arr.data() + high + 1, alreadyPartitioned);
+    return low + static_cast<int>(pivotPos - begin);
+}
+
+} // namespace algolab
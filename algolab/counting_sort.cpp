@@ -0,0 +1 @@
+#include "counting_sort.h"
@@ -0,0 +1,266 @@
+#pragma once
+
+#include <vector>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include "radix_sort.h"
+#include "argsort.h"
+#include "thread_pool.h"
+
+namespace algolab {
+
+/**
+ * @brief Counting sort for integral keys of a small range
+ * @details
+ * Columns such as quantities or price ticks often hold keys from a few thousand
+ * distinct values. Under algolab::sort_count such inputs are sorted in O(n + range):
+ *  - one min / max pass finds the key range; the counting path is taken when it
+ *    spans at most COUNTING_MAX_RANGE values (a histogram of 32-bit counters that
+ *    stays in L2) and at most COUNTING_RANGE_PER_ELEMENT values per element,
+ *  - countingSortOn counts the keys and rewrites arr bucket by bucket; no element
+ *    is moved, so the output is the histogram replayed,
+ *  - stableCountingSortOn sorts records by an integral projected key, equal keys
+ *    keeping their input order: bucket ids are cached in one 16-bit pass and the
+ *    records are scattered through a scratch buffer.
+ * From COUNTING_PARALLEL_MIN elements, on a pool with more than one thread, the
+ * min / max pass, the histograms (one per block, summed afterwards), the rewrite and
+ * the scatter run as one task per block.
+ * tryCountingSort* return false and leave arr untouched when the range is too wide;
+ * countingSort* fall back to LSD radix sort, stableCountingSort* to sort_key::sortByKey.
+ */
+
+namespace sort_count {
+
+// Widest key range sorted by counting: 2^16 counters of 32 bits, 256 KB
+constexpr size_t COUNTING_MAX_RANGE = size_t(1) << 16;
+// Counting sort pays while the histogram is not much larger than the input
+constexpr size_t COUNTING_RANGE_PER_ELEMENT = 2;
+// Inputs from this size are counted in parallel blocks
+constexpr size_t COUNTING_PARALLEL_MIN = size_t(1) << 18;
+
+template <typename T>
+constexpr bool countingSortable = std::is_integral_v<T> && !std::is_same_v<T, bool>;
+
+namespace detail {
+
+// Blocks the input is split into: one per pool thread for large inputs, else one
+inline size_t blockCount(size_t n, ThreadPool* pool) {
+    if (pool == nullptr || pool->size() < 2 || n < COUNTING_PARALLEL_MIN) return 1;
+    return std::min<size_t>(pool->size(), n / (COUNTING_PARALLEL_MIN / 4));
+}
+
+// Runs body(block, first, last) for every block of [0, n), as pool tasks when there are several
+template <typename Body>
+void forEachBlock(size_t n, size_t blocks, ThreadPool* pool, Body body) {
+    if (blocks == 1) {
+        body(size_t(0), size_t(0), n);
+        return;
+    }
+    TaskGroup group(*pool);
+    for (size_t block = 0; block < blocks; ++block) {
+        group.run([&body, n, blocks, block]() { body(block, n * block / blocks, n * (block + 1) / blocks); });
+    }
+    group.wait();
+}
+
+// Number of buckets for keys in [low, high] of n elements, 0 when counting does not pay
+template <typename K>
+size_t countingRange(K low, K high, size_t n) {
+    using Key = sort_radix::radix_key_t<K>;
+    const Key width = static_cast<Key>(sort_radix::toRadixKey(high) - sort_radix::toRadixKey(low));
+    if (width >= COUNTING_MAX_RANGE) return 0;
+    const size_t range = static_cast<size_t>(width) + 1;
+    return range <= COUNTING_RANGE_PER_ELEMENT * n ? range : 0;
+}
+
+// Bucket of key in a histogram starting at low
+template <typename K>
+size_t bucketOf(K key, K low) {
+    return static_cast<size_t>(static_cast<sort_radix::radix_key_t<K>>(key - low));
+}
+
+// Smallest and largest of keyOf(arr[i]) over every block
+template <typename T, typename KeyOf>
+auto keyBounds(const std::vector<T>& arr, size_t blocks, ThreadPool* pool, KeyOf& keyOf) {
+    using K = std::remove_cvref_t<std::invoke_result_t<KeyOf&, const T&>>;
+    std::vector<std::pair<K, K>> bounds(blocks);
+    forEachBlock(arr.size(), blocks, pool, [&](size_t block, size_t first, size_t last) {
+        K low = keyOf(arr[first]);
+        K high = low;
+        for (size_t i = first + 1; i < last; ++i) {
+            K key = keyOf(arr[i]);
+            low = std::min(low, key);
+            high = std::max(high, key);
+        }
+        bounds[block] = {low, high};
+    });
+    std::pair<K, K> result = bounds[0];
+    for (const auto& [low, high] : bounds) {
+        result.first = std::min(result.first, low);
+        result.second = std::max(result.second, high);
+    }
+    return result;
+}
+
+template <typename T>
+bool countingSort(std::vector<T>& arr, ThreadPool* pool) {
+    static_assert(countingSortable<T>, "Counting sort requires an integral type");
+    const size_t n = arr.size();
+    if (n < sort_radix::RADIX_INSERTION_THRESHOLD) {
+        if (n > 1) sort_radix::insertionSortByKey(arr.data(), arr.data() + n);
+        return true;
+    }
+    if (n > std::numeric_limits<uint32_t>::max()) return false;
+
+    const size_t blocks = blockCount(n, pool);
+    auto identity = [](const T& value) { return value; };
+    const auto bounds = keyBounds(arr, blocks, pool, identity);
+    const T low = bounds.first;
+    const size_t range = countingRange(low, bounds.second, n);
+    if (range == 0) return false;
+
+    std::vector<uint32_t> counts(blocks * range, 0);
+    forEachBlock(n, blocks, pool, [&](size_t block, size_t first, size_t last) {
+        uint32_t* histogram = counts.data() + block * range;
+        for (size_t i = first; i < last; ++i) {
+            ++histogram[bucketOf(arr[i], low)];
+        }
+    });
+
+    // Start of every bucket in arr, the block histograms summed on the way
+    std::vector<size_t> starts(range + 1);
+    size_t sum = 0;
+    for (size_t b = 0; b < range; ++b) {
+        starts[b] = sum;
+        for (size_t block = 0; block < blocks; ++block) sum += counts[block * range + b];
+    }
+    starts[range] = sum;
+
+    // Each block rewrites the buckets whose start falls in its share of the output
+    forEachBlock(n, blocks, pool, [&](size_t, size_t first, size_t last) {
+        const size_t from = std::lower_bound(starts.begin(), starts.end() - 1, first) - starts.begin();
+        const size_t to = std::lower_bound(starts.begin(), starts.end() - 1, last) - starts.begin();
+        for (size_t b = from; b < to; ++b) {
+            const T value = static_cast<T>(low + static_cast<T>(b));
+            std::fill(arr.begin() + starts[b], arr.begin() + starts[b + 1], value);
+        }
+    });
+    return true;
+}
+
+template <typename T, typename Proj>
+bool stableCountingSort(std::vector<T>& arr, Proj& proj, ThreadPool* pool) {
+    using K = std::remove_cvref_t<std::invoke_result_t<Proj&, const T&>>;
+    static_assert(countingSortable<K>, "Counting sort requires an integral key");
+    const size_t n = arr.size();
+    if (n < 2) return true;
+    if (n > std::numeric_limits<uint32_t>::max()) return false;
+
+    const size_t blocks = blockCount(n, pool);
+    auto keyOf = [&proj](const T& value) { return static_cast<K>(std::invoke(proj, value)); };
+    const auto bounds = keyBounds(arr, blocks, pool, keyOf);
+    const K low = bounds.first;
+    const size_t range = countingRange(low, bounds.second, n);
+    if (range == 0) return false;
+
+    // Pass 1: bucket of every element, so the projection runs once, and a histogram per block
+    static_assert(COUNTING_MAX_RANGE - 1 <= std::numeric_limits<uint16_t>::max());
+    std::vector<uint16_t> buckets(n);
+    std::vector<uint32_t> counts(blocks * range, 0);
+    forEachBlock(n, blocks, pool, [&](size_t block, size_t first, size_t last) {
+        uint32_t* histogram = counts.data() + block * range;
+        for (size_t i = first; i < last; ++i) {
+            const size_t b = bucketOf(keyOf(arr[i]), low);
+            buckets[i] = static_cast<uint16_t>(b);
+            ++histogram[b];
+        }
+    });
+
+    // Exclusive prefix sums in bucket-major order: block k writes bucket b from counts[k][b]
+    uint32_t sum = 0;
+    for (size_t b = 0; b < range; ++b) {
+        for (size_t block = 0; block < blocks; ++block) {
+            uint32_t& count = counts[block * range + b];
+            const uint32_t blockCount = count;
+            count = sum;
+            sum += blockCount;
+        }
+    }
+
+    // Pass 2: every block moves its elements to its own slots of each bucket, then back
+    std::vector<T> buffer(n);
+    forEachBlock(n, blocks, pool, [&](size_t block, size_t first, size_t last) {
+        uint32_t* offsets = counts.data() + block * range;
+        for (size_t i = first; i < last; ++i) {
+            buffer[offsets[buckets[i]]++] = std::move(arr[i]);
+        }
+    });
+    forEachBlock(n, blocks, pool, [&](size_t, size_t first, size_t last) {
+        std::move(buffer.begin() + first, buffer.begin() + last, arr.begin() + first);
+    });
+    return true;
+}
+
+} // namespace detail
+
+// Counting sort of arr on the calling thread; false (arr untouched) when the key range is too wide
+template <typename T>
+bool tryCountingSort(std::vector<T>& arr) {
+    return detail::countingSort(arr, nullptr);
+}
+
+// Counting sort of arr, large inputs counted on the given pool
+template <typename T>
+bool tryCountingSortOn(std::vector<T>& arr, ThreadPool& pool) {
+    return detail::countingSort(arr, &pool);
+}
+
+// Sorts arr on the given pool by counting sort, or by LSD radix sort when the range is too wide
+template <typename T>
+void countingSortOn(std::vector<T>& arr, ThreadPool& pool) {
+    if (!tryCountingSortOn(arr, pool)) {
+        sort_radix::radixSortAll(arr);
+    }
+}
+
+// Public interface
+template <typename T>
+void countingSortAll(std::vector<T>& arr) {
+    countingSortOn(arr, ThreadPool::shared());
+}
+
+// Stable counting sort of arr by the integral key proj(element), on the calling thread;
+// false (arr untouched) when the key range is too wide
+template <typename T, typename Proj>
+bool tryStableCountingSort(std::vector<T>& arr, Proj proj) {
+    return detail::stableCountingSort(arr, proj, nullptr);
+}
+
+template <typename T, typename Proj>
+bool tryStableCountingSortOn(std::vector<T>& arr, Proj proj, ThreadPool& pool) {
+    return detail::stableCountingSort(arr, proj, &pool);
+}
+
+// Stable sort of arr by proj(element) on the given pool: counting sort, or
+// sort_key::sortByKey when the range is too wide
+template <typename T, typename Proj>
+void stableCountingSortOn(std::vector<T>& arr, Proj proj, ThreadPool& pool) {
+    if (!detail::stableCountingSort(arr, proj, &pool)) {
+        sort_key::sortByKey(arr, {}, std::move(proj));
+    }
+}
+
+// Public interface
+template <typename T, typename Proj>
+void stableCountingSortAll(std::vector<T>& arr, Proj proj) {
+    stableCountingSortOn(arr, std::move(proj), ThreadPool::shared());
+}
+
+} // namespace sort_count
+
+} // namespace algolab
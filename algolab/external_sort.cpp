@@ -0,0 +1 @@
+#include "external_sort.h"
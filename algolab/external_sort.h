@@ -0,0 +1,358 @@
+#pragma once
+
+#include <vector>
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <future>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/resource.h>
+#endif
+#include "introsort.h"
+#include "loser_tree.h"
+
+namespace algolab {
+
+/**
+ * @brief External-memory sort of binary files of fixed-width records
+ * @details
+ * Sorts files larger than RAM, under algolab::sort_external, in two phases:
+ *  - run formation: the input is read in chunks of half the memory budget, each chunk
+ *    is sorted with introSortAll and spilled to a temporary run file; the write of
+ *    one run overlaps with reading and sorting the next,
+ *  - merge: up to fan-in runs at a time are merged by mergeSources (loser tree). Each
+ *    run reader and the output writer are double buffered: the next block is read (or the
+ *    previous one written) by an async task while the current block is consumed (or filled).
+ *    The budget is split evenly between these 2 * (fan-in + 1) blocks. With more runs
+ *    than the fan-in, groups of runs are merged into intermediate runs first, in as many
+ *    passes as needed.
+ * Records must be trivially copyable and ordered by operator< / operator> (as for
+ * introSortAll); the file is their raw in-memory representation.
+ * Temporary runs live in a fresh directory under ExternalSortConfig::tempDirectory,
+ * removed when the sort finishes or throws. Errors are reported as exceptions.
+ * The fan-in is bounded by the budget (every block holds at least EXTERNAL_MIN_BLOCK_BYTES),
+ * by the open file limit (one descriptor and one reader task per merged run) and by
+ * EXTERNAL_MAX_FAN_IN; ExternalSortConfig::maxFanIn lowers it further.
+ */
+
+namespace sort_external {
+
+// Merge blocks never go below this size, even with a very small budget
+constexpr size_t EXTERNAL_MIN_BLOCK_BYTES = 64 * 1024;
+// Upper bound of the runs merged at once, each one holds a file and a reader task
+constexpr size_t EXTERNAL_MAX_FAN_IN = 512;
+// File descriptors left to the rest of the process when the fan-in follows RLIMIT_NOFILE
+constexpr size_t EXTERNAL_RESERVED_FDS = 32;
+
+struct ExternalSortConfig {
+    size_t memoryBudgetBytes = size_t(256) << 20;
+    std::filesystem::path tempDirectory = std::filesystem::temp_directory_path();
+    size_t maxFanIn = 0; // 0: only the budget, the open file limit and EXTERNAL_MAX_FAN_IN apply
+};
+
+struct ExternalSortStats {
+    uint64_t records = 0;
+    uint64_t bytes = 0;
+    size_t runs = 0;
+    size_t mergePasses = 0;
+    double runFormationSeconds = 0.0;
+    double mergeSeconds = 0.0;
+
+    double totalSeconds() const { return runFormationSeconds + mergeSeconds; }
+
+    // Input size over total time, in MB/s (1 MB = 2^20 bytes)
+    double throughputMBps() const {
+        double seconds = totalSeconds();
+        return seconds > 0.0 ? static_cast<double>(bytes) / (1024.0 * 1024.0) / seconds : 0.0;
+    }
+};
+
+namespace detail {
+
+// Uniquely named directory, removed with its content on destruction
+class TempDirectory {
+public:
+    explicit TempDirectory(const std::filesystem::path& parent) {
+        std::random_device rd;
+        for (int attempt = 0; attempt < 16; ++attempt) {
+            path_ = parent / ("algolab_extsort_" + std::to_string(rd()));
+            if (std::filesystem::create_directory(path_)) return;
+        }
+        throw std::runtime_error("externalSort: cannot create a temporary directory in " + parent.string());
+    }
+
+    ~TempDirectory() {
+        std::error_code ec;
+        std::filesystem::remove_all(path_, ec);
+    }
+
+    TempDirectory(const TempDirectory&) = delete;
+    TempDirectory& operator=(const TempDirectory&) = delete;
+
+    const std::filesystem::path& path() const { return path_; }
+
+private:
+    std::filesystem::path path_;
+};
+
+inline std::ifstream openInput(const std::filesystem::path& path) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) throw std::runtime_error("externalSort: cannot open " + path.string());
+    return in;
+}
+
+inline std::ofstream openOutput(const std::filesystem::path& path) {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) throw std::runtime_error("externalSort: cannot create " + path.string());
+    return out;
+}
+
+// Reads up to count records, returns how many were read (0 at end of file)
+template <typename T>
+size_t readRecords(std::ifstream& in, T* dst, size_t count) {
+    in.read(reinterpret_cast<char*>(dst), static_cast<std::streamsize>(count * sizeof(T)));
+    auto bytes = static_cast<size_t>(in.gcount());
+    if (bytes % sizeof(T) != 0) {
+        throw std::runtime_error("externalSort: truncated record in input");
+    }
+    return bytes / sizeof(T);
+}
+
+template <typename T>
+void writeRecords(std::ofstream& out, const T* src, size_t count) {
+    out.write(reinterpret_cast<const char*>(src), static_cast<std::streamsize>(count * sizeof(T)));
+    if (!out) throw std::runtime_error("externalSort: write failed");
+}
+
+/**
+ * @brief Sequential reader of one run with a read-ahead block
+ * @details While the front block is consumed, the back block is filled by an async task.
+ */
+template <typename T>
+class RunReader {
+public:
+    using value_type = T;
+
+    RunReader(const std::filesystem::path& path, size_t blockRecords)
+        : in_(openInput(path)), front_(blockRecords), back_(blockRecords) {
+        frontSize_ = readRecords(in_, front_.data(), front_.size());
+        prefetch();
+    }
+
+    RunReader(const RunReader&) = delete;
+    RunReader& operator=(const RunReader&) = delete;
+
+    // Returns false once the run is exhausted
+    bool next(T& value) {
+        if (pos_ == frontSize_) {
+            if (!pending_.valid()) return false;
+            size_t n = pending_.get();
+            if (n == 0) return false;
+            std::swap(front_, back_);
+            frontSize_ = n;
+            pos_ = 0;
+            prefetch();
+        }
+        value = front_[pos_++];
+        return true;
+    }
+
+private:
+    void prefetch() {
+        pending_ = std::async(std::launch::async, [this] {
+            return readRecords(in_, back_.data(), back_.size());
+        });
+    }
+
+    std::ifstream in_;
+    std::vector<T> front_;
+    std::vector<T> back_;
+    size_t frontSize_ = 0;
+    size_t pos_ = 0;
+    std::future<size_t> pending_; // declared last: joined before the buffers are freed
+};
+
+/**
+ * @brief Sequential writer with a write-behind block
+ * @details A full block is handed to an async write while the next one is filled.
+ */
+template <typename T>
+class RunWriter {
+public:
+    RunWriter(const std::filesystem::path& path, size_t blockRecords)
+        : out_(openOutput(path)), capacity_(blockRecords) {
+        front_.reserve(capacity_);
+        back_.reserve(capacity_);
+    }
+
+    RunWriter(const RunWriter&) = delete;
+    RunWriter& operator=(const RunWriter&) = delete;
+
+    void push(const T& value) {
+        front_.push_back(value);
+        if (front_.size() == capacity_) flush();
+    }
+
+    // Writes the last block and reports any pending write error
+    void finish() {
+        if (!front_.empty()) flush();
+        wait();
+        out_.close();
+        if (!out_) throw std::runtime_error("externalSort: write failed");
+    }
+
+private:
+    void wait() {
+        if (pending_.valid()) pending_.get();
+    }
+
+    void flush() {
+        wait();
+        std::swap(front_, back_);
+        front_.clear();
+        pending_ = std::async(std::launch::async, [this] {
+            writeRecords(out_, back_.data(), back_.size());
+        });
+    }
+
+    std::ofstream out_;
+    size_t capacity_;
+    std::vector<T> front_;
+    std::vector<T> back_;
+    std::future<void> pending_;
+};
+
+// Runs merged at once: at least 2, so every pass makes progress
+inline size_t mergeFanIn(const ExternalSortConfig& config) {
+    // One block pair is the writer's
+    const size_t blockPairs = config.memoryBudgetBytes / (2 * EXTERNAL_MIN_BLOCK_BYTES);
+    size_t fanIn = std::min(EXTERNAL_MAX_FAN_IN, blockPairs > 0 ? blockPairs - 1 : 0);
+#if defined(__unix__) || defined(__APPLE__)
+    rlimit limit {};
+    if (getrlimit(RLIMIT_NOFILE, &limit) == 0 && limit.rlim_cur != RLIM_INFINITY) {
+        size_t files = static_cast<size_t>(limit.rlim_cur);
+        // The output is open too
+        fanIn = std::min(fanIn, files > EXTERNAL_RESERVED_FDS + 1 ? files - EXTERNAL_RESERVED_FDS - 1 : 0);
+    }
+#endif
+    if (config.maxFanIn > 0) fanIn = std::min(fanIn, config.maxFanIn);
+    return std::max<size_t>(fanIn, 2);
+}
+
+// Merges the sorted runs into output, the block size follows the number of runs
+template <typename T>
+void mergeRuns(const std::vector<std::filesystem::path>& runs, const std::filesystem::path& output,
+               const ExternalSortConfig& config) {
+    const size_t blockRecords = std::max<size_t>(
+        {1, EXTERNAL_MIN_BLOCK_BYTES / sizeof(T), config.memoryBudgetBytes / (2 * (runs.size() + 1) * sizeof(T))});
+
+    std::vector<std::unique_ptr<RunReader<T>>> readers;
+    readers.reserve(runs.size());
+    for (const auto& run : runs) {
+        readers.push_back(std::make_unique<RunReader<T>>(run, blockRecords));
+    }
+
+    RunWriter<T> writer(output, blockRecords);
+    mergeSources(readers, [&writer](const T& value) { writer.push(value); });
+    writer.finish();
+}
+
+} // namespace detail
+
+// Sorts the records of input into output, returns timings and throughput
+template <typename T>
+ExternalSortStats externalSort(const std::filesystem::path& input, const std::filesystem::path& output,
+                               const ExternalSortConfig& config = {}) {
+    static_assert(std::is_trivially_copyable_v<T>, "externalSort requires trivially copyable fixed-width records");
+    using Clock = std::chrono::steady_clock;
+
+    ExternalSortStats stats;
+    stats.bytes = std::filesystem::file_size(input);
+    if (stats.bytes % sizeof(T) != 0) {
+        throw std::invalid_argument("externalSort: input size is not a multiple of the record size");
+    }
+    stats.records = stats.bytes / sizeof(T);
+
+    // Run formation: one chunk is sorted while the previous one is written
+    auto start = Clock::now();
+    const size_t chunkRecords = std::max<size_t>(1, config.memoryBudgetBytes / (2 * sizeof(T)));
+    const bool singleRun = stats.records <= chunkRecords;
+
+    detail::TempDirectory tempDir(config.tempDirectory);
+    std::vector<std::filesystem::path> runs;
+    {
+        std::ifstream in = detail::openInput(input);
+        std::vector<T> chunk;
+        std::vector<T> writing;
+        std::future<void> pendingWrite;
+
+        while (true) {
+            chunk.resize(chunkRecords);
+            size_t n = detail::readRecords(in, chunk.data(), chunkRecords);
+            if (n == 0) break;
+            chunk.resize(n);
+            sort_custom::introSortAll(chunk);
+
+            if (pendingWrite.valid()) pendingWrite.get();
+            std::swap(chunk, writing);
+
+            // An input that fits in one chunk is written straight to its destination
+            auto runPath = singleRun ? output : tempDir.path() / ("run_" + std::to_string(runs.size()) + ".bin");
+            runs.push_back(runPath);
+            pendingWrite = std::async(std::launch::async, [&writing, runPath] {
+                std::ofstream out = detail::openOutput(runPath);
+                detail::writeRecords(out, writing.data(), writing.size());
+            });
+        }
+        if (pendingWrite.valid()) pendingWrite.get();
+    }
+    stats.runs = runs.size();
+    auto formed = Clock::now();
+    stats.runFormationSeconds = std::chrono::duration<double>(formed - start).count();
+
+    if (runs.empty()) {
+        detail::openOutput(output);
+    } else if (runs.size() > 1) {
+        // Intermediate passes merge consecutive groups of fanIn runs into longer runs,
+        // whose input files are removed as soon as they are merged
+        const size_t fanIn = detail::mergeFanIn(config);
+        size_t nextRun = runs.size();
+        while (runs.size() > fanIn) {
+            std::vector<std::filesystem::path> merged;
+            for (size_t first = 0; first < runs.size(); first += fanIn) {
+                std::vector<std::filesystem::path> group(runs.begin() + first,
+                                                         runs.begin() + std::min(first + fanIn, runs.size()));
+                if (group.size() == 1) {
+                    merged.push_back(group.front());
+                    continue;
+                }
+                auto runPath = tempDir.path() / ("run_" + std::to_string(nextRun++) + ".bin");
+                detail::mergeRuns<T>(group, runPath, config);
+                for (const auto& run : group) {
+                    std::filesystem::remove(run);
+                }
+                merged.push_back(runPath);
+            }
+            runs = std::move(merged);
+            ++stats.mergePasses;
+        }
+        detail::mergeRuns<T>(runs, output, config);
+        ++stats.mergePasses;
+    }
+    stats.mergeSeconds = std::chrono::duration<double>(Clock::now() - formed).count();
+
+    return stats;
+}
+
+} // namespace sort_external
+
+} // namespace algolab
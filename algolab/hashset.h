@@ -7,6 +7,8 @@
 #include <string>
 #include <cstdint>
 #include <array>
+#include <iterator>
+#include <mutex>
 #include <shared_mutex>
 #include <type_traits>
 #include "utils.h" // Assuming this is where DEBUG_LOG is defined
@@ -53,6 +55,12 @@ struct Node_t {
     }
 };
 
+// Tag of the HashSet constructor that bulk loads keys known to be distinct
+struct UniqueKeys_t {
+    explicit UniqueKeys_t() = default;
+};
+inline constexpr UniqueKeys_t uniqueKeys{};
+
 /**
  * @brief HashSet_t class
  * @details HashSet class with insert, search, remove and display functions
@@ -60,6 +68,10 @@ struct Node_t {
  * static_assert guards against misuse of the ThomasWangHash with non-integral types.
  * size() and capacity() now lock safely using shared access.
  * Write operations (insert, remove, resize, clear) use unique_lock.
+ * Bulk loading (HashSet(uniqueKeys, first, last), insertUnique) takes keys that are
+ * already distinct, e.g. the output of sort_custom::sortUnique: one exclusive lock
+ * for the whole batch, the bucket array grown once to its final prime size, and the
+ * nodes linked at their bucket heads without a duplicate scan or a per-key lock.
  * 
  */
 template <typename T, typename Hash = ThomasWangHash, typename KeyEqual = std::equal_to<T> >
@@ -98,6 +110,13 @@ public:
         buckets_.resize(bucketCount_);
     }
 
+    // Bulk constructor: [first, last) must not contain two equal keys
+    template <typename InputIt>
+    HashSet(UniqueKeys_t, InputIt first, InputIt last, float p_loadFactor = DEFAULT_LOAD_FACTOR)
+        : HashSet(p_loadFactor) {
+        insertUnique(first, last);
+    }
+
     virtual ~HashSet() = default;
 
     // Insert Key
@@ -126,6 +145,37 @@ public:
         return true;
     }
 
+    // Bulk insert of distinct keys, returns the number of keys inserted
+    // The keys are only checked against the elements already in the set, which an empty
+    // set skips altogether. Equal keys inside [first, last) would be stored twice.
+    template <typename InputIt>
+    std::size_t insertUnique(InputIt first, InputIt last) {
+        std::unique_lock lock(mutex_);
+
+        const bool wasEmpty = elementCount_ == 0;
+        if constexpr (std::is_base_of_v<std::forward_iterator_tag,
+                                        typename std::iterator_traits<InputIt>::iterator_category>) {
+            reserveFor(elementCount_ + static_cast<uint64_t>(std::distance(first, last)));
+        }
+
+        std::size_t inserted = 0;
+        for (; first != last; ++first) {
+            if (elementCount_ > bucketCount_ * loadFactor_) {
+                resize(); // Only for single-pass input, whose size is unknown up front
+            }
+            const uint64_t hashValue = getHash(*first);
+            if (!wasEmpty && contains(buckets_[hashValue].get(), *first)) {
+                continue;
+            }
+            auto newNode = std::make_unique<Node_t<T>>(*first);
+            newNode->next = std::move(buckets_[hashValue]);
+            buckets_[hashValue] = std::move(newNode);
+            ++elementCount_;
+            ++inserted;
+        }
+        return inserted;
+    }
+
     // Search Key
     bool search(const T& key) const {
         std::shared_lock lock(mutex_);
@@ -232,23 +282,44 @@ private:
         return hasher(key) % bucketCount_;
     }
 
+    bool contains(Node_t<T>* node, const T& key) const {
+        for (; node; node = node->next.get()) {
+            if (keyEqual(node->key, key)) return true;
+        }
+        return false;
+    }
+
     // Resize function to move to the next prime size
     void resize() {
         if (currentPrimeIndex_ + 1 >= PRIME_SIZES.size()) return; // No more primes available
+        rehash(currentPrimeIndex_ + 1);
+    }
 
+    // Grows once to the smallest prime that holds count elements under the load factor
+    void reserveFor(uint64_t count) {
+        int index = currentPrimeIndex_;
+        while (index + 1 < static_cast<int>(PRIME_SIZES.size()) && count > PRIME_SIZES[index] * loadFactor_) {
+            ++index;
+        }
+        if (index != currentPrimeIndex_) rehash(index);
+    }
+
+    // Moves to PRIME_SIZES[primeIndex] buckets, relinking the existing nodes
+    void rehash(int primeIndex) {
         auto oldBucketCount = bucketCount_;
-        bucketCount_ = PRIME_SIZES[++currentPrimeIndex_];
+        currentPrimeIndex_ = primeIndex;
+        bucketCount_ = PRIME_SIZES[currentPrimeIndex_];
 
         std::vector<std::unique_ptr<Node_t<T>>> newBuckets(bucketCount_);
 
         for (size_t i = 0; i < oldBucketCount; ++i) {
-            Node_t<T>* current = buckets_[i].get();
+            std::unique_ptr<Node_t<T>> current = std::move(buckets_[i]);
             while (current) {
+                std::unique_ptr<Node_t<T>> next = std::move(current->next);
                 uint64_t newHashValue = hasher(current->key) % bucketCount_;
-                auto newNode = std::make_unique<Node_t<T>>(current->key);
-                newNode->next = std::move(newBuckets[newHashValue]);
-                newBuckets[newHashValue] = std::move(newNode);
-                current = current->next.get();
+                current->next = std::move(newBuckets[newHashValue]);
+                newBuckets[newHashValue] = std::move(current);
+                current = std::move(next);
             }
         }
         buckets_ = std::move(newBuckets);
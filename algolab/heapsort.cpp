@@ -0,0 +1 @@
+#include "heapsort.h"
@@ -0,0 +1,148 @@
+#pragma once
+
+#include <vector>
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <utility>
+
+namespace algolab {
+
+/**
+ * @brief Heapsort engine: iterative, bottom-up and d-ary heaps
+ * @details
+ * Generic heapsort on random access iterators under algolab::sort_heap:
+ *  - every sift is a loop that moves a hole instead of swapping, nothing recurses,
+ *  - HeapSift::BottomUp (Floyd): when the root is removed, the hole first walks
+ *    down to a leaf along the larger children without comparing against the
+ *    displaced element, which then climbs back up from the leaf. As that element
+ *    came from the bottom of the heap it rarely climbs far, so sorting takes about
+ *    n log2 n comparisons instead of 2 n log2 n for the top-down sift,
+ *  - Arity (2, 4 or 8): children of node i are the Arity consecutive elements from
+ *    Arity * i + 1, so for small keys a node's children share one or two cache lines
+ *    and the heap is log2(Arity) times shallower.
+ * sort_custom::heapSort (the introsort and pdqsort depth-limit fallback) and
+ * ranges::heapSort run on this engine.
+ * Reference: R. W. Floyd, "Algorithm 245: Treesort 3" (CACM 1964);
+ * I. Wegener, "Bottom-Up-Heapsort" (TCS 1993).
+ */
+
+namespace sort_heap {
+
+enum class HeapSift {
+    TopDown,  // Compare the sifted element with the larger child on every level
+    BottomUp, // Floyd: walk the hole to a leaf first, then sift the element up
+};
+
+// 4-ary bottom-up was the fastest on 1M int and double; strings favour no arity clearly
+constexpr int HEAP_DEFAULT_ARITY = 4;
+constexpr HeapSift HEAP_DEFAULT_SIFT = HeapSift::BottomUp;
+
+namespace detail {
+
+// Index of the largest of the children first[child, child + count)
+template <int Arity, typename I, typename Less>
+std::iter_difference_t<I> largestChild(I first, std::iter_difference_t<I> child, std::iter_difference_t<I> count,
+                                       Less& less) {
+    using D = std::iter_difference_t<I>;
+    D best = child;
+    if (count == Arity) {
+        // Full family, the common case: fixed trip count, unrolled by the compiler
+        for (int c = 1; c < Arity; ++c) {
+            best += static_cast<D>(less(first[best], first[child + c])) * (child + c - best);
+        }
+    } else {
+        for (auto c = child + 1; c < child + count; ++c) {
+            best = less(first[best], first[c]) ? c : best;
+        }
+    }
+    return best;
+}
+
+// Restores the heap property below root by moving first[root] down (heap of n elements)
+template <int Arity, typename I, typename Less>
+void siftDown(I first, std::iter_difference_t<I> root, std::iter_difference_t<I> n, Less& less) {
+    using D = std::iter_difference_t<I>;
+    auto value = std::ranges::iter_move(first + root);
+    while (true) {
+        D child = Arity * root + 1;
+        if (child >= n) break;
+        D best = largestChild<Arity>(first, child, std::min<D>(Arity, n - child), less);
+        if (!less(value, first[best])) break;
+        first[root] = std::ranges::iter_move(first + best);
+        root = best;
+    }
+    first[root] = std::move(value);
+}
+
+// Floyd's sift: the hole at root descends to a leaf along the largest children,
+// then value (the element to place) climbs up from there, no higher than root
+template <int Arity, typename I, typename Less, typename T>
+void siftBottomUp(I first, std::iter_difference_t<I> root, std::iter_difference_t<I> n, T&& value, Less& less) {
+    using D = std::iter_difference_t<I>;
+    D hole = root;
+    while (true) {
+        D child = Arity * hole + 1;
+        if (child >= n) break;
+        D best = largestChild<Arity>(first, child, std::min<D>(Arity, n - child), less);
+        first[hole] = std::ranges::iter_move(first + best);
+        hole = best;
+    }
+    while (hole > root) {
+        D parent = (hole - 1) / Arity;
+        if (!less(first[parent], value)) break;
+        first[hole] = std::ranges::iter_move(first + parent);
+        hole = parent;
+    }
+    first[hole] = std::forward<T>(value);
+}
+
+} // namespace detail
+
+// Rearranges [first, last) into a max-heap of the given arity
+template <int Arity = HEAP_DEFAULT_ARITY, std::random_access_iterator I, typename Compare = std::less<>>
+void makeHeap(I first, I last, Compare comp = Compare()) {
+    static_assert(Arity >= 2, "A heap needs at least two children per node");
+    using D = std::iter_difference_t<I>;
+    const D n = last - first;
+    if (n < 2) return;
+    // Build phase: most nodes sit just above the leaves, so the top-down sift is cheaper here
+    for (D i = (n - 2) / Arity + 1; i-- > 0;) {
+        detail::siftDown<Arity>(first, i, n, comp);
+    }
+}
+
+// Sorts a max-heap [first, last) of the given arity into ascending order
+template <int Arity = HEAP_DEFAULT_ARITY, HeapSift Sift = HEAP_DEFAULT_SIFT, std::random_access_iterator I,
+          typename Compare = std::less<>>
+void sortHeap(I first, I last, Compare comp = Compare()) {
+    using D = std::iter_difference_t<I>;
+    for (D end = last - first - 1; end > 0; --end) {
+        if constexpr (Sift == HeapSift::BottomUp) {
+            // The root moves to the end, the displaced last element is placed from the leaf upwards
+            auto value = std::ranges::iter_move(first + end);
+            first[end] = std::ranges::iter_move(first);
+            detail::siftBottomUp<Arity>(first, D(0), end, std::move(value), comp);
+        } else {
+            std::ranges::iter_swap(first, first + end);
+            detail::siftDown<Arity>(first, D(0), end, comp);
+        }
+    }
+}
+
+// Heapsort of [first, last): O(n log n) worst case, in place, not stable
+template <int Arity = HEAP_DEFAULT_ARITY, HeapSift Sift = HEAP_DEFAULT_SIFT, std::random_access_iterator I,
+          typename Compare = std::less<>>
+void heapSort(I first, I last, Compare comp = Compare()) {
+    makeHeap<Arity>(first, last, comp);
+    sortHeap<Arity, Sift>(first, last, comp);
+}
+
+template <typename T, int Arity = HEAP_DEFAULT_ARITY, HeapSift Sift = HEAP_DEFAULT_SIFT>
+void heapSortAll(std::vector<T>& arr) {
+    heapSort<Arity, Sift>(arr.begin(), arr.end());
+}
+
+} // namespace sort_heap
+
+} // namespace algolab
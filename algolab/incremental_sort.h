@@ -0,0 +1,234 @@
+#pragma once
+
+#include <vector>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <functional>
+#include <utility>
+#include "introsort.h"
+#include "heapsort.h"
+
+namespace algolab {
+
+/**
+ * @brief Time-sliced incremental introsort
+ * @details
+ * An event loop cannot stall for a full introSortAll, but it can spend a slice of
+ * every tick on it. IncrementalSort is an introsort that stops and resumes: it keeps
+ * its pending ranges on an explicit stack and the state of the range in progress
+ * between calls, so
+ *  - step(maxWork) advances the sort by about maxWork units of work and returns,
+ *  - stepFor(budget) advances it until the budget has elapsed, reading the clock
+ *    every INCREMENTAL_CLOCK_INTERVAL units,
+ *  - finishNow() sorts whatever is left in one go (plain recursive introsort).
+ * A unit of work is one element scanned by a partition or placed by a small-range
+ * sort, or one heap level walked. Every piece of work is resumable: the Hoare
+ * partition is a state machine that can stop between any two elements, and ranges
+ * that reach the depth limit are heapsorted one sift at a time. A single step
+ * therefore overshoots its budget by at most one small-range sort
+ * (INTROSORT_INSERTION_THRESHOLD elements) or one sift (about log2 n levels).
+ * The vector is borrowed: it must outlive the sort and must not be modified between
+ * steps. Until done() it holds a permutation of its input.
+ */
+
+namespace sort_incremental {
+
+// Units of work between two clock reads in stepFor
+constexpr size_t INCREMENTAL_CLOCK_INTERVAL = 256;
+
+template <typename T>
+class IncrementalSort {
+public:
+    explicit IncrementalSort(std::vector<T>& arr)
+        : IncrementalSort(arr, arr.size() < 2 ? 0 : 2 * static_cast<int>(std::log2(arr.size()))) {}
+
+    // Ranges deeper than depthLimit partitions are heapsorted
+    IncrementalSort(std::vector<T>& arr, int depthLimit) : arr_(arr) {
+        if (arr_.size() > 1) {
+            stack_.push_back({0, static_cast<int>(arr_.size()) - 1, depthLimit});
+        }
+    }
+
+    IncrementalSort(const IncrementalSort&) = delete;
+    IncrementalSort& operator=(const IncrementalSort&) = delete;
+
+    // Advances the sort by about maxWork units, returns done()
+    bool step(size_t maxWork) {
+        size_t budget = std::max<size_t>(maxWork, 1);
+        while (budget > 0 && !done()) {
+            size_t used = advance(budget);
+            work_ += used;
+            budget -= std::min(used, budget);
+        }
+        return done();
+    }
+
+    // Advances the sort until budget has elapsed, returns done()
+    template <typename Rep, typename Period>
+    bool stepFor(std::chrono::duration<Rep, Period> budget) {
+        const auto deadline = std::chrono::steady_clock::now() + budget;
+        while (!step(INCREMENTAL_CLOCK_INTERVAL) && std::chrono::steady_clock::now() < deadline) {}
+        return done();
+    }
+
+    // Sorts everything left
+    void finishNow() {
+        // The range in progress is completed by its own state machine, the rest by introsort
+        while (phase_ != Phase::Idle) {
+            work_ += advance(static_cast<size_t>(-1));
+        }
+        while (!stack_.empty()) {
+            Range range = stack_.back();
+            stack_.pop_back();
+            sort_custom::introsort(arr_, range.low, range.high, range.depthLimit);
+            work_ += static_cast<size_t>(range.high - range.low + 1);
+        }
+    }
+
+    bool done() const {
+        return phase_ == Phase::Idle && stack_.empty();
+    }
+
+    // Units of work done so far
+    size_t workDone() const {
+        return work_;
+    }
+
+    // Ranges waiting on the stack, not counting the one in progress
+    size_t pendingRanges() const {
+        return stack_.size();
+    }
+
+private:
+    enum class Phase {
+        Idle,      // Next range comes from the stack
+        Partition, // Hoare partition of active_ in progress
+        HeapBuild, // Depth limit reached: building the heap of active_
+        HeapSort,  // Popping the heap of active_
+    };
+
+    struct Range {
+        int low;
+        int high;
+        int depthLimit;
+    };
+
+    static constexpr int ARITY = sort_heap::HEAP_DEFAULT_ARITY;
+
+    // Does at most about budget units of the current piece of work, returns the units used
+    size_t advance(size_t budget) {
+        switch (phase_) {
+        case Phase::Idle:
+            return startRange();
+        case Phase::Partition:
+            return partitionSome(budget);
+        case Phase::HeapBuild:
+        case Phase::HeapSort:
+            return heapSortSome(budget);
+        }
+        return 1;
+    }
+
+    size_t startRange() {
+        active_ = stack_.back();
+        stack_.pop_back();
+        const int low = active_.low;
+        const int high = active_.high;
+        const size_t n = static_cast<size_t>(high - low + 1);
+
+        if (high - low <= sort_custom::INTROSORT_INSERTION_THRESHOLD) {
+            sort_custom::introsort(arr_, low, high, 0);
+            return n;
+        }
+        if (active_.depthLimit == 0) {
+            heapLevels_ = static_cast<size_t>(std::log2(n)) + 1;
+            heapNext_ = static_cast<int>((n - 2) / ARITY + 1);
+            phase_ = Phase::HeapBuild;
+            return 1;
+        }
+        // Same scheme as sort_custom::partition: the median is parked at high - 1 and
+        // stays there until the scans meet, the outer elements act as sentinels
+        pivot_ = sort_custom::medianOfThree(arr_, low, high);
+        left_ = low;
+        right_ = high - 1;
+        scanRight_ = false;
+        phase_ = Phase::Partition;
+        return 3;
+    }
+
+    // Resumable Hoare partition: each scanned element costs one unit
+    size_t partitionSome(size_t budget) {
+        const T& pivot = arr_[pivot_];
+        size_t used = 0;
+        while (used < budget) {
+            ++used;
+            if (!scanRight_) {
+                if (arr_[++left_] < pivot) continue;
+                scanRight_ = true;
+            }
+            if (pivot < arr_[--right_]) continue;
+            if (left_ < right_) {
+                std::swap(arr_[left_], arr_[right_]);
+                scanRight_ = false;
+                continue;
+            }
+
+            std::swap(arr_[left_], arr_[active_.high - 1]);
+            Range larger {active_.low, left_ - 1, active_.depthLimit - 1};
+            Range smaller {left_ + 1, active_.high, active_.depthLimit - 1};
+            // The smaller side goes on top, which bounds the stack to O(log n) ranges
+            if (larger.high - larger.low < smaller.high - smaller.low) std::swap(larger, smaller);
+            if (larger.low < larger.high) stack_.push_back(larger);
+            if (smaller.low < smaller.high) stack_.push_back(smaller);
+            phase_ = Phase::Idle;
+            break;
+        }
+        return used;
+    }
+
+    // Heapsort of active_ one sift at a time, each sift costs heapLevels_ units
+    size_t heapSortSome(size_t budget) {
+        auto first = arr_.begin() + active_.low;
+        const int n = active_.high - active_.low + 1;
+        std::less<> less;
+        size_t used = 0;
+        while (used < budget && phase_ != Phase::Idle) {
+            used += heapLevels_;
+            if (phase_ == Phase::HeapBuild) {
+                sort_heap::detail::siftDown<ARITY>(first, static_cast<std::ptrdiff_t>(--heapNext_), std::ptrdiff_t(n), less);
+                if (heapNext_ == 0) {
+                    heapNext_ = n - 1;
+                    phase_ = Phase::HeapSort;
+                }
+            } else {
+                // The root moves to the end, the displaced last element is placed from the leaf upwards
+                const int end = heapNext_--;
+                T value = std::move(first[end]);
+                first[end] = std::move(first[0]);
+                sort_heap::detail::siftBottomUp<ARITY>(first, std::ptrdiff_t(0), std::ptrdiff_t(end), std::move(value), less);
+                if (heapNext_ == 0) phase_ = Phase::Idle;
+            }
+        }
+        return used;
+    }
+
+    std::vector<T>& arr_;
+    std::vector<Range> stack_;
+    Phase phase_ = Phase::Idle;
+    Range active_ {0, -1, 0};
+    // Partition in progress: pivot position, scan positions, and which scan runs
+    int pivot_ = 0;
+    int left_ = 0;
+    int right_ = 0;
+    bool scanRight_ = false;
+    // Heapsort in progress: next node to sift (build) or last heap slot (sort)
+    int heapNext_ = 0;
+    size_t heapLevels_ = 1;
+    size_t work_ = 0;
+};
+
+} // namespace sort_incremental
+
+} // namespace algolab
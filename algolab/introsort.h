@@ -3,6 +3,9 @@
 #include <vector>
 #include <algorithm>
 #include <cmath>
+#include "simd_network.h"
+#include "block_partition.h"
+#include "heapsort.h"
 
 namespace algolab {
 
@@ -19,10 +22,17 @@ namespace algolab {
  * QuickSort (with partition)
  * HeapSort (when recursion depth is too high)
  * InsertionSort (for small partitions)
+ * For int, float and double on SSE4.1/AVX2 targets, partitions of up to 16 elements
+ * are sorted by a vectorized sorting network instead (see simd_network.h).
+ * The Scheme template parameter selects Hoare partitioning (Classic) or the
+ * branchless BlockQuicksort partitioner (Block, see block_partition.h).
  */ 
 
 namespace sort_custom {
 
+// Partitions of up to this many elements are finished by insertion sort (or a network)
+constexpr int INTROSORT_INSERTION_THRESHOLD = 16;
+
 // Insertion Sort for small ranges
 template <typename T>
 void insertionSort(std::vector<T>& arr, int low, int high) {
@@ -85,19 +95,23 @@ int partition(std::vector<T>& arr, int low, int high) {
     return i;
 }
 
-// HeapSort for worst-case scenarios
+// HeapSort for worst-case scenarios (4-ary bottom-up heapsort, see heapsort.h)
 template <typename T>
 void heapSort(std::vector<T>& arr, int low, int high) {
-    std::make_heap(arr.begin() + low, arr.begin() + high + 1);
-    std::sort_heap(arr.begin() + low, arr.begin() + high + 1);
+    sort_heap::heapSort(arr.begin() + low, arr.begin() + high + 1);
 }
 
 // Introsort core logic
-template <typename T>
-void introsort(std::vector<T>& arr, int low, int high, int depthLimit) {
-    const int sizeThreshold = 16;
-
-    if (high - low <= sizeThreshold) {
+// leftmost is false when arr[low - 1] is a previous pivot (only used by the Block scheme)
+template <typename T, PartitionScheme Scheme = PartitionScheme::Classic>
+void introsort(std::vector<T>& arr, int low, int high, int depthLimit, bool leftmost = true) {
+    if (high - low <= INTROSORT_INSERTION_THRESHOLD) {
+        if constexpr (sort_simd::hasNetwork<T>) {
+            if (high - low < sort_simd::NETWORK_SIZE) {
+                sort_simd::sortSmall(arr.data() + low, high - low + 1);
+                return;
+            }
+        }
         insertionSort(arr, low, high);
         return;
     }
@@ -107,17 +121,25 @@ void introsort(std::vector<T>& arr, int low, int high, int depthLimit) {
         return;
     }
 
-    int pivotIndex = partition(arr, low, high);
-    introsort(arr, low, pivotIndex - 1, depthLimit - 1);
-    introsort(arr, pivotIndex + 1, high, depthLimit - 1);
+    int pivotIndex;
+    bool equalLeft = false;
+    if constexpr (Scheme == PartitionScheme::Block) {
+        pivotIndex = blockPartition(arr, low, high, leftmost, equalLeft);
+    } else {
+        pivotIndex = partition(arr, low, high);
+    }
+    if (!equalLeft) {
+        introsort<T, Scheme>(arr, low, pivotIndex - 1, depthLimit - 1, leftmost);
+    }
+    introsort<T, Scheme>(arr, pivotIndex + 1, high, depthLimit - 1, false);
 }
 
 // Public interface
-template <typename T>
+template <typename T, PartitionScheme Scheme = PartitionScheme::Classic>
 void introSortAll(std::vector<T>& arr) {
     int n = static_cast<int>(arr.size());
     int depthLimit = 2 * static_cast<int>(std::log2(n));
-    introsort(arr, 0, n - 1, depthLimit);
+    introsort<T, Scheme>(arr, 0, n - 1, depthLimit);
 }
 
 } // namespace sort_custom
@@ -0,0 +1 @@
+#include "loser_tree.h"
@@ -0,0 +1,198 @@
+#pragma once
+
+#include <vector>
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <ranges>
+#include <utility>
+
+namespace algolab {
+
+/**
+ * @brief Loser tree (tournament tree) for k-way merging
+ * @details
+ * Holds the current head of k sorted sources. Internal node n stores the source that
+ * lost the match played at n, node 0 the overall winner, so replacing the winner's key
+ * only replays the matches on its leaf-to-root path: ceil(log2 k) comparisons per
+ * output element, against about 2 log2 k for a binary heap.
+ * Leaf i sits at node k + i of the implicit tree, which works for any k.
+ * Ties go to the lower source index, so merging runs given in input order is stable.
+ * Exhausted sources lose every match.
+ *
+ * On top of the tree, kWayMerge / mergeSources merge any number of sorted inputs
+ * without materialising them:
+ *  - ranges of sorted ranges (vectors, std::span, std::ranges::subrange over iterator
+ *    pairs) are merged into an output iterator,
+ *  - pull-based streams (any type with value_type and bool next(value_type&), such as
+ *    the external sort run readers) are merged into a sink callable, which receives
+ *    each element as soon as it wins.
+ */
+template <typename T, typename Compare = std::less<T>>
+class LoserTree {
+public:
+    explicit LoserTree(size_t k, Compare comp = Compare())
+        : keys_(k), exhausted_(k, true), tree_(k > 0 ? k : 1, 0), comp_(std::move(comp)) {}
+
+    size_t size() const { return keys_.size(); }
+
+    // Sets the first key of a source, before build()
+    void setKey(size_t source, T key) {
+        keys_[source] = std::move(key);
+        exhausted_[source] = false;
+    }
+
+    // Plays the initial tournament, O(k)
+    void build() {
+        const size_t k = keys_.size();
+        if (k == 0) return;
+
+        std::vector<size_t> winners(2 * k);
+        for (size_t i = 0; i < k; ++i) {
+            winners[k + i] = i;
+        }
+        for (size_t node = k - 1; node >= 1; --node) {
+            size_t left = winners[2 * node];
+            size_t right = winners[2 * node + 1];
+            if (beats(right, left)) std::swap(left, right);
+            winners[node] = left;
+            tree_[node] = right;
+        }
+        tree_[0] = k == 1 ? 0 : winners[1];
+    }
+
+    // True when every source is exhausted
+    bool empty() const { return keys_.empty() || exhausted_[tree_[0]]; }
+
+    // Source holding the smallest key
+    size_t winner() const { return tree_[0]; }
+
+    const T& top() const { return keys_[tree_[0]]; }
+
+    // The winner's source produced its next key
+    void replaceTop(T key) {
+        keys_[tree_[0]] = std::move(key);
+        replay(tree_[0]);
+    }
+
+    // The winner's source has no more keys
+    void removeTop() {
+        exhausted_[tree_[0]] = true;
+        replay(tree_[0]);
+    }
+
+private:
+    bool beats(size_t a, size_t b) const {
+        if (exhausted_[a]) return false;
+        if (exhausted_[b]) return true;
+        // One comparison per match: on equal keys the lower source index wins
+        return a < b ? !comp_(keys_[b], keys_[a]) : comp_(keys_[a], keys_[b]);
+    }
+
+    // Replays the matches from the leaf of source up to the root
+    void replay(size_t source) {
+        size_t winner = source;
+        for (size_t node = (source + keys_.size()) / 2; node >= 1; node /= 2) {
+            // Selects instead of a swap branch: the outcome of each match is unpredictable
+            size_t challenger = tree_[node];
+            bool challengerWins = beats(challenger, winner);
+            tree_[node] = challengerWins ? winner : challenger;
+            winner = challengerWins ? challenger : winner;
+        }
+        tree_[0] = winner;
+    }
+
+    std::vector<T> keys_;
+    std::vector<unsigned char> exhausted_; // not vector<bool>: read on every match
+    std::vector<size_t> tree_;
+    Compare comp_;
+};
+
+// Pull-based sorted stream: next(value) stores the next element and returns true,
+// or returns false once the stream is exhausted
+template <typename S>
+concept MergeSource = requires(S& source, typename S::value_type& value) {
+    { source.next(value) } -> std::convertible_to<bool>;
+};
+
+// MergeSource over an iterator / sentinel pair
+template <std::input_iterator I, std::sentinel_for<I> S = I>
+class RangeSource {
+public:
+    using value_type = std::iter_value_t<I>;
+
+    RangeSource(I first, S last) : first_(std::move(first)), last_(std::move(last)) {}
+
+    bool next(value_type& value) {
+        if (first_ == last_) return false;
+        value = *first_;
+        ++first_;
+        return true;
+    }
+
+private:
+    I first_;
+    S last_;
+};
+
+namespace detail {
+
+// Sources may be stored by value or behind a pointer (non-movable streams)
+template <typename S>
+decltype(auto) sourceRef(S& source) {
+    if constexpr (MergeSource<S>) {
+        return (source);
+    } else {
+        return (*source);
+    }
+}
+
+} // namespace detail
+
+// Merges the sorted streams in sources, passing every element in order to sink
+// Returns the number of merged elements. Equal elements keep the order of sources.
+template <std::ranges::random_access_range Sources, typename Sink, typename Compare = std::less<>>
+size_t mergeSources(Sources& sources, Sink&& sink, Compare comp = Compare()) {
+    using Source = std::remove_reference_t<decltype(detail::sourceRef(*std::ranges::begin(sources)))>;
+    static_assert(MergeSource<Source>, "mergeSources expects streams with value_type and bool next(value_type&)");
+    using T = typename Source::value_type;
+
+    const size_t k = static_cast<size_t>(std::ranges::size(sources));
+    LoserTree<T, Compare> tree(k, std::move(comp));
+    auto first = std::ranges::begin(sources);
+    T value;
+    for (size_t i = 0; i < k; ++i) {
+        if (detail::sourceRef(first[i]).next(value)) tree.setKey(i, std::move(value));
+    }
+    tree.build();
+
+    size_t count = 0;
+    while (!tree.empty()) {
+        sink(tree.top());
+        ++count;
+        if (detail::sourceRef(first[tree.winner()]).next(value)) {
+            tree.replaceTop(std::move(value));
+        } else {
+            tree.removeTop();
+        }
+    }
+    return count;
+}
+
+// Merges a range of sorted ranges (vectors, spans, subranges...) into out
+template <std::ranges::input_range Inputs, typename OutputIt, typename Compare = std::less<>>
+    requires std::ranges::input_range<std::ranges::range_reference_t<Inputs>>
+OutputIt kWayMerge(Inputs&& inputs, OutputIt out, Compare comp = Compare()) {
+    using Inner = std::ranges::range_reference_t<Inputs>;
+    using Source = RangeSource<std::ranges::iterator_t<Inner>, std::ranges::sentinel_t<Inner>>;
+
+    std::vector<Source> sources;
+    for (auto&& input : inputs) {
+        sources.emplace_back(std::ranges::begin(input), std::ranges::end(input));
+    }
+    mergeSources(sources, [&out](const auto& value) { *out++ = value; }, std::move(comp));
+    return out;
+}
+
+} // namespace algolab
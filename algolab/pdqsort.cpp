@@ -0,0 +1 @@
+#include "pdqsort.h"
@@ -0,0 +1,232 @@
+#pragma once
+
+#include <vector>
+#include <algorithm>
+#include <cmath>
+#include <type_traits>
+#include "introsort.h"
+#include "block_partition.h"
+
+namespace algolab {
+
+/**
+ * @brief Pattern-defeating quicksort (pdqsort) mode for introsort
+ * @details
+ * Same skeleton as sort_custom::introsort, plus the pdqsort techniques that make
+ * common input patterns cheap:
+ *  - run detection: an input that is one ascending or descending run is finished
+ *    (reversed if needed) in a single pass,
+ *  - partial insertion sort: when a partition did not move anything, both sides
+ *    get an insertion sort that bails out after PDQ_PARTIAL_INSERTION_LIMIT moves,
+ *    so nearly sorted ranges finish in linear time,
+ *  - fat pivot: when the pivot equals the previous pivot (the element just left of
+ *    the range), a three-way partition puts all keys equal to it in place at once,
+ *    which makes few-unique inputs O(n log k),
+ *  - pivot shuffling: after a highly unbalanced partition a few elements are swapped
+ *    to break the pattern; after log2(n) of them the range falls back to HeapSort.
+ * Arithmetic types are partitioned with the branchless block partitioner.
+ * Reference: Orson Peters, "Pattern-defeating Quicksort" (2021).
+ */
+
+namespace sort_custom {
+
+constexpr int PDQ_INSERTION_THRESHOLD = 24;
+constexpr int PDQ_NINTHER_THRESHOLD = 128;
+constexpr int PDQ_PARTIAL_INSERTION_LIMIT = 8;
+
+template <typename T>
+void sort2(std::vector<T>& arr, int a, int b) {
+    if (arr[b] < arr[a]) std::swap(arr[a], arr[b]);
+}
+
+// Orders arr[a] <= arr[b] <= arr[c]
+template <typename T>
+void sort3(std::vector<T>& arr, int a, int b, int c) {
+    sort2(arr, a, b);
+    sort2(arr, b, c);
+    sort2(arr, a, b);
+}
+
+// Insertion sort of arr[low..high] that gives up after PDQ_PARTIAL_INSERTION_LIMIT moves
+// Returns true if the range is sorted.
+template <typename T>
+bool partialInsertionSort(std::vector<T>& arr, int low, int high) {
+    int moves = 0;
+    for (int i = low + 1; i <= high; ++i) {
+        if (!(arr[i] < arr[i - 1])) continue;
+
+        T key = std::move(arr[i]);
+        int j = i;
+        do {
+            arr[j] = std::move(arr[j - 1]);
+            --j;
+        } while (j > low && key < arr[j - 1]);
+        arr[j] = std::move(key);
+
+        moves += i - j;
+        if (moves > PDQ_PARTIAL_INSERTION_LIMIT) return false;
+    }
+    return true;
+}
+
+// Hoare-style partition of arr[low..high] around arr[low], equal keys go right
+// Requires an element not smaller than the pivot in the range.
+template <typename T>
+int partitionRight(std::vector<T>& arr, int low, int high, bool& alreadyPartitioned) {
+    T pivot = std::move(arr[low]);
+    int first = low;
+    int last = high + 1;
+
+    while (arr[++first] < pivot) {}
+    if (first - 1 == low) {
+        while (first < last && !(arr[--last] < pivot)) {}
+    } else {
+        while (!(arr[--last] < pivot)) {}
+    }
+
+    alreadyPartitioned = first >= last;
+    while (first < last) {
+        std::swap(arr[first], arr[last]);
+        while (arr[++first] < pivot) {}
+        while (!(arr[--last] < pivot)) {}
+    }
+
+    int pivotIndex = first - 1;
+    arr[low] = std::move(arr[pivotIndex]);
+    arr[pivotIndex] = std::move(pivot);
+    return pivotIndex;
+}
+
+// Three-way (fat pivot) partition of arr[low..high] around arr[low]
+// On return arr[low..lt-1] < pivot, arr[lt..gt] == pivot and arr[gt+1..high] > pivot.
+template <typename T>
+void partitionThreeWay(std::vector<T>& arr, int low, int high, int& lt, int& gt) {
+    T pivot = arr[low];
+    lt = low;
+    gt = high;
+    int i = low + 1;
+    while (i <= gt) {
+        if (arr[i] < pivot) {
+            std::swap(arr[lt++], arr[i++]);
+        } else if (pivot < arr[i]) {
+            std::swap(arr[i], arr[gt--]);
+        } else {
+            ++i;
+        }
+    }
+}
+
+// Swaps a few elements of arr[low..high] with elements a quarter further in,
+// to break up the pattern that produced an unbalanced partition
+template <typename T>
+void shufflePivotCandidates(std::vector<T>& arr, int low, int high) {
+    int size = high - low + 1;
+    if (size < PDQ_INSERTION_THRESHOLD) return;
+
+    int quarter = size / 4;
+    std::swap(arr[low], arr[low + quarter]);
+    std::swap(arr[high], arr[high - quarter]);
+    if (size > PDQ_NINTHER_THRESHOLD) {
+        std::swap(arr[low + 1], arr[low + quarter + 1]);
+        std::swap(arr[low + 2], arr[low + quarter + 2]);
+        std::swap(arr[high - 1], arr[high - quarter - 1]);
+        std::swap(arr[high - 2], arr[high - quarter - 2]);
+    }
+}
+
+// pdqsort core logic
+// leftmost is false when arr[low - 1] is a previous pivot, i.e. not greater than any
+// element of the range.
+template <typename T>
+void pdqsort(std::vector<T>& arr, int low, int high, int badAllowed, bool leftmost) {
+    while (true) {
+        int size = high - low + 1;
+
+        if (size < PDQ_INSERTION_THRESHOLD) {
+            if (size > 1) insertionSort(arr, low, high);
+            return;
+        }
+
+        // Pivot to arr[low]: median of three, or pseudo-median of nine on large ranges
+        int mid = low + size / 2;
+        if (size > PDQ_NINTHER_THRESHOLD) {
+            sort3(arr, low, mid, high);
+            sort3(arr, low + 1, mid - 1, high - 1);
+            sort3(arr, low + 2, mid + 1, high - 2);
+            sort3(arr, mid - 1, mid, mid + 1);
+            std::swap(arr[low], arr[mid]);
+        } else {
+            sort3(arr, mid, low, high);
+        }
+
+        // Pivot equal to the previous one: nothing is smaller, pull every equal key next to it
+        if (!leftmost && !(arr[low - 1] < arr[low])) {
+            int lt;
+            int gt;
+            partitionThreeWay(arr, low, high, lt, gt);
+            if (lt > low) {
+                pdqsort(arr, low, lt - 1, badAllowed, leftmost);
+            }
+            low = gt + 1;
+            continue;
+        }
+
+        bool alreadyPartitioned = false;
+        int pivotIndex;
+        if constexpr (std::is_arithmetic_v<T>) {
+            T* begin = arr.data() + low;
+            pivotIndex = low + static_cast<int>(blockPartitionRange(begin, arr.data() + high + 1, alreadyPartitioned) - begin);
+        } else {
+            pivotIndex = partitionRight(arr, low, high, alreadyPartitioned);
+        }
+
+        int leftSize = pivotIndex - low;
+        int rightSize = high - pivotIndex;
+        bool highlyUnbalanced = leftSize < size / 8 || rightSize < size / 8;
+
+        if (highlyUnbalanced) {
+            if (--badAllowed == 0) {
+                heapSort(arr, low, high);
+                return;
+            }
+            shufflePivotCandidates(arr, low, pivotIndex - 1);
+            shufflePivotCandidates(arr, pivotIndex + 1, high);
+        } else if (alreadyPartitioned
+                   && partialInsertionSort(arr, low, pivotIndex - 1)
+                   && partialInsertionSort(arr, pivotIndex + 1, high)) {
+            return;
+        }
+
+        pdqsort(arr, low, pivotIndex - 1, badAllowed, leftmost);
+        low = pivotIndex + 1;
+        leftmost = false;
+    }
+}
+
+// Returns true if arr is a single run, reversing it first when it is descending
+// Stops at the first element that breaks the run, so unsorted inputs cost very little.
+template <typename T>
+bool sortSingleRun(std::vector<T>& arr) {
+    const size_t n = arr.size();
+    size_t i = 1;
+    if (arr[1] < arr[0]) {
+        while (i < n && !(arr[i - 1] < arr[i])) ++i;
+        if (i < n) return false;
+        std::reverse(arr.begin(), arr.end());
+        return true;
+    }
+    while (i < n && !(arr[i] < arr[i - 1])) ++i;
+    return i == n;
+}
+
+// Public interface
+template <typename T>
+void pdqSortAll(std::vector<T>& arr) {
+    int n = static_cast<int>(arr.size());
+    if (n < 2 || sortSingleRun(arr)) return;
+    pdqsort(arr, 0, n - 1, static_cast<int>(std::log2(n)), true);
+}
+
+} // namespace sort_custom
+
+} // namespace algolab
@@ -0,0 +1 @@
+#include "prefix_sort.h"
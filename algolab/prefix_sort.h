@@ -0,0 +1,180 @@
+#pragma once
+
+#include <vector>
+#include <algorithm>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <ranges>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include "sort_ranges.h"
+#include "radix_sort.h"
+#include "argsort.h"
+
+namespace algolab {
+
+/**
+ * @brief Key-prefix caching sorts for expensive comparators
+ * @details
+ * Comparing std::string or composite keys through operator< follows pointers and
+ * branches on every comparison. The sorts under algolab::sort_prefix compute a
+ * normalized 8-byte prefix of every key once and sort compact (prefix, index)
+ * entries instead:
+ *  - entries with different prefixes are ordered by one integer comparison, the
+ *    records themselves are not touched,
+ *  - on equal prefixes the full comparator decides, unless the prefix is complete
+ *    (it holds the whole key, so equal prefixes mean equivalent keys),
+ *  - the records are then moved once into place with sort_key::applyPermutation.
+ * prefixIntroSortAll runs introsort on the entries, prefixMergeSortAll the stable
+ * merge sort. The prefix must agree with the comparator: comp(a, b) implies
+ * prefix(a).bits <= prefix(b).bits. NormalizedPrefix provides it for the default
+ * ascending order of arithmetic keys (their radix key, complete except for NaN) and of
+ * strings (7 leading bytes and the byte count, complete below 7 bytes); composite
+ * keys pass their own prefix function, e.g. the prefix of their leading field with
+ * complete = false. With any other comparator NormalizedPrefix would contradict it,
+ * so the sorts skip the prefixes and run the plain comparison sort on the records.
+ */
+
+namespace sort_prefix {
+
+// Normalized leading bytes of a key, compared as an unsigned integer
+struct KeyPrefix {
+    uint64_t bits;
+    bool complete; // bits hold the whole key: equal prefixes mean equivalent keys
+};
+
+// Bytes of a string held by its prefix, the low byte holds their count
+constexpr size_t PREFIX_STRING_BYTES = 7;
+
+struct NormalizedPrefix {
+    // -0.0 shares the prefix of +0.0, the key it compares equal to. NaN is unordered: its
+    // prefix is never complete, so it only ties with NaNs of the same bits and has no
+    // defined place among the other keys.
+    template <typename K>
+        requires(std::is_arithmetic_v<K> && !std::is_same_v<K, bool>)
+    KeyPrefix operator()(K key) const {
+        constexpr int shift = 64 - 8 * static_cast<int>(sizeof(sort_radix::radix_key_t<K>));
+        bool complete = true;
+        if constexpr (std::is_floating_point_v<K>) {
+            complete = !std::isnan(key);
+        }
+        return {static_cast<uint64_t>(sort_radix::toFoldedRadixKey(key)) << shift, complete};
+    }
+
+    // Bytes as unsigned char, like std::string::compare; on equal bytes the shorter
+    // string has the smaller count and orders first
+    KeyPrefix operator()(std::string_view key) const {
+        const size_t count = std::min(key.size(), PREFIX_STRING_BYTES);
+        uint64_t bits = 0;
+        for (size_t i = 0; i < count; ++i) {
+            bits |= uint64_t(static_cast<unsigned char>(key[i])) << (56 - 8 * i);
+        }
+        return {bits | count, key.size() < PREFIX_STRING_BYTES};
+    }
+};
+
+namespace detail {
+
+template <typename Index>
+struct PrefixEntry {
+    uint64_t prefix;
+    Index index;
+    bool complete;
+};
+
+// Entry order: prefix first, then the comparator on the records for incomplete ties
+template <typename Index, typename I, typename Comp, typename Proj>
+struct PrefixLess {
+    I records;
+    Comp& comp;
+    Proj& proj;
+
+    bool operator()(const PrefixEntry<Index>& a, const PrefixEntry<Index>& b) const {
+        if (a.prefix != b.prefix) return a.prefix < b.prefix;
+        if (a.complete) return false;
+        using D = std::iter_difference_t<I>;
+        return std::invoke(comp, std::invoke(proj, records[static_cast<D>(a.index)]),
+                           std::invoke(proj, records[static_cast<D>(b.index)]));
+    }
+};
+
+template <typename Index, typename R, typename Comp, typename Proj, typename Prefix, typename Sort>
+void prefixSort(R& records, Comp& comp, Proj& proj, Prefix& prefix, Sort sortEntries) {
+    const size_t n = static_cast<size_t>(std::ranges::size(records));
+    std::vector<PrefixEntry<Index>> entries;
+    entries.reserve(n);
+    Index i = 0;
+    for (auto&& record : records) {
+        KeyPrefix key = std::invoke(prefix, std::invoke(proj, record));
+        entries.push_back({key.bits, i++, key.complete});
+    }
+
+    auto first = std::ranges::begin(records);
+    sortEntries(entries, PrefixLess<Index, decltype(first), Comp, Proj> {first, comp, proj});
+
+    std::vector<size_t> perm(n);
+    for (size_t j = 0; j < n; ++j) {
+        perm[j] = entries[j].index;
+    }
+    sort_key::applyPermutation(records, std::move(perm));
+}
+
+template <typename R, typename Comp, typename Proj, typename Prefix, typename Sort>
+void prefixSort(R& records, Comp& comp, Proj& proj, Prefix& prefix, Sort sortEntries) {
+    if (std::ranges::size(records) < 2) return;
+    if (std::ranges::size(records) <= std::numeric_limits<uint32_t>::max()) {
+        prefixSort<uint32_t>(records, comp, proj, prefix, sortEntries);
+    } else {
+        prefixSort<size_t>(records, comp, proj, prefix, sortEntries);
+    }
+}
+
+} // namespace detail
+
+// NormalizedPrefix follows the ascending order only
+template <typename Comp, typename Prefix>
+constexpr bool prefixMatchesComparator = !std::is_same_v<Prefix, NormalizedPrefix>
+                                         || std::is_same_v<Comp, std::ranges::less> || std::is_same_v<Comp, std::less<>>;
+
+template <typename Prefix, typename R, typename Proj>
+concept PrefixFunction = std::is_invocable_r_v<KeyPrefix, Prefix&,
+                                               std::invoke_result_t<Proj&, std::ranges::range_reference_t<R>>>;
+
+// IntroSort of range on cached key prefixes
+template <std::ranges::random_access_range R, typename Comp = std::ranges::less, typename Proj = std::identity,
+          typename Prefix = NormalizedPrefix>
+    requires std::ranges::sized_range<R> && std::sortable<std::ranges::iterator_t<R>, Comp, Proj>
+             && PrefixFunction<Prefix, R, Proj>
+void prefixIntroSortAll(R&& range, Comp comp = {}, Proj proj = {}, Prefix prefix = {}) {
+    if constexpr (!prefixMatchesComparator<Comp, Prefix>) {
+        ranges::introSortAll(range, std::move(comp), std::move(proj));
+    } else {
+        detail::prefixSort(range, comp, proj, prefix, [](auto& entries, auto less) {
+            ranges::introSortAll(entries, less);
+        });
+    }
+}
+
+// Stable MergeSort of range on cached key prefixes
+template <std::ranges::random_access_range R, typename Comp = std::ranges::less, typename Proj = std::identity,
+          typename Prefix = NormalizedPrefix>
+    requires std::ranges::sized_range<R> && std::sortable<std::ranges::iterator_t<R>, Comp, Proj>
+             && PrefixFunction<Prefix, R, Proj>
+void prefixMergeSortAll(R&& range, Comp comp = {}, Proj proj = {}, Prefix prefix = {}) {
+    if constexpr (!prefixMatchesComparator<Comp, Prefix>) {
+        ranges::mergeSortAll(range, std::move(comp), std::move(proj));
+    } else {
+        detail::prefixSort(range, comp, proj, prefix, [](auto& entries, auto less) {
+            ranges::mergeSortAll(entries, less);
+        });
+    }
+}
+
+} // namespace sort_prefix
+
+} // namespace algolab
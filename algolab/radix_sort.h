@@ -0,0 +1,210 @@
+#pragma once
+
+#include <vector>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+namespace algolab {
+
+/**
+ * @brief Radix sort implementations
+ * @details
+ * Non-comparison sorts for integral and floating point keys, under algolab::sort_radix.
+ * Keys are mapped to unsigned integers of the same width whose unsigned order is
+ * the order of the original values:
+ *  - unsigned integers are used as is,
+ *  - signed integers get their sign bit flipped,
+ *  - IEEE floats get all bits flipped when negative, only the sign bit otherwise.
+ * The keys are then sorted one byte (256 buckets) at a time:
+ *  - radixSortAll is LSD: stable, one scratch buffer, one pass per byte and byte
+ *    positions where all keys agree are skipped,
+ *  - msdRadixSortAll is MSD in-place (American flag sort): buckets are permuted
+ *    in place by cycle leading, so no scratch buffer is needed.
+ */
+
+namespace sort_radix {
+
+// Below this size a radix pass costs more than insertion sort
+constexpr size_t RADIX_INSERTION_THRESHOLD = 64;
+
+template <typename T>
+struct RadixKey {
+    static_assert(std::is_arithmetic_v<T>, "Radix sort requires an arithmetic type");
+    using type = std::make_unsigned_t<T>;
+};
+
+template <>
+struct RadixKey<float> {
+    using type = uint32_t;
+};
+
+template <>
+struct RadixKey<double> {
+    using type = uint64_t;
+};
+
+template <typename T>
+using radix_key_t = typename RadixKey<T>::type;
+
+// Order-preserving transform of a value to its unsigned radix key
+template <typename T>
+constexpr radix_key_t<T> toRadixKey(T value) {
+    using Key = radix_key_t<T>;
+    constexpr Key signBit = Key(1) << (sizeof(Key) * 8 - 1);
+
+    if constexpr (std::is_floating_point_v<T>) {
+        Key bits = std::bit_cast<Key>(value);
+        return (bits & signBit) ? Key(~bits) : Key(bits | signBit);
+    } else if constexpr (std::is_signed_v<T>) {
+        return static_cast<Key>(value) ^ signBit;
+    } else {
+        return static_cast<Key>(value);
+    }
+}
+
+// toRadixKey with -0.0 folded onto +0.0: keys that compare equal under operator< get
+// equal radix keys, as stable sorts by key need (NaNs keep their distinct keys)
+template <typename T>
+constexpr radix_key_t<T> toFoldedRadixKey(T value) {
+    if constexpr (std::is_floating_point_v<T>) {
+        if (value == T(0)) value = T(0);
+    }
+    return toRadixKey(value);
+}
+
+template <typename T>
+constexpr unsigned radixDigit(T value, int shift) {
+    return static_cast<unsigned>((toRadixKey(value) >> shift) & 0xFF);
+}
+
+// Insertion sort on radix keys, for the small buckets of the MSD sort
+template <typename T>
+void insertionSortByKey(T* first, T* last) {
+    for (T* it = first + 1; it < last; ++it) {
+        T value = std::move(*it);
+        auto key = toRadixKey(value);
+        T* hole = it;
+        while (hole > first && key < toRadixKey(*(hole - 1))) {
+            *hole = std::move(*(hole - 1));
+            --hole;
+        }
+        *hole = std::move(value);
+    }
+}
+
+// LSD radix sort
+// All byte histograms are built in one read pass, then each byte position costs
+// one scatter pass between arr and a single scratch buffer.
+template <typename T>
+void radixSortAll(std::vector<T>& arr) {
+    using Key = radix_key_t<T>;
+    constexpr int passes = sizeof(Key);
+
+    const size_t n = arr.size();
+    if (n < RADIX_INSERTION_THRESHOLD) {
+        if (n > 1) insertionSortByKey(arr.data(), arr.data() + n);
+        return;
+    }
+
+    std::vector<std::array<size_t, 256>> counts(passes);
+    for (const T& value : arr) {
+        Key key = toRadixKey(value);
+        for (int p = 0; p < passes; ++p) {
+            ++counts[p][(key >> (8 * p)) & 0xFF];
+        }
+    }
+
+    std::vector<T> buffer(n);
+    T* src = arr.data();
+    T* dst = buffer.data();
+
+    for (int p = 0; p < passes; ++p) {
+        const int shift = 8 * p;
+        // Every key has the same byte here: the pass would not move anything
+        if (counts[p][radixDigit(src[0], shift)] == n) {
+            continue;
+        }
+
+        std::array<size_t, 256> offsets;
+        size_t sum = 0;
+        for (int b = 0; b < 256; ++b) {
+            offsets[b] = sum;
+            sum += counts[p][b];
+        }
+
+        for (size_t i = 0; i < n; ++i) {
+            dst[offsets[radixDigit(src[i], shift)]++] = std::move(src[i]);
+        }
+        std::swap(src, dst);
+    }
+
+    if (src != arr.data()) {
+        std::move(src, src + n, arr.data());
+    }
+}
+
+// MSD in-place radix sort (American flag sort) of [first, last) on the byte at shift
+template <typename T>
+void americanFlagSort(T* first, T* last, int shift) {
+    const size_t n = static_cast<size_t>(last - first);
+    if (n < RADIX_INSERTION_THRESHOLD) {
+        insertionSortByKey(first, last);
+        return;
+    }
+
+    std::array<size_t, 256> counts {};
+    for (T* it = first; it < last; ++it) {
+        ++counts[radixDigit(*it, shift)];
+    }
+
+    std::array<size_t, 256> heads;
+    std::array<size_t, 256> tails;
+    size_t sum = 0;
+    for (int b = 0; b < 256; ++b) {
+        heads[b] = sum;
+        sum += counts[b];
+        tails[b] = sum;
+    }
+
+    // Walk each bucket and send misplaced elements to the head of their own bucket,
+    // following the displacement cycle until an element belonging here comes back
+    for (unsigned b = 0; b < 256; ++b) {
+        while (heads[b] < tails[b]) {
+            T value = std::move(first[heads[b]]);
+            unsigned digit = radixDigit(value, shift);
+            while (digit != b) {
+                std::swap(value, first[heads[digit]++]);
+                digit = radixDigit(value, shift);
+            }
+            first[heads[b]++] = std::move(value);
+        }
+    }
+
+    if (shift == 0) {
+        return;
+    }
+
+    size_t start = 0;
+    for (int b = 0; b < 256; ++b) {
+        if (counts[b] > 1) {
+            americanFlagSort(first + start, first + start + counts[b], shift - 8);
+        }
+        start += counts[b];
+    }
+}
+
+// Public interface
+template <typename T>
+void msdRadixSortAll(std::vector<T>& arr) {
+    if (arr.size() < 2) return;
+    constexpr int topShift = 8 * (sizeof(radix_key_t<T>) - 1);
+    americanFlagSort(arr.data(), arr.data() + arr.size(), topShift);
+}
+
+} // namespace sort_radix
+
+} // namespace algolab
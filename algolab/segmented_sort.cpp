@@ -0,0 +1 @@
+#include "segmented_sort.h"
@@ -0,0 +1,148 @@
+#pragma once
+
+#include <vector>
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include "introsort.h"
+#include "sorting_network.h"
+#include "sort_mt.h"
+#include "thread_pool.h"
+
+namespace algolab {
+
+/**
+ * @brief Segmented sort: many independent arrays in one flat buffer
+ * @details
+ * segmentedSort(data, offsets) sorts every segment data[offsets[i], offsets[i + 1])
+ * in place, so millions of small lists are sorted without one std::vector, one call
+ * and one allocation each. Each segment is sorted by the cheapest strategy for its size:
+ *  - arithmetic keys of up to SEGMENT_NETWORK_MAX elements by a compile-time sorting
+ *    network (sorting_network.h), other types of up to INTROSORT_INSERTION_THRESHOLD
+ *    elements by insertion sort, which moves fewer of their heavier elements,
+ *  - larger segments by sequential introsort,
+ *  - on a pool, segments above PARALLEL_CUTOFF by the parallel introsort of sort_mt.
+ * segmentedSortOn spreads the segments over the pool: consecutive segments are batched
+ * into tasks of about SEGMENT_TASK_ELEMENTS elements, so neither tiny segments nor one
+ * huge segment leave threads idle.
+ * offsets holds the segment count + 1 boundaries, non-decreasing, the first is usually 0
+ * and the last at most data.size(); elements outside [offsets.front(), offsets.back())
+ * are left alone. Invalid offsets throw std::invalid_argument before anything is sorted.
+ */
+
+namespace sort_segment {
+
+// Arithmetic segments of up to this size are sorted by a sorting network
+constexpr size_t SEGMENT_NETWORK_MAX = sort_network::SORTING_NETWORK_MAX_SIZE;
+// Elements of consecutive segments batched into one pool task
+constexpr size_t SEGMENT_TASK_ELEMENTS = size_t(1) << 14;
+
+namespace detail {
+
+inline void checkOffsets(std::span<const size_t> offsets, size_t size) {
+    for (size_t i = 0; i + 1 < offsets.size(); ++i) {
+        if (offsets[i] > offsets[i + 1]) {
+            throw std::invalid_argument("segmentedSort: offsets are not non-decreasing");
+        }
+    }
+    if (!offsets.empty() && offsets.back() > size) {
+        throw std::invalid_argument("segmentedSort: offset past the end of the data");
+    }
+}
+
+// Sorts data[first, last) with the strategy for its size
+template <typename T>
+void sortSegment(std::vector<T>& data, size_t first, size_t last) {
+    const size_t n = last - first;
+    if (n < 2) return;
+
+    if constexpr (std::is_arithmetic_v<T>) {
+        if (n <= SEGMENT_NETWORK_MAX) {
+            sort_network::sortSmall(data.data() + first, n);
+            return;
+        }
+    }
+    int low = static_cast<int>(first);
+    int high = static_cast<int>(last) - 1;
+    if (n <= static_cast<size_t>(sort_custom::INTROSORT_INSERTION_THRESHOLD)) {
+        sort_custom::insertionSort(data, low, high);
+        return;
+    }
+    sort_custom::introsort(data, low, high, 2 * static_cast<int>(std::log2(n)));
+}
+
+template <typename T>
+void sortSegments(std::vector<T>& data, std::span<const size_t> offsets) {
+    for (size_t i = 0; i + 1 < offsets.size(); ++i) {
+        sortSegment(data, offsets[i], offsets[i + 1]);
+    }
+}
+
+} // namespace detail
+
+// Sorts every segment on the calling thread
+template <typename T>
+void segmentedSort(std::vector<T>& data, std::span<const size_t> offsets) {
+    detail::checkOffsets(offsets, data.size());
+    detail::sortSegments(data, offsets);
+}
+
+// Sorts every segment on the given pool
+// Segments above cutoff elements are split further by parallel introsort.
+template <typename T>
+void segmentedSortOn(std::vector<T>& data, std::span<const size_t> offsets, ThreadPool& pool,
+                     int cutoff = sort_mt::PARALLEL_CUTOFF) {
+    detail::checkOffsets(offsets, data.size());
+    if (offsets.size() < 2) return;
+    if (offsets.back() - offsets.front() <= SEGMENT_TASK_ELEMENTS) {
+        detail::sortSegments(data, offsets);
+        return;
+    }
+
+    TaskGroup group(pool);
+    size_t batchStart = 0;
+    size_t batchElements = 0;
+    auto flush = [&](size_t batchEnd) {
+        if (batchEnd > batchStart) {
+            std::span<const size_t> batch = offsets.subspan(batchStart, batchEnd - batchStart + 1);
+            group.run([&data, batch]() { detail::sortSegments(data, batch); });
+        }
+        batchStart = batchEnd;
+        batchElements = 0;
+    };
+
+    for (size_t i = 0; i + 1 < offsets.size(); ++i) {
+        const size_t n = offsets[i + 1] - offsets[i];
+        if (n > static_cast<size_t>(cutoff)) {
+            // A huge segment gets its own parallel sort, the batch so far is handed out first
+            flush(i);
+            int low = static_cast<int>(offsets[i]);
+            int high = static_cast<int>(offsets[i + 1]) - 1;
+            int depthLimit = 2 * static_cast<int>(std::log2(n));
+            group.run([&data, low, high, depthLimit, &group, cutoff]() {
+                sort_mt::parallelIntrosort(data, low, high, depthLimit, group, cutoff);
+            });
+            batchStart = i + 1;
+            continue;
+        }
+        batchElements += n;
+        if (batchElements >= SEGMENT_TASK_ELEMENTS) {
+            flush(i + 1);
+        }
+    }
+    flush(offsets.size() - 1);
+    group.wait();
+}
+
+// Public interface
+template <typename T>
+void segmentedSortAll(std::vector<T>& data, std::span<const size_t> offsets) {
+    segmentedSortOn(data, offsets, ThreadPool::shared());
+}
+
+} // namespace sort_segment
+
+} // namespace algolab
@@ -0,0 +1 @@
+#include "selection.h"
@@ -0,0 +1,224 @@
+#pragma once
+
+#include <vector>
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+#include "sort_ranges.h"
+
+namespace algolab {
+
+/**
+ * @brief Selection algorithms: nth element, quantiles, partial sort and top-k
+ * @details
+ * Order statistics without sorting everything, under algolab::sort_select:
+ *  - nthElement: Floyd-Rivest selection. Ranges above SELECT_SAMPLE_THRESHOLD first
+ *    recurse on a small sample around the expected rank, so the pivot lands within
+ *    a few elements of it and about n + min(k, n - k) comparisons suffice. Every
+ *    level has an iteration budget and falls back to heap selection when exceeded
+ *    (introselect), bounding the worst case to O(n log n),
+ *  - multiSelect / quantiles: several ranks in one pass: each selected rank splits the
+ *    range, and the remaining ranks are only searched in their own side,
+ *  - partialSort: select the k-th element, then introsort the k smallest,
+ *  - topK: bounded heap of the k largest elements of any input range, without
+ *    modifying it (works on streams).
+ * The functions on random access ranges reorder their input in place.
+ * Reference: Floyd & Rivest, "Algorithm 489: SELECT" (CACM 1975).
+ */
+
+namespace sort_select {
+
+// Above this size Floyd-Rivest samples the range to place its pivot
+constexpr std::ptrdiff_t SELECT_SAMPLE_THRESHOLD = 600;
+
+namespace detail {
+
+// Places the k-th smallest of [first, last) at nth with a max-heap of the nth - first + 1 smallest
+template <typename I, typename Compare>
+void heapSelect(I first, I nth, I last, Compare& comp) {
+    I heapEnd = nth + 1;
+    std::make_heap(first, heapEnd, comp);
+    for (I it = heapEnd; it != last; ++it) {
+        if (comp(*it, *first)) {
+            std::pop_heap(first, heapEnd, comp);
+            std::iter_swap(nth, it);
+            std::push_heap(first, heapEnd, comp);
+        }
+    }
+    std::iter_swap(first, nth);
+}
+
+// Floyd-Rivest selection of rank k in first[left..right] (inclusive bounds)
+template <typename I, typename Compare>
+void floydRivest(I first, std::iter_difference_t<I> left, std::iter_difference_t<I> right,
+                 std::iter_difference_t<I> k, Compare& comp) {
+    using D = std::iter_difference_t<I>;
+    int budget = 4 * static_cast<int>(std::log2(static_cast<double>(right - left + 1))) + 16;
+
+    while (right > left) {
+        if (budget-- == 0) {
+            heapSelect(first + left, first + k, first + right + 1, comp);
+            return;
+        }
+
+        // Recurse on a sample of size ~n^(2/3) bracketing rank k to get a close pivot
+        if (right - left > SELECT_SAMPLE_THRESHOLD) {
+            double n = static_cast<double>(right - left + 1);
+            double i = static_cast<double>(k - left + 1);
+            double z = std::log(n);
+            double s = 0.5 * std::exp(2.0 * z / 3.0);
+            double sd = 0.5 * std::sqrt(z * s * (n - s) / n) * (i < n / 2 ? -1.0 : 1.0);
+            D newLeft = std::max(left, static_cast<D>(static_cast<double>(k) - i * s / n + sd));
+            D newRight = std::min(right, static_cast<D>(static_cast<double>(k) + (n - i) * s / n + sd));
+            floydRivest(first, newLeft, newRight, k, comp);
+        }
+
+        // Partition around t = first[k], with first[left] and first[right] as sentinels
+        auto t = first[k];
+        D i = left;
+        D j = right;
+        std::iter_swap(first + left, first + k);
+        if (comp(t, first[right])) std::iter_swap(first + right, first + left);
+        while (i < j) {
+            std::iter_swap(first + i, first + j);
+            ++i;
+            --j;
+            while (comp(first[i], t)) ++i;
+            while (comp(t, first[j])) --j;
+        }
+        if (!comp(first[left], t)) {
+            std::iter_swap(first + left, first + j);
+        } else {
+            ++j;
+            std::iter_swap(first + j, first + right);
+        }
+
+        // t is now at j: keep the side holding rank k
+        if (j <= k) left = j + 1;
+        if (k <= j) right = j - 1;
+    }
+}
+
+template <typename I, typename Compare>
+void multiSelect(I first, std::iter_difference_t<I> left, std::iter_difference_t<I> right,
+                 const std::iter_difference_t<I>* ranksBegin, const std::iter_difference_t<I>* ranksEnd,
+                 Compare& comp) {
+    if (ranksBegin == ranksEnd || left >= right) return;
+
+    const auto* mid = ranksBegin + (ranksEnd - ranksBegin) / 2;
+    auto k = *mid;
+    floydRivest(first, left, right - 1, k, comp);
+    multiSelect(first, left, k, ranksBegin, mid, comp);
+    multiSelect(first, k + 1, right, mid + 1, ranksEnd, comp);
+}
+
+} // namespace detail
+
+// Rearranges [first, last) so that *nth is the element a full sort would put there,
+// nothing after it is smaller and nothing before it is greater
+template <std::random_access_iterator I, typename Compare = std::less<>>
+void nthElement(I first, I nth, I last, Compare comp = Compare()) {
+    if (last - first < 2 || nth == last) return;
+    detail::floydRivest(first, std::iter_difference_t<I>(0), last - first - 1, nth - first, comp);
+}
+
+// Places every rank of ranks (0-based, any order) at its sorted position in one pass
+// Elements between two selected ranks are only partitioned, not sorted.
+template <std::random_access_iterator I, typename Compare = std::less<>>
+void multiSelect(I first, I last, std::vector<size_t> ranks, Compare comp = Compare()) {
+    using D = std::iter_difference_t<I>;
+    const auto n = static_cast<size_t>(last - first);
+
+    std::sort(ranks.begin(), ranks.end());
+    ranks.erase(std::unique(ranks.begin(), ranks.end()), ranks.end());
+    if (!ranks.empty() && ranks.back() >= n) {
+        throw std::out_of_range("multiSelect: rank out of range");
+    }
+
+    std::vector<D> sorted(ranks.begin(), ranks.end());
+    detail::multiSelect(first, D(0), static_cast<D>(n), sorted.data(), sorted.data() + sorted.size(), comp);
+}
+
+// Quantiles of [first, last) for each q in [0, 1], interpolated linearly between
+// closest ranks (the default of R, NumPy and Excel PERCENTILE.INC)
+// All requested quantiles are computed by one multiSelect; the range is reordered.
+template <std::random_access_iterator I>
+std::vector<double> quantiles(I first, I last, const std::vector<double>& qs) {
+    const auto n = static_cast<size_t>(last - first);
+    if (n == 0) {
+        throw std::runtime_error("Cannot compute quantiles of an empty range");
+    }
+
+    std::vector<size_t> ranks;
+    ranks.reserve(2 * qs.size());
+    for (double q : qs) {
+        if (!(q >= 0.0 && q <= 1.0)) {
+            throw std::invalid_argument("quantiles: q must be within [0, 1]");
+        }
+        double h = q * static_cast<double>(n - 1);
+        auto low = static_cast<size_t>(h);
+        ranks.push_back(low);
+        if (low + 1 < n && h > static_cast<double>(low)) ranks.push_back(low + 1);
+    }
+    multiSelect(first, last, ranks);
+
+    std::vector<double> result;
+    result.reserve(qs.size());
+    for (double q : qs) {
+        double h = q * static_cast<double>(n - 1);
+        auto low = static_cast<size_t>(h);
+        double value = static_cast<double>(first[low]);
+        if (low + 1 < n && h > static_cast<double>(low)) {
+            value += (h - static_cast<double>(low)) * (static_cast<double>(first[low + 1]) - value);
+        }
+        result.push_back(value);
+    }
+    return result;
+}
+
+// Sorts the middle - first smallest elements of [first, last) into [first, middle)
+// The order of [middle, last) is unspecified. O(n + k log k).
+template <std::random_access_iterator I, typename Compare = std::less<>>
+void partialSort(I first, I middle, I last, Compare comp = Compare()) {
+    if (middle == first) return;
+    nthElement(first, middle - 1, last, comp);
+    algolab::ranges::introSortAll(first, middle - 1, comp);
+}
+
+// The k largest elements of [first, last), largest first; the input is not modified
+// Keeps a k-element min-heap, so it also works on single-pass input iterators.
+template <std::input_iterator I, std::sentinel_for<I> S, typename Compare = std::less<>>
+std::vector<std::iter_value_t<I>> topK(I first, S last, size_t k, Compare comp = Compare()) {
+    using V = std::iter_value_t<I>;
+    std::vector<V> heap;
+    if (k == 0) return heap;
+    heap.reserve(k);
+
+    // Heap ordered by "greater", its front is the smallest of the k kept so far
+    auto greater = [&comp](const V& a, const V& b) { return comp(b, a); };
+    for (; first != last; ++first) {
+        if (heap.size() < k) {
+            heap.push_back(*first);
+            std::push_heap(heap.begin(), heap.end(), greater);
+        } else if (comp(heap.front(), *first)) {
+            std::pop_heap(heap.begin(), heap.end(), greater);
+            heap.back() = *first;
+            std::push_heap(heap.begin(), heap.end(), greater);
+        }
+    }
+    std::sort_heap(heap.begin(), heap.end(), greater);
+    return heap;
+}
+
+template <std::ranges::input_range R, typename Compare = std::less<>>
+std::vector<std::ranges::range_value_t<R>> topK(R&& range, size_t k, Compare comp = Compare()) {
+    return topK(std::ranges::begin(range), std::ranges::end(range), k, std::move(comp));
+}
+
+} // namespace sort_select
+
+} // namespace algolab
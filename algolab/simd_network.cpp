@@ -0,0 +1 @@
+#include "simd_network.h"
@@ -0,0 +1,325 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+#if defined(__AVX2__) || defined(__SSE4_1__)
+#include <immintrin.h>
+#endif
+
+namespace algolab {
+
+/**
+ * @brief Vectorized sorting networks
+ * @details
+ * Sorts up to NETWORK_SIZE (16) int, float or double values held in SIMD registers
+ * with a bitonic network: every compare-exchange step is one lane permutation,
+ * compares and blends, with no data-dependent branch.
+ * Pairs are only exchanged when strictly out of order, so -0.0 and 0.0 keep their
+ * values (min/max would return their second operand for both outputs). NaN has no
+ * place in the order and would let the padding overtake real elements: floating
+ * point inputs holding one are insertion sorted instead.
+ * The input is padded with the largest value of the type up to 16 lanes.
+ *
+ * The instruction set is chosen at compile time:
+ *  - AVX2: 8 x int32 / float or 4 x double per register,
+ *  - SSE4.1: 4 x int32 / float or 2 x double per register,
+ *  - otherwise hasNetwork<T> is false and callers keep their scalar path.
+ * Build with -mavx2 / -msse4.1 (or ALGOLAB_NATIVE_ARCH in CMake) to enable it.
+ */
+
+namespace sort_simd {
+
+constexpr int NETWORK_SIZE = 16;
+
+#if defined(__AVX2__)
+
+struct Int32Lanes {
+    using value_type = int32_t;
+    using reg = __m256i;
+    static constexpr int lanes = 8;
+
+    static reg load(const int32_t* p) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)); }
+    static void store(int32_t* p, reg v) { _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v); }
+    // All bits set in the lanes where a < b
+    static reg less(reg a, reg b) { return _mm256_cmpgt_epi32(b, a); }
+    // Lanes set in mask take b, the others take a
+    static reg blend(reg a, reg b, reg mask) { return _mm256_blendv_epi8(a, b, mask); }
+
+    // Lane i receives lane i ^ J
+    template <int J>
+    static reg exchange(reg v) {
+        return _mm256_permutevar8x32_epi32(v, _mm256_setr_epi32(0 ^ J, 1 ^ J, 2 ^ J, 3 ^ J, 4 ^ J, 5 ^ J, 6 ^ J, 7 ^ J));
+    }
+
+    // Lanes whose bit is set in Mask take b, the others take a
+    template <int Mask>
+    static reg select(reg a, reg b) {
+        return _mm256_blend_epi32(a, b, Mask);
+    }
+};
+
+struct FloatLanes {
+    using value_type = float;
+    using reg = __m256;
+    static constexpr int lanes = 8;
+
+    static reg load(const float* p) { return _mm256_loadu_ps(p); }
+    static void store(float* p, reg v) { _mm256_storeu_ps(p, v); }
+    static reg less(reg a, reg b) { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+    static reg blend(reg a, reg b, reg mask) { return _mm256_blendv_ps(a, b, mask); }
+
+    template <int J>
+    static reg exchange(reg v) {
+        return _mm256_permutevar8x32_ps(v, _mm256_setr_epi32(0 ^ J, 1 ^ J, 2 ^ J, 3 ^ J, 4 ^ J, 5 ^ J, 6 ^ J, 7 ^ J));
+    }
+
+    template <int Mask>
+    static reg select(reg a, reg b) {
+        return _mm256_blend_ps(a, b, Mask);
+    }
+};
+
+struct DoubleLanes {
+    using value_type = double;
+    using reg = __m256d;
+    static constexpr int lanes = 4;
+
+    static reg load(const double* p) { return _mm256_loadu_pd(p); }
+    static void store(double* p, reg v) { _mm256_storeu_pd(p, v); }
+    static reg less(reg a, reg b) { return _mm256_cmp_pd(a, b, _CMP_LT_OQ); }
+    static reg blend(reg a, reg b, reg mask) { return _mm256_blendv_pd(a, b, mask); }
+
+    template <int J>
+    static reg exchange(reg v) {
+        // 0xB1 swaps neighbours (1, 0, 3, 2), 0x4E swaps the 128-bit halves (2, 3, 0, 1)
+        return _mm256_permute4x64_pd(v, J == 1 ? 0xB1 : 0x4E);
+    }
+
+    template <int Mask>
+    static reg select(reg a, reg b) {
+        return _mm256_blend_pd(a, b, Mask);
+    }
+};
+
+#elif defined(__SSE4_1__)
+
+struct Int32Lanes {
+    using value_type = int32_t;
+    using reg = __m128i;
+    static constexpr int lanes = 4;
+
+    static reg load(const int32_t* p) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)); }
+    static void store(int32_t* p, reg v) { _mm_storeu_si128(reinterpret_cast<__m128i*>(p), v); }
+    // All bits set in the lanes where a < b
+    static reg less(reg a, reg b) { return _mm_cmplt_epi32(a, b); }
+    // Lanes set in mask take b, the others take a
+    static reg blend(reg a, reg b, reg mask) { return _mm_blendv_epi8(a, b, mask); }
+
+    template <int J>
+    static reg exchange(reg v) {
+        return _mm_shuffle_epi32(v, J == 1 ? 0xB1 : 0x4E);
+    }
+
+    template <int Mask>
+    static reg select(reg a, reg b) {
+        return _mm_castps_si128(_mm_blend_ps(_mm_castsi128_ps(a), _mm_castsi128_ps(b), Mask));
+    }
+};
+
+struct FloatLanes {
+    using value_type = float;
+    using reg = __m128;
+    static constexpr int lanes = 4;
+
+    static reg load(const float* p) { return _mm_loadu_ps(p); }
+    static void store(float* p, reg v) { _mm_storeu_ps(p, v); }
+    static reg less(reg a, reg b) { return _mm_cmplt_ps(a, b); }
+    static reg blend(reg a, reg b, reg mask) { return _mm_blendv_ps(a, b, mask); }
+
+    template <int J>
+    static reg exchange(reg v) {
+        return _mm_shuffle_ps(v, v, J == 1 ? 0xB1 : 0x4E);
+    }
+
+    template <int Mask>
+    static reg select(reg a, reg b) {
+        return _mm_blend_ps(a, b, Mask);
+    }
+};
+
+struct DoubleLanes {
+    using value_type = double;
+    using reg = __m128d;
+    static constexpr int lanes = 2;
+
+    static reg load(const double* p) { return _mm_loadu_pd(p); }
+    static void store(double* p, reg v) { _mm_storeu_pd(p, v); }
+    static reg less(reg a, reg b) { return _mm_cmplt_pd(a, b); }
+    static reg blend(reg a, reg b, reg mask) { return _mm_blendv_pd(a, b, mask); }
+
+    template <int J>
+    static reg exchange(reg v) {
+        return _mm_shuffle_pd(v, v, 1);
+    }
+
+    template <int Mask>
+    static reg select(reg a, reg b) {
+        return _mm_blend_pd(a, b, Mask);
+    }
+};
+
+#endif
+
+#if defined(__AVX2__) || defined(__SSE4_1__)
+
+template <typename T>
+struct LanesFor {
+    using type = void;
+};
+
+template <>
+struct LanesFor<int32_t> {
+    using type = Int32Lanes;
+};
+
+template <>
+struct LanesFor<float> {
+    using type = FloatLanes;
+};
+
+template <>
+struct LanesFor<double> {
+    using type = DoubleLanes;
+};
+
+template <typename T>
+constexpr bool hasNetwork = !std::is_void_v<typename LanesFor<T>::type>;
+
+#else
+
+template <typename T>
+constexpr bool hasNetwork = false;
+
+#endif
+
+#if defined(__AVX2__) || defined(__SSE4_1__)
+
+// Lanes of register r that keep the max of their compare-exchange pair in step (K, J)
+// Bitonic rule: element i is sorted ascending when (i & K) == 0, and within a pair
+// (i, i ^ J) the upper element keeps the max when ascending.
+constexpr int maxLaneMask(int lanes, int K, int J, int r) {
+    int mask = 0;
+    for (int l = 0; l < lanes; ++l) {
+        int i = r * lanes + l;
+        bool ascending = (i & K) == 0;
+        bool upper = (i & J) != 0;
+        if (upper == ascending) mask |= 1 << l;
+    }
+    return mask;
+}
+
+// One compare-exchange step on register r
+// Partners in other registers (J >= lanes) are handled by the lower register of the pair.
+// Every lane takes its partner only when the pair is strictly out of order, so equivalent
+// keys such as -0.0 and 0.0 stay where they are instead of being duplicated.
+template <typename V, int K, int J, int R>
+inline void bitonicRegisterStep(typename V::reg* regs) {
+    constexpr int L = V::lanes;
+    if constexpr (J >= L) {
+        if constexpr (((R * L) & J) == 0) {
+            constexpr int P = R + J / L;
+            auto outOfOrder = V::less(regs[P], regs[R]);
+            auto lo = V::blend(regs[R], regs[P], outOfOrder);
+            auto hi = V::blend(regs[P], regs[R], outOfOrder);
+            if constexpr (((R * L) & K) == 0) {
+                regs[R] = lo;
+                regs[P] = hi;
+            } else {
+                regs[R] = hi;
+                regs[P] = lo;
+            }
+        }
+    } else {
+        auto swapped = V::template exchange<J>(regs[R]);
+        // Lanes keeping the min take a smaller partner, lanes keeping the max a greater one
+        auto take = V::template select<maxLaneMask(L, K, J, R)>(V::less(swapped, regs[R]), V::less(regs[R], swapped));
+        regs[R] = V::blend(regs[R], swapped, take);
+    }
+}
+
+template <typename V, int K, int J, int... R>
+inline void bitonicStep(typename V::reg* regs, std::integer_sequence<int, R...>) {
+    (bitonicRegisterStep<V, K, J, R>(regs), ...);
+}
+
+template <typename V, int K, int J>
+inline void bitonicStep(typename V::reg* regs) {
+    bitonicStep<V, K, J>(regs, std::make_integer_sequence<int, NETWORK_SIZE / V::lanes>{});
+}
+
+// Full 16-input bitonic sort: 10 steps of 8 compare-exchanges each
+template <typename V>
+inline void bitonicSort16(typename V::reg* regs) {
+    bitonicStep<V, 2, 1>(regs);
+    bitonicStep<V, 4, 2>(regs);
+    bitonicStep<V, 4, 1>(regs);
+    bitonicStep<V, 8, 4>(regs);
+    bitonicStep<V, 8, 2>(regs);
+    bitonicStep<V, 8, 1>(regs);
+    bitonicStep<V, 16, 8>(regs);
+    bitonicStep<V, 16, 4>(regs);
+    bitonicStep<V, 16, 2>(regs);
+    bitonicStep<V, 16, 1>(regs);
+}
+
+#endif
+
+// Sorts first[0..n), n <= NETWORK_SIZE, only available when hasNetwork<T>
+// A NaN would let the padding overtake real elements, such inputs are insertion sorted.
+template <typename T>
+void sortSmall(T* first, int n) {
+    static_assert(hasNetwork<T>, "No vectorized sorting network for this type on this target");
+#if defined(__AVX2__) || defined(__SSE4_1__)
+    using V = typename LanesFor<T>::type;
+    constexpr int R = NETWORK_SIZE / V::lanes;
+
+    if constexpr (std::is_floating_point_v<T>) {
+        if (std::any_of(first, first + n, [](T x) { return x != x; })) {
+            for (int i = 1; i < n; ++i) {
+                T key = first[i];
+                int j = i - 1;
+                for (; j >= 0 && key < first[j]; --j) {
+                    first[j + 1] = first[j];
+                }
+                first[j + 1] = key;
+            }
+            return;
+        }
+    }
+
+    alignas(32) T padded[NETWORK_SIZE];
+    std::copy(first, first + n, padded);
+    std::fill(padded + n, padded + NETWORK_SIZE, std::numeric_limits<T>::has_infinity
+        ? std::numeric_limits<T>::infinity()
+        : std::numeric_limits<T>::max());
+
+    typename V::reg regs[R];
+    for (int r = 0; r < R; ++r) {
+        regs[r] = V::load(padded + r * V::lanes);
+    }
+    bitonicSort16<V>(regs);
+    for (int r = 0; r < R; ++r) {
+        V::store(padded + r * V::lanes, regs[r]);
+    }
+
+    std::copy(padded, padded + n, first);
+#endif
+}
+
+} // namespace sort_simd
+
+} // namespace algolab
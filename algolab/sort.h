@@ -143,9 +143,88 @@ void mergeSort(std::vector<T>& arr, int left, int right) {
     mergeSortedHalves<T>(arr, left, mid, right);
 }
 
+// Runs of this size are sorted with insertion sort before the bottom-up merge passes
+constexpr int MERGE_RUN_SIZE = 32;
+
+// MergeSort: moves the merge of src[left..mid] and src[mid+1..right] into dst[left..right]
+// Takes the left element on ties, so the merge is stable.
+template <typename T>
+void mergeRuns(std::vector<T>& src, std::vector<T>& dst, int left, int mid, int right) {
+    int i = left;
+    int j = mid + 1;
+    int k = left;
+
+    // Runs already in order: nothing to compare
+    if (mid >= right || !(src[mid + 1] < src[mid])) {
+        std::move(src.begin() + left, src.begin() + right + 1, dst.begin() + left);
+        return;
+    }
+
+    while (i <= mid && j <= right) {
+        if (src[j] < src[i]) {
+            dst[k++] = std::move(src[j++]);
+        } else {
+            dst[k++] = std::move(src[i++]);
+        }
+    }
+    while (i <= mid) {
+        dst[k++] = std::move(src[i++]);
+    }
+    while (j <= right) {
+        dst[k++] = std::move(src[j++]);
+    }
+}
+
+// Bottom-up merge sort of arr[left..right], using buffer[left..right] as scratch space
+// The buffer is allocated once by the caller; each pass merges runs of doubling width
+// from one array into the other (ping-pong), so no pass allocates or copies back.
+template <typename T>
+void mergeSortBottomUp(std::vector<T>& arr, std::vector<T>& buffer, int left, int right) {
+    if (left >= right) {
+        return;
+    }
+
+    // Stable insertion sort of the initial runs
+    for (int runStart = left; runStart <= right; runStart += MERGE_RUN_SIZE) {
+        int runEnd = std::min(runStart + MERGE_RUN_SIZE - 1, right);
+        for (int i = runStart + 1; i <= runEnd; ++i) {
+            T key = std::move(arr[i]);
+            int j = i - 1;
+            while (j >= runStart && key < arr[j]) {
+                arr[j + 1] = std::move(arr[j]);
+                --j;
+            }
+            arr[j + 1] = std::move(key);
+        }
+    }
+
+    std::vector<T>* src = &arr;
+    std::vector<T>* dst = &buffer;
+    for (int width = MERGE_RUN_SIZE; width <= right - left; width *= 2) {
+        for (int lo = left; lo <= right; lo += 2 * width) {
+            int mid = std::min(lo + width - 1, right);
+            int hi = std::min(lo + 2 * width - 1, right);
+            mergeRuns<T>(*src, *dst, lo, mid, hi);
+        }
+        std::swap(src, dst);
+    }
+
+    // An odd number of passes leaves the sorted data in the buffer
+    if (src != &arr) {
+        std::move(buffer.begin() + left, buffer.begin() + right + 1, arr.begin() + left);
+    }
+}
+
+// Public interface
+// Uses the bottom-up engine: one scratch allocation for the whole sort instead of
+// two temporaries per mergeSortedHalves call.
 template <typename T>
 void mergeSortAll(std::vector<T>& arr) {
-    mergeSort<T>(arr, 0, arr.size() - 1);
+    if (arr.size() < 2) {
+        return;
+    }
+    std::vector<T> buffer(arr.size());
+    mergeSortBottomUp<T>(arr, buffer, 0, static_cast<int>(arr.size()) - 1);
 }
 
 // Partition function to place the pivot element in its correct position
@@ -188,27 +267,26 @@ void quickSortAll(std::vector<T>& arr) {
 }
 
 // Function to heapify a subtree rooted with node i which is an index in arr[]
+// Iterative: the root element is held aside and larger children move up into the hole
 template <typename T>
 void heapify(std::vector<T>& arr, int n, int i) {
-    int largest = i; // Initialize largest as root
-    int left = 2 * i + 1; // Left child
-    int right = 2 * i + 2; // Right child
-
-    // If left child is larger than root
-    if (left < n && arr[left] > arr[largest])
-        largest = left;
+    T value = std::move(arr[i]);
+    while (true) {
+        int child = 2 * i + 1; // Left child
+        if (child >= n) break;
 
-    // If right child is larger than largest so far
-    if (right < n && arr[right] > arr[largest])
-        largest = right;
+        // Pick the larger child
+        if (child + 1 < n && arr[child + 1] > arr[child])
+            ++child;
 
-    // If largest is not root
-    if (largest != i) {
-        std::swap(arr[i], arr[largest]);
+        // Root is not smaller than both children: the heap is restored
+        if (!(arr[child] > value))
+            break;
 
-        // Recursively heapify the affected sub-tree
-        heapify<T>(arr, n, largest);
+        arr[i] = std::move(arr[child]);
+        i = child;
     }
+    arr[i] = std::move(value);
 }
 
 // Main function to do heap sort
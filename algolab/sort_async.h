@@ -0,0 +1,422 @@
+#pragma once
+
+#include <vector>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <stop_token>
+#include <utility>
+#include "sort.h"
+#include "introsort.h"
+#include "sort_mt.h"
+#include "thread_pool.h"
+
+namespace algolab {
+
+/**
+ * @brief Asynchronous sorts on a shared executor
+ * @details
+ * introSortAsync, mergeSortAsync and sortAsync start a sort on a ThreadPool and return
+ * at once with a SortFuture, so the calling thread can serve I/O while the pool sorts.
+ * A SortFuture can be waited on like a std::future (wait, wait_for, get) or awaited
+ * from a C++20 coroutine: co_await resumes the coroutine on a pool thread once the
+ * sort has finished, and rethrows its exception if it failed.
+ *
+ * Cancellation is cooperative. requestStop() on the future, or the std::stop_token of
+ * AsyncSortOptions, is polled between units of at most grain elements of work:
+ *  - introSortAsync checks before every partition and every leaf sort,
+ *  - mergeSortAsync before every chunk sort and every slice of a merge level,
+ *  - sortAsync(arr, pool, sorter) runs an arbitrary sorter and only checks before it starts.
+ * A cancelled sort completes with SortCancelled; the vector then holds a permutation
+ * of its input in no particular order.
+ *
+ * Progress is counted in units of work (elements placed by introsort, elements sorted
+ * or merged by merge sort) and reported through AsyncSortOptions::onProgress. Reports
+ * are serialized, increasing, at least progressStep apart, and the last one is
+ * (total, total) for a sort that completed.
+ *
+ * The vector is borrowed: it must outlive the sort and must not be touched until the
+ * future is ready. get() and wait() block the calling thread; a pool task should
+ * co_await the future instead, a blocked worker does not run other tasks.
+ */
+
+namespace sort_async {
+
+// Most elements sorted or merged between two cancellation checks
+constexpr int ASYNC_SORT_GRAIN = 1 << 14;
+
+// Exception a cancelled sort completes with
+class SortCancelled : public std::runtime_error {
+public:
+    SortCancelled() : std::runtime_error("sort cancelled") {}
+};
+
+// Progress callback: units of work done so far out of total
+using ProgressCallback = std::function<void(size_t done, size_t total)>;
+
+struct AsyncSortOptions {
+    std::stop_token stopToken;    // External cancellation, in addition to SortFuture::requestStop()
+    ProgressCallback onProgress;  // Called from pool threads, never concurrently
+    size_t progressStep = 0;      // Least progress between two reports; 0 reports every percent
+    int grain = ASYNC_SORT_GRAIN; // Elements per unit of work between two cancellation checks
+};
+
+namespace detail {
+
+// Shared state of one asynchronous sort, owned by its SortFuture and its running tasks
+class SortState {
+public:
+    SortState(ThreadPool& pool, AsyncSortOptions options) : pool_(pool), options_(std::move(options)) {
+        if (options_.stopToken.stop_possible()) {
+            stopLink_.emplace(options_.stopToken, ForwardStop{&stop_});
+        }
+    }
+
+    ThreadPool& pool() const {
+        return pool_;
+    }
+
+    int grain() const {
+        return std::max(options_.grain, 2);
+    }
+
+    bool stopRequested() const {
+        return stop_.stop_requested();
+    }
+
+    bool requestStop() {
+        return stop_.request_stop();
+    }
+
+    void setTotal(size_t total) {
+        total_ = total;
+        size_t step = options_.progressStep ? options_.progressStep : std::max<size_t>(total / 100, 1);
+        step_ = step;
+        nextReport_.store(step, std::memory_order_relaxed);
+    }
+
+    size_t total() const {
+        return total_;
+    }
+
+    size_t done() const {
+        return done_.load(std::memory_order_acquire);
+    }
+
+    // Adds count units of finished work and reports it when a step has been crossed
+    void advance(size_t count) {
+        size_t now = done_.fetch_add(count, std::memory_order_acq_rel) + count;
+        if (!options_.onProgress) return;
+        if (now < nextReport_.load(std::memory_order_relaxed) && now != total_) return;
+
+        std::scoped_lock lock(progressMutex_);
+        if (now <= reported_) return;
+        reported_ = now;
+        nextReport_.store(now + step_, std::memory_order_relaxed);
+        options_.onProgress(now, total_);
+    }
+
+    // Publishes the outcome and resumes an awaiting coroutine on the pool
+    void finish(std::exception_ptr error) {
+        std::coroutine_handle<> continuation;
+        {
+            std::scoped_lock lock(mutex_);
+            error_ = error;
+            ready_ = true;
+            continuation = std::exchange(continuation_, nullptr);
+        }
+        readyCv_.notify_all();
+        if (continuation) {
+            pool_.submit([continuation]() { continuation.resume(); });
+        }
+    }
+
+    bool ready() const {
+        std::scoped_lock lock(mutex_);
+        return ready_;
+    }
+
+    void wait() const {
+        std::unique_lock lock(mutex_);
+        readyCv_.wait(lock, [this]() { return ready_; });
+    }
+
+    template <typename Rep, typename Period>
+    bool waitFor(const std::chrono::duration<Rep, Period>& timeout) const {
+        std::unique_lock lock(mutex_);
+        return readyCv_.wait_for(lock, timeout, [this]() { return ready_; });
+    }
+
+    void rethrow() const {
+        std::scoped_lock lock(mutex_);
+        if (error_) std::rethrow_exception(error_);
+    }
+
+    // Stores the continuation unless the sort is already over, returns whether it was stored
+    bool suspend(std::coroutine_handle<> continuation) {
+        std::scoped_lock lock(mutex_);
+        if (ready_) return false;
+        continuation_ = continuation;
+        return true;
+    }
+
+private:
+    struct ForwardStop {
+        std::stop_source* source;
+        void operator()() const { source->request_stop(); }
+    };
+
+    ThreadPool& pool_;
+    AsyncSortOptions options_;
+    std::stop_source stop_;
+    std::optional<std::stop_callback<ForwardStop>> stopLink_;
+
+    size_t total_ = 0;
+    size_t step_ = 1;
+    std::atomic<size_t> done_ {0};
+    std::atomic<size_t> nextReport_ {0};
+    std::mutex progressMutex_;
+    size_t reported_ = 0;
+
+    mutable std::mutex mutex_;
+    mutable std::condition_variable readyCv_;
+    bool ready_ = false;
+    std::exception_ptr error_;
+    std::coroutine_handle<> continuation_;
+};
+
+} // namespace detail
+
+/**
+ * @brief SortFuture class
+ * @details Handle on a sort running on a ThreadPool. Copies share the same sort.
+ * At most one coroutine may co_await a given sort.
+ */
+class SortFuture {
+public:
+    explicit SortFuture(std::shared_ptr<detail::SortState> state) : state_(std::move(state)) {}
+
+    bool ready() const {
+        return state_->ready();
+    }
+
+    void wait() const {
+        state_->wait();
+    }
+
+    // Returns true if the sort finished within timeout
+    template <typename Rep, typename Period>
+    bool wait_for(const std::chrono::duration<Rep, Period>& timeout) const {
+        return state_->waitFor(timeout);
+    }
+
+    // Waits, then rethrows the exception of a failed or cancelled (SortCancelled) sort
+    void get() const {
+        state_->wait();
+        state_->rethrow();
+    }
+
+    // Asks the sort to stop at its next check, returns false if a stop was already requested
+    bool requestStop() {
+        return state_->requestStop();
+    }
+
+    size_t progressDone() const {
+        return state_->done();
+    }
+
+    size_t progressTotal() const {
+        return state_->total();
+    }
+
+    auto operator co_await() const {
+        struct Awaiter {
+            std::shared_ptr<detail::SortState> state;
+
+            bool await_ready() const {
+                return state->ready();
+            }
+            bool await_suspend(std::coroutine_handle<> continuation) {
+                return state->suspend(continuation);
+            }
+            void await_resume() const {
+                state->rethrow();
+            }
+        };
+        return Awaiter{state_};
+    }
+
+private:
+    std::shared_ptr<detail::SortState> state_;
+};
+
+namespace detail {
+
+// Runs body(state) as a pool task and completes the future with its outcome
+// The sort counts as cancelled when it stopped before all of its work was done.
+template <typename Body>
+SortFuture launch(ThreadPool& pool, AsyncSortOptions options, size_t total, Body body) {
+    auto state = std::make_shared<SortState>(pool, std::move(options));
+    state->setTotal(total);
+    pool.submit([state, body = std::move(body)]() mutable {
+        try {
+            body(*state);
+            if (state->done() < state->total()) throw SortCancelled();
+            state->finish(nullptr);
+        } catch (...) {
+            state->finish(std::current_exception());
+        }
+    });
+    return SortFuture(std::move(state));
+}
+
+// Parallel introsort that polls the stop flag before every step
+// Every element is counted once: a pivot when it is placed, the others with their leaf.
+template <typename T>
+void cancellableIntrosort(std::vector<T>& arr, int low, int high, int depthLimit, TaskGroup& group, SortState& state) {
+    while (high - low + 1 > state.grain()) {
+        if (state.stopRequested()) return;
+        if (depthLimit == 0) {
+            sort_custom::heapSort(arr, low, high);
+            state.advance(static_cast<size_t>(high - low + 1));
+            return;
+        }
+        --depthLimit;
+
+        int pivotIndex = sort_custom::partition(arr, low, high);
+        state.advance(1);
+        int leftHigh = pivotIndex - 1;
+        group.run([&arr, low, leftHigh, depthLimit, &group, &state]() {
+            cancellableIntrosort(arr, low, leftHigh, depthLimit, group, state);
+        });
+        low = pivotIndex + 1;
+    }
+
+    if (state.stopRequested()) return;
+    if (low < high) {
+        sort_custom::introsort(arr, low, high, depthLimit);
+    }
+    state.advance(static_cast<size_t>(std::max(high - low + 1, 0)));
+}
+
+// One merge level: merges the runs of width elements of src pairwise into dst
+// The output is cut into slices of about grain elements found by merge-path co-ranking.
+// A slice that sees the stop flag moves its inputs unmerged, so dst still ends up
+// holding every element.
+template <typename T>
+void cancellableMergeLevel(T* src, T* dst, int n, int width, TaskGroup& group, SortState& state) {
+    const int grain = state.grain();
+    for (int lo = 0; lo < n; lo += 2 * width) {
+        int mid = std::min(lo + width, n);
+        int hi = std::min(lo + 2 * width, n);
+        T* a = src + lo;
+        T* b = src + mid;
+        int n1 = mid - lo;
+        int n2 = hi - mid;
+        for (int k0 = 0; k0 < n1 + n2; k0 += grain) {
+            int k1 = std::min(k0 + grain, n1 + n2);
+            group.run([=, &state]() {
+                int i0 = sort_mt::coRank(k0, a, n1, b, n2);
+                int i1 = sort_mt::coRank(k1, a, n1, b, n2);
+                T* out = dst + lo + k0;
+                if (state.stopRequested()) {
+                    out = std::move(a + i0, a + i1, out);
+                    std::move(b + (k0 - i0), b + (k1 - i1), out);
+                    return;
+                }
+                sort_mt::mergeInto(a + i0, i1 - i0, b + (k0 - i0), (k1 - i1) - (k0 - i0), out);
+                state.advance(static_cast<size_t>(k1 - k0));
+            });
+        }
+    }
+    group.wait();
+}
+
+} // namespace detail
+
+// Starts a parallel introsort of arr on pool
+// Progress counts the elements in their final position, out of arr.size().
+template <typename T>
+SortFuture introSortAsync(std::vector<T>& arr, ThreadPool& pool, AsyncSortOptions options = {}) {
+    return detail::launch(pool, std::move(options), arr.size(), [&arr](detail::SortState& state) {
+        int n = static_cast<int>(arr.size());
+        if (n == 0) return;
+
+        TaskGroup group(state.pool());
+        int depthLimit = 2 * static_cast<int>(std::log2(n));
+        detail::cancellableIntrosort(arr, 0, n - 1, depthLimit, group, state);
+        group.wait();
+    });
+}
+
+template <typename T>
+SortFuture introSortAsync(std::vector<T>& arr, AsyncSortOptions options = {}) {
+    return introSortAsync(arr, ThreadPool::shared(), std::move(options));
+}
+
+// Starts a parallel stable merge sort of arr on pool
+// Chunks of grain elements are sorted by bottom-up merge sort, then merged level by
+// level. Progress counts the elements sorted or merged, out of arr.size() per level.
+template <typename T>
+SortFuture mergeSortAsync(std::vector<T>& arr, ThreadPool& pool, AsyncSortOptions options = {}) {
+    const int n = static_cast<int>(arr.size());
+    const int grain = std::max(options.grain, 2);
+    size_t levels = 0;
+    for (long long width = grain; width < n; width *= 2) ++levels;
+
+    return detail::launch(pool, std::move(options), arr.size() * (levels + 1), [&arr, n, grain](detail::SortState& state) {
+        if (n == 0) return;
+
+        std::vector<T> buffer(n);
+        TaskGroup group(state.pool());
+        for (int lo = 0; lo < n; lo += grain) {
+            int hi = std::min(lo + grain, n) - 1;
+            group.run([&arr, &buffer, &state, lo, hi]() {
+                if (state.stopRequested()) return;
+                mergeSortBottomUp(arr, buffer, lo, hi);
+                state.advance(static_cast<size_t>(hi - lo + 1));
+            });
+        }
+        group.wait();
+
+        T* src = arr.data();
+        T* dst = buffer.data();
+        for (long long width = grain; width < n && !state.stopRequested(); width *= 2) {
+            detail::cancellableMergeLevel(src, dst, n, static_cast<int>(width), group, state);
+            std::swap(src, dst);
+        }
+        if (src != arr.data()) {
+            std::move(buffer.begin(), buffer.end(), arr.begin());
+        }
+    });
+}
+
+template <typename T>
+SortFuture mergeSortAsync(std::vector<T>& arr, AsyncSortOptions options = {}) {
+    return mergeSortAsync(arr, ThreadPool::shared(), std::move(options));
+}
+
+// Starts sorter(arr) as one pool task, e.g. sortAsync(arr, pool, [](auto& v) { algolab::sort(v); })
+// The sorter is not interrupted: a stop only takes effect if requested before it starts.
+template <typename T, typename Sorter>
+SortFuture sortAsync(std::vector<T>& arr, ThreadPool& pool, Sorter sorter, AsyncSortOptions options = {}) {
+    return detail::launch(pool, std::move(options), arr.size(), [&arr, sorter = std::move(sorter)](detail::SortState& state) mutable {
+        if (state.stopRequested()) return;
+        sorter(arr);
+        state.advance(arr.size());
+    });
+}
+
+} // namespace sort_async
+
+} // namespace algolab
@@ -0,0 +1 @@
+#include "sort_dispatch.h"
@@ -0,0 +1,408 @@
+#pragma once
+
+#include <vector>
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include "sort.h"
+#include "introsort.h"
+#include "pdqsort.h"
+#include "timsort.h"
+#include "radix_sort.h"
+#include "counting_sort.h"
+#include "simd_network.h"
+#include "string_sort.h"
+#include "sort_mt.h"
+#include "thread_pool.h"
+
+namespace algolab {
+
+/**
+ * @brief Adaptive sort dispatcher with calibrated thresholds
+ * @details
+ * algolab::sort(arr) picks the sort for the call instead of the caller, from the
+ * element type, the size, a presortedness probe and the number of pool threads:
+ *  - up to networkMax elements with a SIMD network (int, float, double), up to
+ *    insertionMax elements by insertion sort,
+ *  - inputs whose sampled neighbours are almost all in order (or all reversed) by
+ *    Timsort, which finds the runs and merges them in O(n) when there are few,
+ *  - from parallelMin elements, when the pool has more than one thread, by parallel
+ *    sample sort,
+ *  - arithmetic types from radixMin elements by LSD radix sort, or by counting sort
+ *    when integral keys span a small range, std::string and std::string_view from
+ *    stringRadixMin elements by MSD string radix sort,
+ *  - anything else by pdqsort.
+ * The crossover points live in SortThresholds. The defaults are reasonable on a
+ * current x86-64 core; calibrateSortThresholds() measures them on the running
+ * machine, and saveSortThresholds / loadSortThresholds persist them as a small
+ * "key = value" text file, so a deployment calibrates once and loads the file at
+ * start-up (loadOrCalibrateSortThresholds does both).
+ * The sort is not stable, and equal elements may end up in any order.
+ */
+
+// Crossover points of the dispatcher (sizes in elements)
+// A size threshold of SORT_NEVER disables its path.
+constexpr size_t SORT_NEVER = std::numeric_limits<size_t>::max();
+
+struct SortThresholds {
+    size_t networkMax = sort_simd::NETWORK_SIZE;         // SIMD network up to this size, at most NETWORK_SIZE
+    size_t insertionMax = sort_custom::INTROSORT_INSERTION_THRESHOLD; // Insertion sort up to this size
+    size_t radixMin = 1024;                              // LSD radix sort of arithmetic keys from this size
+    size_t stringRadixMin = 256;                         // String radix sort from this size
+    size_t parallelMin = size_t(1) << 17;                // Parallel sample sort from this size
+    double presortedMaxDescents = 1.0 / 32;              // Timsort when at most this share of probes descend
+
+    bool operator==(const SortThresholds&) const = default;
+};
+
+enum class SortAlgorithm {
+    None,        // Fewer than two elements
+    Network,     // sort_simd::sortSmall
+    Insertion,   // sort_custom::insertionSort
+    Tim,         // sort_custom::timSortAll
+    Pdq,         // sort_custom::pdqSortAll
+    Radix,       // sort_count::tryCountingSort, else sort_radix::radixSortAll
+    StringRadix, // sort_string::stringRadixSortAll
+    Parallel,    // sort_mt::sampleSortOn
+};
+
+// Neighbouring pairs compared by the presortedness probe
+constexpr size_t SORT_PROBE_SAMPLES = 64;
+
+namespace detail {
+
+template <typename T>
+constexpr bool radixSortable = std::is_arithmetic_v<T> && !std::is_same_v<T, bool>;
+
+template <typename T>
+constexpr bool stringSortable = std::is_same_v<T, std::string> || std::is_same_v<T, std::string_view>;
+
+// Thresholds used by algolab::sort, shared by every thread of the process
+inline SortThresholds& activeThresholds() {
+    static SortThresholds thresholds;
+    return thresholds;
+}
+
+} // namespace detail
+
+/**
+ * @brief Cheap presortedness probe
+ * @details Compares SORT_PROBE_SAMPLES neighbouring pairs spread evenly over arr and
+ * returns the share of descending pairs among the unequal ones: 0 for sorted and
+ * nearly sorted inputs (and when all sampled pairs are equal), about 0.5 for random
+ * ones and 1 for reversed ones, duplicates or not.
+ */
+template <typename T>
+double descentRatio(const std::vector<T>& arr) {
+    const size_t n = arr.size();
+    if (n < 2) return 0.0;
+    const size_t samples = std::min(SORT_PROBE_SAMPLES, n - 1);
+    size_t descents = 0;
+    size_t ascents = 0;
+    for (size_t s = 0; s < samples; ++s) {
+        size_t i = 1 + s * (n - 1) / samples;
+        descents += arr[i] < arr[i - 1];
+        ascents += arr[i - 1] < arr[i];
+    }
+    if (descents + ascents == 0) return 0.0;
+    return static_cast<double>(descents) / static_cast<double>(descents + ascents);
+}
+
+// The algorithm algolab::sort runs for arr with threads pool threads
+template <typename T>
+SortAlgorithm chooseSortAlgorithm(const std::vector<T>& arr, unsigned threads, const SortThresholds& thresholds) {
+    const size_t n = arr.size();
+    if (n < 2) return SortAlgorithm::None;
+    if constexpr (sort_simd::hasNetwork<T>) {
+        // The network sorts a padded copy of NETWORK_SIZE elements, never more
+        if (n <= std::min(thresholds.networkMax, size_t(sort_simd::NETWORK_SIZE))) return SortAlgorithm::Network;
+    }
+    if (n <= thresholds.insertionMax) return SortAlgorithm::Insertion;
+
+    double descents = descentRatio(arr);
+    if (descents <= thresholds.presortedMaxDescents || descents >= 1.0 - thresholds.presortedMaxDescents) {
+        return SortAlgorithm::Tim;
+    }
+    if (threads > 1 && n >= thresholds.parallelMin && n <= size_t(std::numeric_limits<int>::max())) {
+        return SortAlgorithm::Parallel;
+    }
+    if constexpr (detail::radixSortable<T>) {
+        if (n >= thresholds.radixMin) return SortAlgorithm::Radix;
+    } else if constexpr (detail::stringSortable<T>) {
+        if (n >= thresholds.stringRadixMin) return SortAlgorithm::StringRadix;
+    }
+    return SortAlgorithm::Pdq;
+}
+
+// Sorts arr with the given algorithm (Parallel runs on pool)
+template <typename T>
+void sortWith(std::vector<T>& arr, SortAlgorithm algorithm, ThreadPool& pool) {
+    switch (algorithm) {
+    case SortAlgorithm::None:
+        break;
+    case SortAlgorithm::Network:
+        if constexpr (sort_simd::hasNetwork<T>) {
+            sort_simd::sortSmall(arr.data(), static_cast<int>(arr.size()));
+            break;
+        }
+        [[fallthrough]];
+    case SortAlgorithm::Insertion:
+        sort_custom::insertionSort(arr, 0, static_cast<int>(arr.size()) - 1);
+        break;
+    case SortAlgorithm::Tim:
+        sort_custom::timSortAll(arr);
+        break;
+    case SortAlgorithm::Parallel:
+        sort_mt::sampleSortOn(arr, pool);
+        break;
+    case SortAlgorithm::Radix:
+        if constexpr (detail::radixSortable<T>) {
+            if constexpr (sort_count::countingSortable<T>) {
+                if (sort_count::tryCountingSort(arr)) break;
+            }
+            sort_radix::radixSortAll(arr);
+            break;
+        }
+        [[fallthrough]];
+    case SortAlgorithm::StringRadix:
+        if constexpr (detail::stringSortable<T>) {
+            sort_string::stringRadixSortAll(arr);
+            break;
+        }
+        [[fallthrough]];
+    case SortAlgorithm::Pdq:
+        sort_custom::pdqSortAll(arr);
+        break;
+    }
+}
+
+// Sorts arr on pool with explicit thresholds
+template <typename T>
+void sortOn(std::vector<T>& arr, ThreadPool& pool, const SortThresholds& thresholds) {
+    sortWith(arr, chooseSortAlgorithm(arr, pool.size(), thresholds), pool);
+}
+
+// Public interface: sorts arr with the algorithm chosen under the active thresholds
+template <typename T>
+void sort(std::vector<T>& arr) {
+    sortOn(arr, ThreadPool::shared(), detail::activeThresholds());
+}
+
+// Thresholds algolab::sort currently uses
+inline const SortThresholds& sortThresholds() {
+    return detail::activeThresholds();
+}
+
+// Replaces the thresholds of algolab::sort; not synchronised with sorts running meanwhile,
+// call it at start-up. networkMax is clamped to sort_simd::NETWORK_SIZE.
+inline void setSortThresholds(const SortThresholds& thresholds) {
+    detail::activeThresholds() = thresholds;
+    detail::activeThresholds().networkMax = std::min(thresholds.networkMax, size_t(sort_simd::NETWORK_SIZE));
+}
+
+inline void saveSortThresholds(const SortThresholds& thresholds, const std::filesystem::path& path) {
+    std::ofstream out(path, std::ios::trunc);
+    if (!out) throw std::runtime_error("saveSortThresholds: cannot create " + path.string());
+    out << "# algolab sort thresholds\n"
+        << "networkMax = " << thresholds.networkMax << "\n"
+        << "insertionMax = " << thresholds.insertionMax << "\n"
+        << "radixMin = " << thresholds.radixMin << "\n"
+        << "stringRadixMin = " << thresholds.stringRadixMin << "\n"
+        << "parallelMin = " << thresholds.parallelMin << "\n"
+        << "presortedMaxDescents = " << std::setprecision(std::numeric_limits<double>::max_digits10)
+        << thresholds.presortedMaxDescents << "\n";
+    if (!out) throw std::runtime_error("saveSortThresholds: write failed");
+}
+
+// Reads a file written by saveSortThresholds; keys missing from it keep their defaults
+// A networkMax above sort_simd::NETWORK_SIZE is rejected.
+inline SortThresholds loadSortThresholds(const std::filesystem::path& path) {
+    std::ifstream in(path);
+    if (!in) throw std::runtime_error("loadSortThresholds: cannot open " + path.string());
+
+    SortThresholds thresholds;
+    std::string line;
+    while (std::getline(in, line)) {
+        if (line.empty() || line[0] == '#') continue;
+        size_t eq = line.find('=');
+        if (eq == std::string::npos) throw std::invalid_argument("loadSortThresholds: malformed line: " + line);
+        std::string key = line.substr(0, line.find_last_not_of(' ', eq - 1) + 1);
+        std::string value = line.substr(eq + 1);
+        try {
+            if (key == "networkMax") {
+                thresholds.networkMax = std::stoull(value);
+            } else if (key == "insertionMax") {
+                thresholds.insertionMax = std::stoull(value);
+            } else if (key == "radixMin") {
+                thresholds.radixMin = std::stoull(value);
+            } else if (key == "stringRadixMin") {
+                thresholds.stringRadixMin = std::stoull(value);
+            } else if (key == "parallelMin") {
+                thresholds.parallelMin = std::stoull(value);
+            } else if (key == "presortedMaxDescents") {
+                thresholds.presortedMaxDescents = std::stod(value);
+            } else {
+                throw std::invalid_argument("loadSortThresholds: unknown key " + key);
+            }
+        } catch (const std::logic_error&) {
+            throw std::invalid_argument("loadSortThresholds: bad value on line: " + line);
+        }
+    }
+    if (thresholds.networkMax > size_t(sort_simd::NETWORK_SIZE)) {
+        throw std::invalid_argument("loadSortThresholds: networkMax above " + std::to_string(sort_simd::NETWORK_SIZE));
+    }
+    return thresholds;
+}
+
+namespace detail {
+
+// Elements sorted per timing sample; small sizes sort many arrays to reach it
+constexpr size_t CALIBRATION_ELEMENTS = size_t(1) << 16;
+
+// Median time in ns of sorting copies of inputs with sortFunc; the copies are made
+// before the clock starts
+template <typename T, typename Sort>
+double medianSortNs(const std::vector<std::vector<T>>& inputs, Sort sortFunc, int repetitions) {
+    std::vector<double> times;
+    for (int r = 0; r < repetitions; ++r) {
+        auto work = inputs;
+        auto start = std::chrono::steady_clock::now();
+        for (auto& arr : work) sortFunc(arr);
+        auto end = std::chrono::steady_clock::now();
+        times.push_back(std::chrono::duration<double, std::nano>(end - start).count());
+    }
+    std::nth_element(times.begin(), times.begin() + times.size() / 2, times.end());
+    return times[times.size() / 2];
+}
+
+// max(1, CALIBRATION_ELEMENTS / n) arrays of n elements made by make(n, rng)
+template <typename Make>
+auto calibrationInputs(size_t n, Make make, std::mt19937_64& rng) {
+    std::vector<decltype(make(n, rng))> inputs(std::max<size_t>(1, CALIBRATION_ELEMENTS / n));
+    for (auto& arr : inputs) arr = make(n, rng);
+    return inputs;
+}
+
+// Smallest size of the ascending ladder from which candidate beats baseline at every
+// larger size too, or SORT_NEVER. With fromBelow the test runs the other way round:
+// the largest size up to which candidate wins at every smaller size, 0 if none.
+template <typename Make, typename Candidate, typename Baseline>
+size_t crossover(const std::vector<size_t>& ladder, Make make, Candidate candidate, Baseline baseline, int repetitions,
+                 bool fromBelow, std::mt19937_64& rng) {
+    std::vector<bool> wins;
+    for (size_t n : ladder) {
+        auto inputs = calibrationInputs(n, make, rng);
+        wins.push_back(medianSortNs(inputs, candidate, repetitions) < medianSortNs(inputs, baseline, repetitions));
+    }
+    if (fromBelow) {
+        size_t result = 0;
+        for (size_t i = 0; i < ladder.size() && wins[i]; ++i) result = ladder[i];
+        return result;
+    }
+    size_t result = SORT_NEVER;
+    for (size_t i = ladder.size(); i-- > 0 && wins[i];) result = ladder[i];
+    return result;
+}
+
+} // namespace detail
+
+/**
+ * @brief Measures the dispatcher crossover points on this machine
+ * @details Times each path against pdqsort on a ladder of sizes (median of
+ * repetitions runs): insertion sort and radix sort on random int, string radix on
+ * random 16-letter strings, parallel sample sort on random int with pool (skipped
+ * when it has a single thread), and Timsort on 64K int arrays of increasing
+ * disorder for presortedMaxDescents. Integer thresholds apply to every arithmetic
+ * type. Takes about a second.
+ */
+inline SortThresholds calibrateSortThresholds(ThreadPool& pool = ThreadPool::shared(), int repetitions = 3) {
+    SortThresholds thresholds;
+    // Not measured: the network always wins up to its size and cannot sort more
+    thresholds.networkMax = sort_simd::NETWORK_SIZE;
+    std::mt19937_64 rng(2026);
+    auto pdq = [](auto& arr) { sort_custom::pdqSortAll(arr); };
+    auto randomInts = [](size_t n, std::mt19937_64& gen) {
+        std::vector<int> arr(n);
+        for (auto& v : arr) v = static_cast<int>(gen());
+        return arr;
+    };
+
+    thresholds.insertionMax = detail::crossover(
+        {4, 8, 12, 16, 24, 32, 48, 64}, randomInts,
+        [](std::vector<int>& arr) { sort_custom::insertionSort(arr, 0, static_cast<int>(arr.size()) - 1); }, pdq,
+        repetitions, true, rng);
+
+    thresholds.radixMin = detail::crossover(
+        {64, 128, 256, 512, 1024, 2048, 4096, 8192, 16384, 32768, 65536}, randomInts,
+        [](std::vector<int>& arr) { sort_radix::radixSortAll(arr); }, pdq, repetitions, false, rng);
+
+    auto randomWords = [](size_t n, std::mt19937_64& gen) {
+        std::vector<std::string> arr(n);
+        for (auto& s : arr) {
+            for (int i = 0; i < 16; ++i) s.push_back(static_cast<char>('a' + gen() % 26));
+        }
+        return arr;
+    };
+    thresholds.stringRadixMin = detail::crossover(
+        {64, 128, 256, 512, 1024, 2048, 4096, 8192, 16384}, randomWords,
+        [](std::vector<std::string>& arr) { sort_string::stringRadixSortAll(arr); }, pdq, repetitions, false, rng);
+
+    // Against radix sort, the sequential path large int arrays would take otherwise
+    thresholds.parallelMin = SORT_NEVER;
+    if (pool.size() > 1) {
+        thresholds.parallelMin = detail::crossover(
+            {size_t(1) << 14, size_t(1) << 15, size_t(1) << 16, size_t(1) << 17, size_t(1) << 18, size_t(1) << 19,
+             size_t(1) << 20},
+            randomInts, [&pool](std::vector<int>& arr) { sort_mt::sampleSortOn(arr, pool); },
+            [](std::vector<int>& arr) { sort_radix::radixSortAll(arr); }, repetitions, false, rng);
+    }
+
+    // Sorted 64K arrays with a growing share of elements overwritten at random positions
+    thresholds.presortedMaxDescents = 0.0;
+    for (double disorder : {1.0 / 256, 1.0 / 128, 1.0 / 64, 1.0 / 32, 1.0 / 16, 1.0 / 8}) {
+        auto nearlySorted = [disorder](size_t n, std::mt19937_64& gen) {
+            std::vector<int> arr(n);
+            for (size_t i = 0; i < n; ++i) arr[i] = static_cast<int>(i);
+            for (size_t k = 0; k < static_cast<size_t>(disorder * n); ++k) arr[gen() % n] = static_cast<int>(gen() % n);
+            return arr;
+        };
+        auto inputs = detail::calibrationInputs(detail::CALIBRATION_ELEMENTS, nearlySorted, rng);
+        auto tim = [](std::vector<int>& arr) { sort_custom::timSortAll(arr); };
+        if (detail::medianSortNs(inputs, tim, repetitions) >= detail::medianSortNs(inputs, pdq, repetitions)) break;
+        const auto& arr = inputs.front();
+        size_t descents = 0;
+        size_t ascents = 0;
+        for (size_t i = 1; i < arr.size(); ++i) {
+            descents += arr[i] < arr[i - 1];
+            ascents += arr[i - 1] < arr[i];
+        }
+        thresholds.presortedMaxDescents = static_cast<double>(descents) / static_cast<double>(descents + ascents);
+    }
+    return thresholds;
+}
+
+// Loads the thresholds saved at path, or calibrates and saves them when there are none,
+// and makes them the active thresholds of algolab::sort
+inline SortThresholds loadOrCalibrateSortThresholds(const std::filesystem::path& path) {
+    SortThresholds thresholds;
+    if (std::filesystem::exists(path)) {
+        thresholds = loadSortThresholds(path);
+    } else {
+        thresholds = calibrateSortThresholds();
+        saveSortThresholds(thresholds, path);
+    }
+    setSortThresholds(thresholds);
+    return thresholds;
+}
+
+} // namespace algolab
@@ -3,6 +3,7 @@
 #include <vector>
 #include <stack>
 #include <iostream>
+#include "block_partition.h"
 
 // Avoids deep recursion and stack overflow issues
 // Better performance on large datasets by preventing function call overhead
@@ -37,7 +38,8 @@ int partition(std::vector<T>& arr, int low, int high) {
 }
 
 // Iterative Quick Sort function
-template <typename T>
+// Scheme selects the Lomuto partition above (Classic) or branchless block partitioning (Block)
+template <typename T, PartitionScheme Scheme = PartitionScheme::Classic>
 void quickSortAll(std::vector<T>& arr) {
     if (arr.empty()) return;
 
@@ -51,10 +53,22 @@ void quickSortAll(std::vector<T>& arr) {
         stack.pop_back();
 
         if (low < high) {
-            int pivotIndex = partition(arr, low, high);
+            int pivotIndex;
+            bool equalLeft = false;
+            if constexpr (Scheme == PartitionScheme::Block) {
+                // The block partitioner needs a median-of-three, two elements are simply ordered
+                if (high - low == 1) {
+                    if (arr[high] < arr[low]) std::swap(arr[low], arr[high]);
+                    continue;
+                }
+                // Ranges are bounded by previous pivots: arr[low - 1] is one unless low is 0
+                pivotIndex = blockPartition(arr, low, high, low == 0, equalLeft);
+            } else {
+                pivotIndex = partition(arr, low, high);
+            }
 
-            // Push left subarray
-            if (pivotIndex - 1 > low) {
+            // Push left subarray, unless it only holds keys equal to the pivot
+            if (!equalLeft && pivotIndex - 1 > low) {
                 stack.push_back({low, pivotIndex - 1});
             }
             // Push right subarray
@@ -0,0 +1,411 @@
+#pragma once
+
+#include <vector>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <algorithm>
+#include <random>
+#include "sort.h"
+#include "introsort.h"
+#include "thread_pool.h"
+
+namespace algolab {
+
+/**
+ * @brief Multi-threaded sorting algorithms
+ * @details
+ * The parallel sorts run on a work-stealing ThreadPool (ThreadPool::shared() by default).
+ * Partitions produced by sort_custom::partition are handed out as tasks: the calling
+ * task keeps one side and publishes the other one, which idle workers steal.
+ * Below PARALLEL_CUTOFF elements a partition is sorted sequentially with
+ * sort_custom::introsort, task overhead would dominate otherwise.
+ *
+ * The stable merge sort forks both halves and also splits every merge evenly
+ * across tasks with merge-path co-ranking, so the top-level O(n) merge is no
+ * longer a serial bottleneck.
+ *
+ * Sample sort avoids the serial top-level partition altogether: splitters taken
+ * from an oversampled random sample cut the input into up to SAMPLE_SORT_MAX_BUCKETS
+ * buckets at once. Blocks of the input are classified in parallel through a
+ * branchless search tree of splitters, each block counts its own bucket histogram,
+ * and the blocks then scatter their elements to disjoint slots of a buffer before
+ * the buckets are sorted as independent tasks. Splitters repeated in the sample
+ * get an equality bucket of their own, which needs no sorting.
+ * Reference: Sanders & Winkel, "Super Scalar Sample Sort" (ESA 2004).
+ */
+
+namespace sort_mt {
+
+// Partitions smaller than this are not split any further across threads
+constexpr int PARALLEL_CUTOFF = 1 << 14;
+
+// Parallel introsort core logic
+// Loops on the right side and spawns the left one, so each task only holds one
+// stack frame per partitioning level. Ranges of up to INTROSORT_INSERTION_THRESHOLD
+// elements go to introsort whatever the cutoff: partition needs its median-of-three
+// sentinels.
+template <typename T>
+void parallelIntrosort(std::vector<T>& arr, int low, int high, int depthLimit, TaskGroup& group, int cutoff) {
+    while (high - low > std::max(cutoff, sort_custom::INTROSORT_INSERTION_THRESHOLD)) {
+        if (depthLimit == 0) {
+            sort_custom::heapSort(arr, low, high);
+            return;
+        }
+        --depthLimit;
+
+        int pivotIndex = sort_custom::partition(arr, low, high);
+        int leftHigh = pivotIndex - 1;
+        group.run([&arr, low, leftHigh, depthLimit, &group, cutoff]() {
+            parallelIntrosort(arr, low, leftHigh, depthLimit, group, cutoff);
+        });
+        low = pivotIndex + 1;
+    }
+
+    if (low < high) {
+        sort_custom::introsort(arr, low, high, depthLimit);
+    }
+}
+
+// Sorts arr on the given pool, partitions of at most cutoff elements stay sequential
+template <typename T>
+void introSortOn(std::vector<T>& arr, ThreadPool& pool, int cutoff = PARALLEL_CUTOFF) {
+    int n = static_cast<int>(arr.size());
+    if (n < 2) return;
+
+    int depthLimit = 2 * static_cast<int>(std::log2(n));
+    if (n <= cutoff) {
+        sort_custom::introsort(arr, 0, n - 1, depthLimit);
+        return;
+    }
+
+    TaskGroup group(pool);
+    parallelIntrosort(arr, 0, n - 1, depthLimit, group, cutoff);
+    group.wait();
+}
+
+// Public interface
+template <typename T>
+void introSortAll(std::vector<T>& arr) {
+    introSortOn(arr, ThreadPool::shared());
+}
+
+// Parallel quicksort: same task splitting as introSortAll but without the depth
+// limit, so adversarial inputs are not protected by the HeapSort fallback.
+template <typename T>
+void quickSortAll(std::vector<T>& arr) {
+    int n = static_cast<int>(arr.size());
+    if (n < 2) return;
+
+    TaskGroup group(ThreadPool::shared());
+    parallelIntrosort(arr, 0, n - 1, std::numeric_limits<int>::max(), group, PARALLEL_CUTOFF);
+    group.wait();
+}
+
+// Target number of sample sort buckets per pool thread, for load balance
+constexpr int SAMPLE_SORT_BUCKETS_PER_THREAD = 8;
+// Upper bound of the splitter tree size (buckets); must be a power of two
+constexpr int SAMPLE_SORT_MAX_BUCKETS = 256;
+// Sample elements drawn per bucket to place the splitters
+constexpr int SAMPLE_SORT_OVERSAMPLING = 16;
+
+/**
+ * @brief SplitterTree class
+ * @details Implicit binary search tree over the sorted splitters (Eytzinger layout:
+ * node i has children 2i and 2i + 1), so classifying an element is log2(buckets)
+ * steps of i = 2i + (tree[i] < x) without any branch on the comparison result.
+ * With distinct splitters s[0..buckets - 1), bucket b holds the elements x with
+ * s[b - 1] < x <= s[b]. When the sample contained duplicate splitters,
+ * elements equal to s[b] are sent to an equality bucket 2b + 1 instead.
+ */
+template <typename T>
+class SplitterTree {
+public:
+    // splitters: sorted, distinct, fewer than SAMPLE_SORT_MAX_BUCKETS elements
+    SplitterTree(const std::vector<T>& splitters, bool equalityBuckets)
+        : buckets_(static_cast<int>(std::bit_ceil(splitters.size() + 1))),
+          levels_(std::countr_zero(static_cast<unsigned>(buckets_))),
+          equalityBuckets_(equalityBuckets),
+          tree_(buckets_),
+          upper_(splitters) {
+        // Pad with the largest splitter: the buckets between equal padding splitters stay empty
+        upper_.resize(buckets_ - 1, splitters.back());
+        fill(1, 0);
+        // The last bucket has no upper splitter, comparing against the largest never marks it equal
+        upper_.push_back(splitters.back());
+    }
+
+    // Number of bucket ids, including the equality buckets
+    int bucketCount() const {
+        return equalityBuckets_ ? 2 * buckets_ : buckets_;
+    }
+
+    bool isEqualityBucket(int id) const {
+        return equalityBuckets_ && (id & 1);
+    }
+
+    int classify(const T& x) const {
+        int i = 1;
+        for (int level = 0; level < levels_; ++level) {
+            i = 2 * i + static_cast<int>(tree_[i] < x);
+        }
+        int bucket = i - buckets_;
+        if (!equalityBuckets_) return bucket;
+        int equal = static_cast<int>(bucket < buckets_ - 1) & static_cast<int>(!(x < upper_[bucket]));
+        return 2 * bucket + equal;
+    }
+
+private:
+    // In-order fill of the subtree rooted at node from the sorted splitters
+    int fill(int node, int next) {
+        if (node >= buckets_) return next;
+        next = fill(2 * node, next);
+        tree_[node] = upper_[next++];
+        return fill(2 * node + 1, next);
+    }
+
+    int buckets_;
+    int levels_;
+    bool equalityBuckets_;
+    std::vector<T> tree_;
+    std::vector<T> upper_;
+};
+
+// Sorts arr on the given pool with a parallel sample sort
+// Inputs of at most cutoff elements are sorted sequentially with sort_custom::introsort;
+// buckets above cutoff are split further with the parallel introsort.
+template <typename T>
+void sampleSortOn(std::vector<T>& arr, ThreadPool& pool, int cutoff = PARALLEL_CUTOFF) {
+    int n = static_cast<int>(arr.size());
+    if (n < 2) return;
+
+    int depthLimit = 2 * static_cast<int>(std::log2(n));
+    if (n <= cutoff) {
+        sort_custom::introsort(arr, 0, n - 1, depthLimit);
+        return;
+    }
+
+    // Bucket count: a few buckets per thread, at least ~cutoff / 4 elements per bucket
+    int threads = static_cast<int>(pool.size());
+    int wanted = std::min({SAMPLE_SORT_MAX_BUCKETS, threads * SAMPLE_SORT_BUCKETS_PER_THREAD,
+                           std::max(2, n / std::max(1, cutoff / 4))});
+    int buckets = static_cast<int>(std::bit_floor(static_cast<unsigned>(std::max(2, wanted))));
+
+    // Oversampled random sample, sorted; every SAMPLE_SORT_OVERSAMPLING-th element is a splitter
+    std::minstd_rand rng(static_cast<unsigned>(n));
+    std::uniform_int_distribution<int> pick(0, n - 1);
+    std::vector<T> sample;
+    sample.reserve(buckets * SAMPLE_SORT_OVERSAMPLING);
+    for (int i = 0; i < buckets * SAMPLE_SORT_OVERSAMPLING; ++i) {
+        sample.push_back(arr[pick(rng)]);
+    }
+    sort_custom::introSortAll(sample);
+
+    std::vector<T> splitters;
+    splitters.reserve(buckets - 1);
+    for (int b = 1; b < buckets; ++b) {
+        splitters.push_back(sample[b * SAMPLE_SORT_OVERSAMPLING - 1]);
+    }
+    size_t drawn = splitters.size();
+    splitters.erase(std::unique(splitters.begin(), splitters.end(),
+                                [](const T& a, const T& b) { return !(a < b) && !(b < a); }),
+                    splitters.end());
+    const SplitterTree<T> tree(splitters, splitters.size() < drawn);
+    const int ids = tree.bucketCount();
+
+    // Blocks classified and scattered by one task each
+    const int blocks = std::max(1, std::min(threads * 4, n / std::max(1, cutoff / 4)));
+    auto blockBegin = [n, blocks](int block) {
+        return static_cast<int>(static_cast<long long>(n) * block / blocks);
+    };
+
+    // Pass 1: bucket id of every element and a histogram per block
+    std::vector<uint16_t> oracle(n);
+    std::vector<int> counts(static_cast<size_t>(blocks) * ids, 0);
+    {
+        TaskGroup group(pool);
+        for (int block = 0; block < blocks; ++block) {
+            group.run([&, block]() {
+                int* histogram = counts.data() + static_cast<size_t>(block) * ids;
+                for (int i = blockBegin(block), end = blockBegin(block + 1); i < end; ++i) {
+                    int id = tree.classify(arr[i]);
+                    oracle[i] = static_cast<uint16_t>(id);
+                    ++histogram[id];
+                }
+            });
+        }
+        group.wait();
+    }
+
+    // Exclusive prefix sums in bucket-major order: block b writes bucket id from offsets[b][id]
+    std::vector<int> bucketStart(ids + 1, 0);
+    {
+        int sum = 0;
+        for (int id = 0; id < ids; ++id) {
+            bucketStart[id] = sum;
+            for (int block = 0; block < blocks; ++block) {
+                int& count = counts[static_cast<size_t>(block) * ids + id];
+                int blockCount = count;
+                count = sum;
+                sum += blockCount;
+            }
+        }
+        bucketStart[ids] = sum;
+    }
+
+    // Pass 2: every block moves its elements to its own slots of each bucket
+    std::vector<T> buffer(n);
+    {
+        TaskGroup group(pool);
+        for (int block = 0; block < blocks; ++block) {
+            group.run([&, block]() {
+                int* offsets = counts.data() + static_cast<size_t>(block) * ids;
+                for (int i = blockBegin(block), end = blockBegin(block + 1); i < end; ++i) {
+                    buffer[offsets[oracle[i]]++] = std::move(arr[i]);
+                }
+            });
+        }
+        group.wait();
+    }
+
+    // Pass 3: buckets move back and are sorted concurrently, large ones split further
+    TaskGroup group(pool);
+    for (int id = 0; id < ids; ++id) {
+        int low = bucketStart[id];
+        int high = bucketStart[id + 1] - 1;
+        if (low > high) continue;
+        bool sorted = tree.isEqualityBucket(id);
+        group.run([&arr, &buffer, &group, low, high, sorted, depthLimit, cutoff]() {
+            std::move(buffer.begin() + low, buffer.begin() + high + 1, arr.begin() + low);
+            if (!sorted && low < high) {
+                parallelIntrosort(arr, low, high, depthLimit, group, cutoff);
+            }
+        });
+    }
+    group.wait();
+}
+
+// Public interface
+template <typename T>
+void sampleSortAll(std::vector<T>& arr) {
+    sampleSortOn(arr, ThreadPool::shared());
+}
+
+// Merge-path co-ranking
+// Returns how many of the first k elements of the stable merge of a[0..n1) and
+// b[0..n2) come from a. On ties elements of a go first, which keeps the merge stable.
+template <typename T>
+int coRank(int k, const T* a, int n1, const T* b, int n2) {
+    int low = std::max(0, k - n2);
+    int high = std::min(k, n1);
+    while (low < high) {
+        int i = low + (high - low) / 2;
+        int j = k - i;
+        // a[i] must be output before b[j - 1]: take more elements from a
+        if (j > 0 && !(b[j - 1] < a[i])) {
+            low = i + 1;
+        } else {
+            high = i;
+        }
+    }
+    return low;
+}
+
+// Sequential stable merge of a[0..n1) and b[0..n2) into out, elements are moved
+template <typename T>
+void mergeInto(T* a, int n1, T* b, int n2, T* out) {
+    int i = 0;
+    int j = 0;
+    while (i < n1 && j < n2) {
+        if (b[j] < a[i]) {
+            *out++ = std::move(b[j++]);
+        } else {
+            *out++ = std::move(a[i++]);
+        }
+    }
+    out = std::move(a + i, a + n1, out);
+    std::move(b + j, b + n2, out);
+}
+
+// Merges src[left..mid] and src[mid+1..right] into dst[left..right]
+// The output is cut into equal slices, each slice finds its inputs with coRank
+// and is merged by its own task.
+template <typename T>
+void parallelMerge(T* src, T* dst, int left, int mid, int right, ThreadPool& pool, int cutoff) {
+    T* a = src + left;
+    T* b = src + mid + 1;
+    int n1 = mid - left + 1;
+    int n2 = right - mid;
+    int total = n1 + n2;
+
+    int slices = std::min(static_cast<int>(pool.size()) * 4, total / cutoff);
+    if (slices <= 1) {
+        mergeInto(a, n1, b, n2, dst + left);
+        return;
+    }
+
+    TaskGroup group(pool);
+    for (int s = 0; s < slices; ++s) {
+        int k0 = static_cast<int>(static_cast<long long>(total) * s / slices);
+        int k1 = static_cast<int>(static_cast<long long>(total) * (s + 1) / slices);
+        group.run([=]() {
+            int i0 = coRank(k0, a, n1, b, n2);
+            int i1 = coRank(k1, a, n1, b, n2);
+            mergeInto(a + i0, i1 - i0, b + (k0 - i0), (k1 - i1) - (k0 - i0), dst + left + k0);
+        });
+    }
+    group.wait();
+}
+
+// Parallel stable merge sort core logic
+// Sorts arr[left..right] and leaves the result in arr, or in buf when toBuffer is set.
+// Each level merges from one array into the other, so no copy back is needed.
+template <typename T>
+void parallelMergeSort(std::vector<T>& arr, std::vector<T>& buf, int left, int right, bool toBuffer, ThreadPool& pool, int cutoff) {
+    if (right - left < cutoff) {
+        mergeSortBottomUp(arr, buf, left, right);
+        if (toBuffer) {
+            std::move(arr.begin() + left, arr.begin() + right + 1, buf.begin() + left);
+        }
+        return;
+    }
+
+    int mid = left + (right - left) / 2;
+    {
+        TaskGroup group(pool);
+        group.run([&arr, &buf, left, mid, toBuffer, &pool, cutoff]() {
+            parallelMergeSort(arr, buf, left, mid, !toBuffer, pool, cutoff);
+        });
+        parallelMergeSort(arr, buf, mid + 1, right, !toBuffer, pool, cutoff);
+        group.wait();
+    }
+
+    if (toBuffer) {
+        parallelMerge(arr.data(), buf.data(), left, mid, right, pool, cutoff);
+    } else {
+        parallelMerge(buf.data(), arr.data(), left, mid, right, pool, cutoff);
+    }
+}
+
+// Stable sort of arr on the given pool, ranges of at most cutoff elements stay sequential
+// cutoff is raised to INTROSORT_INSERTION_THRESHOLD: parallelMerge divides the output by it
+template <typename T>
+void mergeSortOn(std::vector<T>& arr, ThreadPool& pool, int cutoff = PARALLEL_CUTOFF) {
+    int n = static_cast<int>(arr.size());
+    if (n < 2) return;
+    cutoff = std::max(cutoff, sort_custom::INTROSORT_INSERTION_THRESHOLD);
+
+    std::vector<T> buffer(n);
+    parallelMergeSort(arr, buffer, 0, n - 1, false, pool, cutoff);
+}
+
+// Public interface
+template <typename T>
+void mergeSortAll(std::vector<T>& arr) {
+    mergeSortOn(arr, ThreadPool::shared());
+}
+
+} // namespace sort_mt
+
+} // namespace algolab
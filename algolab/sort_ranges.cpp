@@ -0,0 +1 @@
+#include "sort_ranges.h"
@@ -0,0 +1,267 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <concepts>
+#include <functional>
+#include <iterator>
+#include <ranges>
+#include <utility>
+#include <vector>
+#include "heapsort.h"
+
+namespace algolab {
+
+/**
+ * @brief Iterator and range based sorting API
+ * @details
+ * Generic counterparts of introSortAll, mergeSortAll, heapSort and quickSortAll under
+ * algolab::ranges, following the std::ranges conventions:
+ *  - any random access iterator pair or random access range (std::vector,
+ *    algolab::Vector, std::span over a raw or mmap'd buffer, sub-ranges...),
+ *  - a comparator (default std::ranges::less) and a projection (default std::identity),
+ *    e.g. sort MarketQuote objects by price in place with &MarketQuote::price,
+ *  - 64-bit indexing (the iterator difference type), so ranges larger than 2^31
+ *    elements are supported.
+ * The std::vector<T>& overloads in sort.h, introsort.h and sort_iterative.h are unchanged.
+ */
+
+namespace ranges {
+
+namespace detail {
+
+// Comparator applied to the projections of two elements
+template <typename Comp, typename Proj>
+struct ProjectedLess {
+    Comp& comp;
+    Proj& proj;
+
+    template <typename A, typename B>
+    bool operator()(A&& a, B&& b) const {
+        return std::invoke(comp, std::invoke(proj, std::forward<A>(a)), std::invoke(proj, std::forward<B>(b)));
+    }
+};
+
+constexpr std::ptrdiff_t INSERTION_THRESHOLD = 16;
+constexpr std::ptrdiff_t MERGE_RUN_SIZE = 32;
+
+template <typename I, typename Less>
+void insertionSort(I first, I last, Less& less) {
+    if (first == last) return;
+    for (I it = first + 1; it != last; ++it) {
+        auto key = std::ranges::iter_move(it);
+        I hole = it;
+        while (hole != first && less(key, *(hole - 1))) {
+            *hole = std::ranges::iter_move(hole - 1);
+            --hole;
+        }
+        *hole = std::move(key);
+    }
+}
+
+// Depth-limit fallback and ranges::heapSort: 4-ary bottom-up heapsort (see heapsort.h)
+template <typename I, typename Less>
+void heapSort(I first, I last, Less& less) {
+    sort_heap::heapSort(first, last, less);
+}
+
+// Median-of-three Hoare partition of [first, last), at least 3 elements
+// Same scheme as sort_custom::partition: the median is parked at last - 2 and the
+// outer elements act as sentinels. Returns the final pivot position.
+template <typename I, typename Less>
+I hoarePartition(I first, I last, Less& less) {
+    I high = last - 1;
+    I mid = first + (last - first) / 2;
+    if (less(*high, *first)) std::ranges::iter_swap(first, high);
+    if (less(*mid, *first)) std::ranges::iter_swap(mid, first);
+    if (less(*high, *mid)) std::ranges::iter_swap(high, mid);
+
+    I pivotPos = high - 1;
+    std::ranges::iter_swap(mid, pivotPos);
+    // The pivot stays at pivotPos until the final swap, so no copy is needed
+    const auto& pivot = *pivotPos;
+
+    I i = first;
+    I j = pivotPos;
+    while (true) {
+        while (less(*++i, pivot)) {}
+        while (less(pivot, *--j)) {}
+        if (i < j) {
+            std::ranges::iter_swap(i, j);
+        } else {
+            break;
+        }
+    }
+    std::ranges::iter_swap(i, pivotPos);
+    return i;
+}
+
+// Recurses on the smaller side and loops on the larger one, so the stack stays O(log n)
+template <typename I, typename Less>
+void introsort(I first, I last, int depthLimit, Less& less) {
+    while (last - first > INSERTION_THRESHOLD) {
+        if (depthLimit == 0) {
+            detail::heapSort(first, last, less);
+            return;
+        }
+        --depthLimit;
+
+        I pivot = hoarePartition(first, last, less);
+        if (pivot - first < last - pivot) {
+            detail::introsort(first, pivot, depthLimit, less);
+            first = pivot + 1;
+        } else {
+            detail::introsort(pivot + 1, last, depthLimit, less);
+            last = pivot;
+        }
+    }
+    detail::insertionSort(first, last, less);
+}
+
+// Stable merge of src[lo..mid) and src[mid..hi) into dst[lo..hi), elements are moved
+template <typename Src, typename Dst, typename D, typename Less>
+void mergeRuns(Src src, Dst dst, D lo, D mid, D hi, Less& less) {
+    if (mid >= hi || !less(src[mid], src[mid - 1])) {
+        std::move(src + lo, src + hi, dst + lo);
+        return;
+    }
+    D i = lo;
+    D j = mid;
+    D k = lo;
+    while (i < mid && j < hi) {
+        if (less(src[j], src[i])) {
+            dst[k++] = std::move(src[j++]);
+        } else {
+            dst[k++] = std::move(src[i++]);
+        }
+    }
+    std::move(src + i, src + mid, dst + k);
+    std::move(src + j, src + hi, dst + k + (mid - i));
+}
+
+} // namespace detail
+
+// IntroSort of [first, last)
+template <std::random_access_iterator I, std::sentinel_for<I> S,
+          typename Comp = std::ranges::less, typename Proj = std::identity>
+    requires std::sortable<I, Comp, Proj>
+void introSortAll(I first, S sentinel, Comp comp = {}, Proj proj = {}) {
+    I last = std::ranges::next(first, sentinel);
+    auto n = last - first;
+    if (n < 2) return;
+
+    detail::ProjectedLess<Comp, Proj> less {comp, proj};
+    detail::introsort(first, last, 2 * static_cast<int>(std::log2(static_cast<double>(n))), less);
+}
+
+template <std::ranges::random_access_range R, typename Comp = std::ranges::less, typename Proj = std::identity>
+    requires std::sortable<std::ranges::iterator_t<R>, Comp, Proj>
+void introSortAll(R&& range, Comp comp = {}, Proj proj = {}) {
+    introSortAll(std::ranges::begin(range), std::ranges::end(range), std::move(comp), std::move(proj));
+}
+
+// Stable bottom-up MergeSort of [first, last)
+// The elements are moved into one scratch buffer up front, which then serves as the
+// source of the first merge pass, so the value type needs no default constructor.
+template <std::random_access_iterator I, std::sentinel_for<I> S,
+          typename Comp = std::ranges::less, typename Proj = std::identity>
+    requires std::sortable<I, Comp, Proj>
+void mergeSortAll(I first, S sentinel, Comp comp = {}, Proj proj = {}) {
+    using D = std::iter_difference_t<I>;
+    I last = std::ranges::next(first, sentinel);
+    D n = last - first;
+    if (n < 2) return;
+
+    detail::ProjectedLess<Comp, Proj> less {comp, proj};
+    if (n <= detail::MERGE_RUN_SIZE) {
+        detail::insertionSort(first, last, less);
+        return;
+    }
+
+    std::vector<std::iter_value_t<I>> buffer(std::make_move_iterator(first), std::make_move_iterator(last));
+    auto bufferBegin = buffer.begin();
+    for (D lo = 0; lo < n; lo += detail::MERGE_RUN_SIZE) {
+        detail::insertionSort(bufferBegin + lo, bufferBegin + std::min(lo + detail::MERGE_RUN_SIZE, n), less);
+    }
+
+    // Ping-pong: even passes read the buffer, odd passes read the input range
+    bool inBuffer = true;
+    for (D width = detail::MERGE_RUN_SIZE; width < n; width *= 2) {
+        for (D lo = 0; lo < n; lo += 2 * width) {
+            D mid = std::min(lo + width, n);
+            D hi = std::min(lo + 2 * width, n);
+            if (inBuffer) {
+                detail::mergeRuns(bufferBegin, first, lo, mid, hi, less);
+            } else {
+                detail::mergeRuns(first, bufferBegin, lo, mid, hi, less);
+            }
+        }
+        inBuffer = !inBuffer;
+    }
+
+    if (inBuffer) {
+        std::move(buffer.begin(), buffer.end(), first);
+    }
+}
+
+template <std::ranges::random_access_range R, typename Comp = std::ranges::less, typename Proj = std::identity>
+    requires std::sortable<std::ranges::iterator_t<R>, Comp, Proj>
+void mergeSortAll(R&& range, Comp comp = {}, Proj proj = {}) {
+    mergeSortAll(std::ranges::begin(range), std::ranges::end(range), std::move(comp), std::move(proj));
+}
+
+// HeapSort of [first, last), in place (d-ary, bottom-up sift)
+template <std::random_access_iterator I, std::sentinel_for<I> S,
+          typename Comp = std::ranges::less, typename Proj = std::identity>
+    requires std::sortable<I, Comp, Proj>
+void heapSort(I first, S sentinel, Comp comp = {}, Proj proj = {}) {
+    I last = std::ranges::next(first, sentinel);
+    detail::ProjectedLess<Comp, Proj> less {comp, proj};
+    detail::heapSort(first, last, less);
+}
+
+template <std::ranges::random_access_range R, typename Comp = std::ranges::less, typename Proj = std::identity>
+    requires std::sortable<std::ranges::iterator_t<R>, Comp, Proj>
+void heapSort(R&& range, Comp comp = {}, Proj proj = {}) {
+    heapSort(std::ranges::begin(range), std::ranges::end(range), std::move(comp), std::move(proj));
+}
+
+// Iterative QuickSort of [first, last)
+// Like sort_iter::quickSortAll it keeps pending ranges on an explicit stack; the larger
+// side is pushed and the smaller one processed first, so the stack holds O(log n) ranges.
+template <std::random_access_iterator I, std::sentinel_for<I> S,
+          typename Comp = std::ranges::less, typename Proj = std::identity>
+    requires std::sortable<I, Comp, Proj>
+void quickSortAll(I first, S sentinel, Comp comp = {}, Proj proj = {}) {
+    I last = std::ranges::next(first, sentinel);
+    detail::ProjectedLess<Comp, Proj> less {comp, proj};
+
+    std::vector<std::pair<I, I>> stack;
+    stack.push_back({first, last});
+    while (!stack.empty()) {
+        auto [low, high] = stack.back();
+        stack.pop_back();
+
+        while (high - low > detail::INSERTION_THRESHOLD) {
+            I pivot = detail::hoarePartition(low, high, less);
+            if (pivot - low < high - pivot) {
+                stack.push_back({pivot + 1, high});
+                high = pivot;
+            } else {
+                stack.push_back({low, pivot});
+                low = pivot + 1;
+            }
+        }
+        detail::insertionSort(low, high, less);
+    }
+}
+
+template <std::ranges::random_access_range R, typename Comp = std::ranges::less, typename Proj = std::identity>
+    requires std::sortable<std::ranges::iterator_t<R>, Comp, Proj>
+void quickSortAll(R&& range, Comp comp = {}, Proj proj = {}) {
+    quickSortAll(std::ranges::begin(range), std::ranges::end(range), std::move(comp), std::move(proj));
+}
+
+} // namespace ranges
+
+} // namespace algolab
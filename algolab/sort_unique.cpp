@@ -0,0 +1 @@
+#include "sort_unique.h"
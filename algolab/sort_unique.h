@@ -0,0 +1,143 @@
+#pragma once
+
+#include <vector>
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+#include <type_traits>
+#include "sort.h"
+#include "radix_sort.h"
+
+namespace algolab {
+
+/**
+ * @brief Fused sort and deduplication
+ * @details
+ * sortUnique(arr) leaves arr sorted with every duplicate removed, as std::sort followed
+ * by std::unique and erase would, but drops the duplicates while it sorts:
+ *  - runs of MERGE_RUN_SIZE elements are insertion sorted and compacted in place,
+ *    so each run holds distinct keys only,
+ *  - bottom-up merge passes ping-pong between arr and one scratch buffer; a merge
+ *    emits an element only if it is greater than the last one emitted, so keys found
+ *    in both runs are written once and the runs shrink pass after pass.
+ * On duplicate-heavy input (ingest IDs repeated many times) every pass moves only the
+ * distinct keys seen so far, instead of n elements per pass plus a final unique pass.
+ * Equality is !(a < b) && !(b < a); the first element of each group of equal keys is
+ * kept (the one from the leftmost run).
+ * Integral and floating point keys take a faster route: LSD radix sort (radix_sort.h)
+ * followed by a single compaction pass. Radix sort moves NaNs to the ends (by sign) and
+ * NaN is unordered, so floating point keys are compacted with operator== instead, as
+ * std::unique does: every NaN is kept, -0.0 and +0.0 are one key.
+ */
+
+namespace sort_custom {
+
+namespace detail {
+
+// Moves the deduplicated merge of src[a0, a1) and src[b0, b1) to dst[out...)
+// Both inputs are sorted and hold distinct keys. Returns the end of the output.
+template <typename T>
+size_t mergeUnique(std::vector<T>& src, size_t a0, size_t a1, size_t b0, size_t b1, std::vector<T>& dst, size_t out) {
+    const size_t start = out;
+    // Writes unconditionally and only keeps the write if it is a new key, which avoids
+    // a hard-to-predict branch when duplicates are common
+    auto emit = [&](T& value) {
+        dst[out] = std::move(value);
+        out += (out == start || dst[out - 1] < dst[out]);
+    };
+    while (a0 < a1 && b0 < b1) {
+        if (src[b0] < src[a0]) {
+            emit(src[b0++]);
+        } else {
+            emit(src[a0++]);
+        }
+    }
+    while (a0 < a1) emit(src[a0++]);
+    while (b0 < b1) emit(src[b0++]);
+    return out;
+}
+
+// Moves the distinct keys of the sorted arr[first, last) to arr[write...), write <= first
+// Returns the end of the output. Never self-assigns: a self-move leaves the element unspecified.
+template <typename T>
+size_t compactUnique(std::vector<T>& arr, size_t first, size_t last, size_t write) {
+    for (size_t i = first; i < last; ++i) {
+        bool distinct;
+        if constexpr (std::is_floating_point_v<T>) {
+            distinct = i == first || !(arr[write - 1] == arr[i]);
+        } else {
+            distinct = i == first || arr[write - 1] < arr[i];
+        }
+        if (distinct) {
+            if (write != i) arr[write] = std::move(arr[i]);
+            ++write;
+        }
+    }
+    return write;
+}
+
+} // namespace detail
+
+// Sorts arr and removes its duplicates, returns the number of distinct elements
+template <typename T>
+size_t sortUnique(std::vector<T>& arr) {
+    const size_t n = arr.size();
+    if (n < 2) return n;
+
+    if constexpr (std::is_arithmetic_v<T>) {
+        // Radix sort beats any comparison merge here; the compaction is one sequential pass
+        sort_radix::radixSortAll(arr);
+        arr.erase(arr.begin() + detail::compactUnique(arr, 0, n, 0), arr.end());
+        return arr.size();
+    }
+
+    // Sorted, duplicate-free runs, compacted to the front of arr
+    std::vector<size_t> runEnds;
+    runEnds.reserve(n / MERGE_RUN_SIZE + 1);
+    size_t write = 0;
+    for (size_t runStart = 0; runStart < n; runStart += MERGE_RUN_SIZE) {
+        size_t runEnd = std::min(runStart + MERGE_RUN_SIZE, n);
+        for (size_t i = runStart + 1; i < runEnd; ++i) {
+            T key = std::move(arr[i]);
+            size_t j = i;
+            while (j > runStart && key < arr[j - 1]) {
+                arr[j] = std::move(arr[j - 1]);
+                --j;
+            }
+            arr[j] = std::move(key);
+        }
+
+        write = detail::compactUnique(arr, runStart, runEnd, write);
+        runEnds.push_back(write);
+    }
+
+    std::vector<T> buffer(write);
+    std::vector<T>* src = &arr;
+    std::vector<T>* dst = &buffer;
+    while (runEnds.size() > 1) {
+        std::vector<size_t> merged;
+        merged.reserve(runEnds.size() / 2 + 1);
+        size_t out = 0;
+        size_t begin = 0;
+        for (size_t r = 0; r < runEnds.size(); r += 2) {
+            size_t mid = runEnds[r];
+            size_t end = (r + 1 < runEnds.size()) ? runEnds[r + 1] : mid;
+            out = detail::mergeUnique(*src, begin, mid, mid, end, *dst, out);
+            merged.push_back(out);
+            begin = end;
+        }
+        runEnds = std::move(merged);
+        std::swap(src, dst);
+    }
+
+    const size_t unique = runEnds.back();
+    if (src != &arr) {
+        std::move(buffer.begin(), buffer.begin() + unique, arr.begin());
+    }
+    arr.erase(arr.begin() + unique, arr.end());
+    return unique;
+}
+
+} // namespace sort_custom
+
+} // namespace algolab
@@ -0,0 +1 @@
+#include "sorting_network.h"
@@ -0,0 +1,221 @@
+#pragma once
+
+#include <array>
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <functional>
+#include <type_traits>
+#include <utility>
+
+namespace algolab {
+
+/**
+ * @brief Compile-time sorting networks for fixed-size arrays
+ * @details
+ * networkSort sorts std::array<T, N> and T[N] (N up to SORTING_NETWORK_MAX_SIZE)
+ * with a sorting network chosen at compile time, under algolab::sort_network:
+ *  - N <= 8: size-optimal networks (3, 5, 9, 12, 16 and 19 comparators for N = 3..8),
+ *  - larger N: Batcher's odd-even merge sort generated for the next power of two,
+ *    with the comparators that touch the padding removed (padding acts as +inf).
+ * The comparator list is a constexpr table and the sort is a fold over it, so the
+ * compiler emits a fixed, unrolled sequence of compare-exchanges with constant
+ * indices and no loop or data-dependent branch. For arithmetic types under the
+ * default ordering each compare-exchange is a min / max pair (cmov, minss / maxss).
+ * Everything is constexpr and usable in constant evaluation; every network is
+ * checked with the 0-1 principle (a network sorts all inputs iff it sorts all 2^N
+ * inputs of zeros and ones), the tables at compile time.
+ * sortSmall(first, n) picks the network for a size only known at run time; larger n
+ * falls back to std::sort.
+ * Reference: D. E. Knuth, TAOCP Vol. 3, 5.3.4; K. E. Batcher, "Sorting networks and
+ * their applications" (AFIPS 1968).
+ */
+
+namespace sort_network {
+
+// Largest N a network is generated for; the code size grows with N log^2 N
+constexpr size_t SORTING_NETWORK_MAX_SIZE = 32;
+
+// Compare-exchange of positions a < b: the smaller element ends up at a
+struct Comparator {
+    unsigned char a;
+    unsigned char b;
+};
+
+namespace detail {
+
+// Size-optimal networks for N = 2..8, as (a, b) position pairs in execution order
+constexpr Comparator NETWORK_2[] = {{0, 1}};
+constexpr Comparator NETWORK_3[] = {{0, 2}, {0, 1}, {1, 2}};
+constexpr Comparator NETWORK_4[] = {{0, 1}, {2, 3}, {0, 2}, {1, 3}, {1, 2}};
+constexpr Comparator NETWORK_5[] = {{0, 1}, {3, 4}, {2, 4}, {2, 3}, {0, 3}, {0, 2}, {1, 4}, {1, 3}, {1, 2}};
+constexpr Comparator NETWORK_6[] = {{1, 2}, {4, 5}, {0, 2}, {3, 5}, {0, 1}, {3, 4},
+                                    {2, 5}, {0, 3}, {1, 4}, {2, 4}, {1, 3}, {2, 3}};
+constexpr Comparator NETWORK_7[] = {{1, 2}, {3, 4}, {5, 6}, {0, 2}, {3, 5}, {4, 6}, {0, 1}, {4, 5},
+                                    {2, 6}, {0, 4}, {1, 5}, {0, 3}, {2, 5}, {1, 3}, {2, 4}, {2, 3}};
+constexpr Comparator NETWORK_8[] = {{0, 2}, {1, 3}, {4, 6}, {5, 7}, {0, 4}, {1, 5}, {2, 6}, {3, 7}, {0, 1}, {2, 3},
+                                    {4, 5}, {6, 7}, {2, 4}, {3, 5}, {1, 4}, {3, 6}, {1, 2}, {3, 4}, {5, 6}};
+
+template <typename Emit>
+constexpr void emitTable(const Comparator* table, size_t count, Emit& emit) {
+    for (size_t i = 0; i < count; ++i) emit(table[i].a, table[i].b);
+}
+
+// Calls emit(a, b) for every comparator of the network for n elements, in order
+template <typename Emit>
+constexpr void generateNetwork(size_t n, Emit emit) {
+    switch (n) {
+    case 0:
+    case 1: return;
+    case 2: return emitTable(NETWORK_2, std::size(NETWORK_2), emit);
+    case 3: return emitTable(NETWORK_3, std::size(NETWORK_3), emit);
+    case 4: return emitTable(NETWORK_4, std::size(NETWORK_4), emit);
+    case 5: return emitTable(NETWORK_5, std::size(NETWORK_5), emit);
+    case 6: return emitTable(NETWORK_6, std::size(NETWORK_6), emit);
+    case 7: return emitTable(NETWORK_7, std::size(NETWORK_7), emit);
+    case 8: return emitTable(NETWORK_8, std::size(NETWORK_8), emit);
+    default: break;
+    }
+    // Batcher's odd-even merge sort on the next power of two; comparators reaching
+    // past n would compare against +inf padding and never exchange, so they are dropped
+    size_t padded = 1;
+    while (padded < n) padded <<= 1;
+    for (size_t p = 1; p < padded; p <<= 1) {
+        for (size_t k = p; k >= 1; k >>= 1) {
+            for (size_t j = k % p; j + k < padded; j += 2 * k) {
+                for (size_t i = 0; i < std::min(k, padded - j - k); ++i) {
+                    if ((i + j) / (2 * p) == (i + j + k) / (2 * p) && i + j + k < n) {
+                        emit(i + j, i + j + k);
+                    }
+                }
+            }
+        }
+    }
+}
+
+constexpr size_t comparatorCount(size_t n) {
+    size_t count = 0;
+    generateNetwork(n, [&count](size_t, size_t) { ++count; });
+    return count;
+}
+
+template <size_t N>
+constexpr auto makeNetwork() {
+    std::array<Comparator, comparatorCount(N)> network{};
+    size_t next = 0;
+    generateNetwork(N, [&](size_t a, size_t b) {
+        network[next++] = Comparator{static_cast<unsigned char>(a), static_cast<unsigned char>(b)};
+    });
+    return network;
+}
+
+} // namespace detail
+
+// The comparators of the network for N elements
+template <size_t N>
+struct Network {
+    static_assert(N <= SORTING_NETWORK_MAX_SIZE, "No sorting network generated for this size");
+    static constexpr auto comparators = detail::makeNetwork<N>();
+};
+
+namespace detail {
+
+template <typename Less>
+constexpr bool isDefaultLess = std::is_same_v<Less, std::less<>> || std::is_same_v<Less, std::ranges::less>;
+
+template <typename T, typename Less>
+constexpr void compareExchange(T& a, T& b, Less& less) {
+    if constexpr (std::is_arithmetic_v<T> && (isDefaultLess<Less> || std::is_same_v<Less, std::less<T>>)) {
+        // Both selects compile to min / max or conditional moves, no branch
+        bool swap = b < a;
+        T low = swap ? b : a;
+        T high = swap ? a : b;
+        a = low;
+        b = high;
+    } else {
+        if (less(b, a)) std::ranges::swap(a, b);
+    }
+}
+
+template <size_t N, typename T, typename Less, size_t... I>
+constexpr void applyNetwork(T* first, Less& less, std::index_sequence<I...>) {
+    constexpr auto& network = Network<N>::comparators;
+    (compareExchange(first[network[I].a], first[network[I].b], less), ...);
+}
+
+} // namespace detail
+
+// Depth of a network: the number of parallel layers, each position used once per layer
+template <size_t N>
+constexpr size_t networkDepth() {
+    std::array<size_t, N + 1> ready{};
+    size_t depth = 0;
+    for (const auto& c : Network<N>::comparators) {
+        size_t layer = std::max(ready[c.a], ready[c.b]) + 1;
+        ready[c.a] = ready[c.b] = layer;
+        depth = std::max(depth, layer);
+    }
+    return depth;
+}
+
+// 0-1 principle: true if the network for N sorts every one of the 2^N zero-one inputs
+template <size_t N>
+constexpr bool sortsAllZeroOne() {
+    static_assert(N < 8 * sizeof(unsigned long long), "Too many zero-one inputs to enumerate");
+    for (unsigned long long bits = 0; bits < (1ull << N); ++bits) {
+        unsigned long long v = bits;
+        for (const auto& c : Network<N>::comparators) {
+            // Bit a is the smaller element: it keeps the AND, b gets the OR
+            unsigned long long x = (v >> c.a) & 1, y = (v >> c.b) & 1;
+            v = (v & ~((1ull << c.a) | (1ull << c.b))) | ((x & y) << c.a) | ((x | y) << c.b);
+        }
+        // Sorted ascending: the zeros fill the low positions, the ones the rest
+        unsigned long long zeros = (1ull << (N - std::popcount(v))) - 1;
+        if (v != (((1ull << N) - 1) & ~zeros)) return false;
+    }
+    return true;
+}
+
+static_assert(Network<8>::comparators.size() == 19 && networkDepth<8>() == 6);
+static_assert(sortsAllZeroOne<3>() && sortsAllZeroOne<4>() && sortsAllZeroOne<5>() && sortsAllZeroOne<6>()
+              && sortsAllZeroOne<7>() && sortsAllZeroOne<8>());
+
+// Sorts first[0..N) with the network for N
+template <size_t N, typename T, typename Compare = std::less<>>
+constexpr void networkSortN(T* first, Compare comp = Compare()) {
+    detail::applyNetwork<N>(first, comp, std::make_index_sequence<Network<N>::comparators.size()>{});
+}
+
+template <typename T, size_t N, typename Compare = std::less<>>
+constexpr void networkSort(std::array<T, N>& arr, Compare comp = Compare()) {
+    networkSortN<N>(arr.data(), comp);
+}
+
+template <typename T, size_t N, typename Compare = std::less<>>
+constexpr void networkSort(T (&arr)[N], Compare comp = Compare()) {
+    networkSortN<N>(arr, comp);
+}
+
+namespace detail {
+
+template <typename T, typename Compare, size_t... N>
+constexpr void sortSmall(T* first, size_t n, Compare& comp, std::index_sequence<N...>) {
+    ((n == N && (networkSortN<N>(first, comp), true)) || ...);
+}
+
+} // namespace detail
+
+// Sorts first[0..n) with the network for a run-time n <= SORTING_NETWORK_MAX_SIZE,
+// and with std::sort (constexpr as well) past the largest network
+template <typename T, typename Compare = std::less<>>
+constexpr void sortSmall(T* first, size_t n, Compare comp = Compare()) {
+    if (n > SORTING_NETWORK_MAX_SIZE) {
+        std::sort(first, first + n, comp);
+        return;
+    }
+    detail::sortSmall(first, n, comp, std::make_index_sequence<SORTING_NETWORK_MAX_SIZE + 1>{});
+}
+
+} // namespace sort_network
+
+} // namespace algolab
@@ -0,0 +1 @@
+#include "string_sort.h"
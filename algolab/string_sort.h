@@ -0,0 +1,486 @@
+#pragma once
+
+#include <vector>
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <ranges>
+#include <stdexcept>
+#include <string_view>
+#include <utility>
+#include "argsort.h"
+
+namespace algolab {
+
+/**
+ * @brief String sorts: multikey quicksort, MSD radix sort, LCP merge sort
+ * @details
+ * Comparison sorts compare strings from their first character every time, so keys
+ * sharing long prefixes (symbols, order IDs, paths) re-scan those prefixes on
+ * every comparison. The sorts under algolab::sort_string look at each character
+ * position once per element instead, for any random access range whose elements
+ * convert to std::string_view (std::string, std::string_view, const char*):
+ *  - multikeyQuickSortAll: Bentley-Sedgewick three-way radix quicksort, partitions
+ *    on one character and only moves on to the next character for the equal part,
+ *  - stringRadixSortAll: MSD radix sort, distributes into 257 buckets (end of string
+ *    and every byte value) per character, and hands buckets smaller than
+ *    STRING_RADIX_THRESHOLD to multikey quicksort,
+ *  - lcpMergeSortAll: stable merge sort that carries the longest common prefix (LCP)
+ *    of neighbouring strings; the merge compares two strings only from their common
+ *    prefix with the last output onwards, and most steps need no character access.
+ * The sorts run on compact 16-byte (pointer, length, index) keys and then move every
+ * element once into place with sort_key::applyPermutation. Bytes compare as unsigned char,
+ * the order of std::string::compare.
+ * References: Bentley & Sedgewick, "Fast Algorithms for Sorting and Searching
+ * Strings" (SODA 1997); Ng & Kakehi, "Merging String Sequences by Longest Common
+ * Prefixes" (2008).
+ */
+
+namespace sort_string {
+
+// Below this size a partition or bucket is insertion sorted from the current depth
+constexpr size_t STRING_INSERTION_THRESHOLD = 16;
+// Below this size a radix bucket is handed to multikey quicksort
+constexpr size_t STRING_RADIX_THRESHOLD = 64;
+
+template <typename R>
+concept StringRange = std::ranges::random_access_range<R> && std::ranges::sized_range<R>
+    && std::convertible_to<std::ranges::range_reference_t<R>, std::string_view>;
+
+namespace detail {
+
+// 16 bytes: ranges of up to 2^32 - 1 strings of up to 2^32 - 1 bytes each
+struct StringKey {
+    const unsigned char* data;
+    uint32_t length;
+    uint32_t index;
+};
+
+// Bytes held by a chunk, the super-character the sorts work on
+constexpr size_t CHUNK_BYTES = 7;
+
+// The CHUNK_BYTES bytes of key from depth (zero padded) in the high 56 bits and how
+// many of them the string has (0..7) in the low byte. Chunks order like the suffixes
+// they start: on equal bytes the string that ends first orders first.
+inline uint64_t chunkAt(const StringKey& key, size_t depth) {
+    if (depth >= key.length) return 0;
+    const unsigned char* p = key.data + depth;
+    size_t count = std::min<size_t>(key.length - depth, CHUNK_BYTES);
+    uint64_t chunk = 0;
+    if (count == CHUNK_BYTES) {
+        // Fixed-length loads, compiled to a word load and a byte swap
+        for (size_t i = 0; i < CHUNK_BYTES; ++i) chunk |= uint64_t(p[i]) << (56 - 8 * i);
+    } else {
+        for (size_t i = 0; i < count; ++i) chunk |= uint64_t(p[i]) << (56 - 8 * i);
+    }
+    return chunk | count;
+}
+
+inline size_t chunkCount(uint64_t chunk) {
+    return static_cast<size_t>(chunk & 0xFF);
+}
+
+// Bytes two different chunks taken at the same depth have in common, as string bytes
+inline size_t chunkCommonPrefix(uint64_t a, uint64_t b) {
+    size_t equalBytes = static_cast<size_t>(std::countl_zero(a ^ b)) / 8;
+    return std::min({equalBytes, chunkCount(a), chunkCount(b)});
+}
+
+// Length of the common prefix of a and b, both known to agree on their first depth bytes
+// Compares 8 bytes at a time, the first differing byte is found from the XOR of two words.
+inline size_t commonPrefix(const StringKey& a, const StringKey& b, size_t depth) {
+    size_t limit = std::min<size_t>(a.length, b.length);
+    if constexpr (std::endian::native == std::endian::little) {
+        while (depth + 8 <= limit) {
+            uint64_t wa;
+            uint64_t wb;
+            std::memcpy(&wa, a.data + depth, 8);
+            std::memcpy(&wb, b.data + depth, 8);
+            if (wa != wb) return depth + static_cast<size_t>(std::countr_zero(wa ^ wb)) / 8;
+            depth += 8;
+        }
+    }
+    while (depth < limit && a.data[depth] == b.data[depth]) ++depth;
+    return depth;
+}
+
+// a < b for strings that agree on their first depth bytes (memcmp of the suffixes)
+inline bool lessFrom(const StringKey& a, const StringKey& b, size_t depth) {
+    std::string_view sa(reinterpret_cast<const char*>(a.data) + depth, a.length - depth);
+    std::string_view sb(reinterpret_cast<const char*>(b.data) + depth, b.length - depth);
+    return sa < sb;
+}
+
+template <StringRange R>
+std::vector<StringKey> makeKeys(R& strings) {
+    constexpr size_t maxSize = std::numeric_limits<uint32_t>::max();
+    if (static_cast<size_t>(std::ranges::size(strings)) > maxSize) {
+        throw std::length_error("String sort: too many strings");
+    }
+
+    std::vector<StringKey> keys;
+    keys.reserve(static_cast<size_t>(std::ranges::size(strings)));
+    uint32_t index = 0;
+    for (auto&& s : strings) {
+        std::string_view view(s);
+        if (view.size() > maxSize) {
+            throw std::length_error("String sort: string too long");
+        }
+        keys.push_back({reinterpret_cast<const unsigned char*>(view.data()), static_cast<uint32_t>(view.size()),
+                        index++});
+    }
+    return keys;
+}
+
+template <StringRange R>
+void applyKeyOrder(R& strings, const std::vector<StringKey>& keys) {
+    std::vector<size_t> perm(keys.size());
+    for (size_t i = 0; i < keys.size(); ++i) {
+        perm[i] = keys[i].index;
+    }
+    sort_key::applyPermutation(strings, std::move(perm));
+}
+
+// Insertion sort of keys that agree on their first depth bytes
+inline void insertionSort(StringKey* keys, size_t n, size_t depth) {
+    for (size_t i = 1; i < n; ++i) {
+        StringKey value = keys[i];
+        size_t hole = i;
+        while (hole > 0 && lessFrom(value, keys[hole - 1], depth)) {
+            keys[hole] = keys[hole - 1];
+            --hole;
+        }
+        keys[hole] = value;
+    }
+}
+
+// Depth up to which all of keys[0..n) agree, given that they agree up to depth
+// One word-wise scan per string skips a long shared prefix (a venue or date in
+// every order ID) at once instead of one chunk per pass.
+inline size_t sharedDepth(const StringKey* keys, size_t n, size_t depth) {
+    size_t shared = keys[0].length;
+    for (size_t i = 1; i < n && shared > depth; ++i) {
+        shared = std::min(shared, commonPrefix(keys[0], keys[i], depth));
+    }
+    return shared;
+}
+
+inline uint64_t medianOfThree(uint64_t a, uint64_t b, uint64_t c) {
+    return std::max(std::min(a, b), std::min(std::max(a, b), c));
+}
+
+// Three-way radix quicksort of keys that agree on their first depth bytes
+// Partitions on 7-byte chunks rather than single characters, so a common prefix
+// costs one pass per 7 bytes. chunks[i] caches the chunk of keys[i] at depth and
+// moves with it: the smaller and greater parts stay at the same depth and never
+// read their strings again, only the equal part loads the next chunk. The two
+// smaller parts (at most n / 2 keys each) recurse and the largest one is continued
+// by the loop, which bounds the recursion to O(log n) depth.
+inline void multikeyQuickSort(StringKey* keys, uint64_t* chunks, size_t n, size_t depth, bool cached) {
+    while (n > STRING_INSERTION_THRESHOLD) {
+        if (!cached) {
+            uint64_t diff = 0;
+            for (size_t i = 0; i < n; ++i) {
+                chunks[i] = chunkAt(keys[i], depth);
+                diff |= chunks[i] ^ chunks[0];
+            }
+            if (diff == 0) {
+                // One chunk shared by all: equal strings, or skip the whole shared prefix
+                if (chunkCount(chunks[0]) < CHUNK_BYTES) return;
+                depth = sharedDepth(keys, n, depth + CHUNK_BYTES);
+                continue;
+            }
+        }
+        uint64_t pivot = medianOfThree(chunks[0], chunks[n / 2], chunks[n - 1]);
+
+        // Dijkstra partition: [0, lt) < pivot, [lt, gt) == pivot, [gt, n) > pivot
+        size_t lt = 0;
+        size_t gt = n;
+        size_t i = 0;
+        while (i < gt) {
+            uint64_t c = chunks[i];
+            if (c < pivot) {
+                std::swap(keys[lt], keys[i]);
+                std::swap(chunks[lt++], chunks[i++]);
+            } else if (c > pivot) {
+                --gt;
+                std::swap(keys[i], keys[gt]);
+                std::swap(chunks[i], chunks[gt]);
+            } else {
+                ++i;
+            }
+        }
+
+        struct Part {
+            size_t offset;
+            size_t n;
+            size_t depth;
+            bool cached;
+        };
+        // Strings that ended inside the pivot chunk are all equal, their part is done
+        bool equalDone = chunkCount(pivot) < CHUNK_BYTES;
+        std::array<Part, 3> parts = {Part{0, lt, depth, true},
+                                     Part{lt, equalDone ? 0 : gt - lt, depth + CHUNK_BYTES, false},
+                                     Part{gt, n - gt, depth, true}};
+        std::sort(parts.begin(), parts.end(), [](const Part& a, const Part& b) { return a.n < b.n; });
+        for (int p = 0; p < 2; ++p) {
+            const Part& part = parts[p];
+            multikeyQuickSort(keys + part.offset, chunks + part.offset, part.n, part.depth, part.cached);
+        }
+        keys += parts[2].offset;
+        chunks += parts[2].offset;
+        n = parts[2].n;
+        depth = parts[2].depth;
+        cached = parts[2].cached;
+    }
+    insertionSort(keys, n, depth);
+}
+
+// Bucket of a chunk when distributing on its byte at position (0..6): 0 for strings
+// that ended before it, 1 + the byte otherwise
+inline size_t chunkDigit(uint64_t chunk, size_t position) {
+    return position < chunkCount(chunk) ? ((chunk >> (56 - 8 * position)) & 0xFF) + 1 : 0;
+}
+
+// MSD radix sort of keys that agree on their first depth bytes
+// chunks[i] moves with keys[i] and caches its chunk taken at chunkDepth (<= depth)
+// when cached is set. A pass finds the first byte where the cached chunks differ
+// (bytes shared by all keys are skipped) and distributes keys and chunks into 257
+// buckets on it; the buckets keep using the cached chunks until their 7 bytes are
+// consumed, so most levels do not read the strings at all. keyBuffer / chunkBuffer
+// are scratch space of at least n entries. Every bucket but the largest recurses,
+// the largest is continued by the loop: recursion stays O(log n) deep even when the
+// strings only split off one at a time ("a", "aa", "aaa"...).
+inline void msdRadixSort(StringKey* keys, uint64_t* chunks, size_t n, size_t depth, size_t chunkDepth, bool cached,
+                         StringKey* keyBuffer, uint64_t* chunkBuffer) {
+    while (n >= STRING_RADIX_THRESHOLD) {
+        if (!cached) {
+            for (size_t i = 0; i < n; ++i) chunks[i] = chunkAt(keys[i], depth);
+            chunkDepth = depth;
+            cached = true;
+        }
+
+        uint64_t diff = 0;
+        for (size_t i = 0; i < n; ++i) {
+            diff |= chunks[i] ^ chunks[0];
+        }
+        if (diff == 0) {
+            // One chunk shared by all: equal strings, or skip the whole shared prefix
+            if (chunkCount(chunks[0]) < CHUNK_BYTES) return;
+            depth = sharedDepth(keys, n, chunkDepth + CHUNK_BYTES);
+            cached = false;
+            continue;
+        }
+
+        // First byte position where the keys differ, or where one of them ends
+        size_t position = static_cast<size_t>(std::countl_zero(diff)) / 8;
+        for (size_t i = 0; i < n && position > 0; ++i) {
+            position = std::min(position, chunkCount(chunks[i]));
+        }
+
+        std::array<size_t, 257> counts {};
+        for (size_t i = 0; i < n; ++i) {
+            ++counts[chunkDigit(chunks[i], position)];
+        }
+        std::array<size_t, 257> offsets;
+        size_t sum = 0;
+        for (size_t b = 0; b < 257; ++b) {
+            offsets[b] = sum;
+            sum += counts[b];
+        }
+        for (size_t i = 0; i < n; ++i) {
+            size_t slot = offsets[chunkDigit(chunks[i], position)]++;
+            keyBuffer[slot] = keys[i];
+            chunkBuffer[slot] = chunks[i];
+        }
+        std::memcpy(keys, keyBuffer, n * sizeof(StringKey));
+        std::memcpy(chunks, chunkBuffer, n * sizeof(uint64_t));
+
+        // Bucket 0 holds the strings that ended at chunkDepth + position: all equal
+        size_t largest = 1;
+        for (size_t b = 2; b < 257; ++b) {
+            if (counts[b] > counts[largest]) largest = b;
+        }
+        size_t childDepth = chunkDepth + position + 1;
+        bool childCached = position + 1 < CHUNK_BYTES;
+        size_t start = counts[0];
+        size_t largestStart = 0;
+        for (size_t b = 1; b < 257; ++b) {
+            if (b == largest) {
+                largestStart = start;
+            } else if (counts[b] > 1) {
+                msdRadixSort(keys + start, chunks + start, counts[b], childDepth, chunkDepth, childCached, keyBuffer,
+                             chunkBuffer);
+            }
+            start += counts[b];
+        }
+        keys += largestStart;
+        chunks += largestStart;
+        n = counts[largest];
+        depth = childDepth;
+        cached = childCached;
+    }
+    multikeyQuickSort(keys, chunks, n, depth, cached && depth == chunkDepth);
+}
+
+// Key of the LCP merge sort: lcp is the common prefix length with the previous key
+// of its run, cache its chunk at depth lcp (the first bytes after that prefix)
+struct LcpKey {
+    StringKey key;
+    size_t lcp;
+    uint64_t cache;
+};
+
+// Insertion sort from scratch that also fills the LCPs and caches
+inline void insertionSortLcp(LcpKey* keys, size_t n) {
+    for (size_t i = 1; i < n; ++i) {
+        LcpKey value = keys[i];
+        size_t hole = i;
+        while (hole > 0 && lessFrom(value.key, keys[hole - 1].key, 0)) {
+            keys[hole] = keys[hole - 1];
+            --hole;
+        }
+        keys[hole] = value;
+    }
+    for (size_t i = 0; i < n; ++i) {
+        keys[i].lcp = i == 0 ? 0 : commonPrefix(keys[i - 1].key, keys[i].key, 0);
+        keys[i].cache = chunkAt(keys[i].key, keys[i].lcp);
+    }
+}
+
+// LCP-aware binary merge of the sorted runs a[0..na) and b[0..nb) into out
+// Each head carries h, its LCP with the last output key, and the cached chunk at h.
+// The head sharing the longer prefix with the last output is the smaller one, decided
+// without reading either string. On equal LCPs the cached chunks decide unless they
+// are equal too; only the string that stays behind is read, to refresh its cache.
+// Ties take a first, which keeps the merge stable.
+inline void lcpMerge(const LcpKey* a, size_t na, const LcpKey* b, size_t nb, LcpKey* out) {
+    size_t i = 0;
+    size_t j = 0;
+    LcpKey headA = a[0];
+    LcpKey headB = b[0];
+    headA.lcp = headB.lcp = 0;
+    headA.cache = chunkAt(headA.key, 0);
+    headB.cache = chunkAt(headB.key, 0);
+
+    while (true) {
+        bool takeA;
+        if (headA.lcp != headB.lcp) {
+            takeA = headA.lcp > headB.lcp;
+        } else {
+            size_t h = headA.lcp;
+            size_t l;
+            if (headA.cache != headB.cache) {
+                takeA = headA.cache < headB.cache;
+                l = h + chunkCommonPrefix(headA.cache, headB.cache);
+            } else if (chunkCount(headA.cache) < CHUNK_BYTES) {
+                takeA = true; // Equal strings
+                l = h + chunkCount(headA.cache);
+            } else {
+                l = commonPrefix(headA.key, headB.key, h + CHUNK_BYTES);
+                takeA = l == headA.key.length || (l < headB.key.length && headA.key.data[l] < headB.key.data[l]);
+            }
+            // The loser's LCP with the winner, which becomes the last output
+            LcpKey& loser = takeA ? headB : headA;
+            loser.lcp = l;
+            loser.cache = chunkAt(loser.key, l);
+        }
+
+        if (takeA) {
+            *out++ = headA;
+            if (++i == na) break;
+            headA = a[i];
+        } else {
+            *out++ = headB;
+            if (++j == nb) break;
+            headB = b[j];
+        }
+    }
+
+    // The head of the remaining run keeps its LCP with the last output, the rest their own
+    if (i < na) {
+        *out++ = headA;
+        out = std::copy(a + i + 1, a + na, out);
+    }
+    if (j < nb) {
+        *out++ = headB;
+        std::copy(b + j + 1, b + nb, out);
+    }
+}
+
+// Stable LCP merge sort of keys[0..n); the result is left in keys, or in buffer when
+// toBuffer is set. Each level merges from one array into the other, nothing is copied back.
+inline void lcpMergeSort(LcpKey* keys, LcpKey* buffer, size_t n, bool toBuffer) {
+    if (n <= STRING_INSERTION_THRESHOLD) {
+        insertionSortLcp(keys, n);
+        if (toBuffer) std::copy(keys, keys + n, buffer);
+        return;
+    }
+    size_t mid = n / 2;
+    lcpMergeSort(keys, buffer, mid, !toBuffer);
+    lcpMergeSort(keys + mid, buffer + mid, n - mid, !toBuffer);
+    if (toBuffer) {
+        lcpMerge(keys, mid, keys + mid, n - mid, buffer);
+    } else {
+        lcpMerge(buffer, mid, buffer + mid, n - mid, keys);
+    }
+}
+
+} // namespace detail
+
+// Multikey (three-way radix) quicksort of a range of strings; not stable
+template <StringRange R>
+void multikeyQuickSortAll(R&& strings) {
+    auto keys = detail::makeKeys(strings);
+    if (keys.size() < 2) return;
+    std::vector<uint64_t> chunks(keys.size());
+    detail::multikeyQuickSort(keys.data(), chunks.data(), keys.size(), 0, false);
+    detail::applyKeyOrder(strings, keys);
+}
+
+// MSD radix sort of a range of strings, small buckets by multikey quicksort; not stable
+template <StringRange R>
+void stringRadixSortAll(R&& strings) {
+    auto keys = detail::makeKeys(strings);
+    if (keys.size() < 2) return;
+    std::vector<uint64_t> chunks(keys.size());
+    std::vector<detail::StringKey> keyBuffer(keys.size());
+    std::vector<uint64_t> chunkBuffer(keys.size());
+    detail::msdRadixSort(keys.data(), chunks.data(), keys.size(), 0, 0, false, keyBuffer.data(), chunkBuffer.data());
+    detail::applyKeyOrder(strings, keys);
+}
+
+// Stable LCP merge sort of a range of strings
+// When lcp is given it receives the LCP array of the sorted range:
+// (*lcp)[i] is the length of the common prefix of elements i - 1 and i, (*lcp)[0] is 0.
+template <StringRange R>
+void lcpMergeSortAll(R&& strings, std::vector<size_t>* lcp = nullptr) {
+    std::vector<detail::LcpKey> keys;
+    for (const auto& key : detail::makeKeys(strings)) {
+        keys.push_back({key, 0, 0});
+    }
+    std::vector<detail::LcpKey> buffer(keys.size());
+    detail::lcpMergeSort(keys.data(), buffer.data(), keys.size(), false);
+
+    std::vector<size_t> perm(keys.size());
+    for (size_t i = 0; i < keys.size(); ++i) {
+        perm[i] = keys[i].key.index;
+    }
+    sort_key::applyPermutation(strings, std::move(perm));
+
+    if (lcp) {
+        lcp->resize(keys.size());
+        for (size_t i = 0; i < keys.size(); ++i) {
+            (*lcp)[i] = keys[i].lcp;
+        }
+    }
+}
+
+} // namespace sort_string
+
+} // namespace algolab
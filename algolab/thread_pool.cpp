@@ -0,0 +1 @@
+#include "thread_pool.h"
@@ -0,0 +1,219 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace algolab {
+
+/**
+ * @brief ThreadPool class
+ * @details Work-stealing thread pool used by the multi-threaded algorithms.
+ * Each worker owns a deque of tasks:
+ *  - the owner pushes and pops at the back (LIFO), which keeps recently split
+ *    partitions hot in its cache,
+ *  - idle workers steal from the front (FIFO) of the other deques, which hands
+ *    them the oldest, hence largest, pending pieces of work.
+ * Tasks submitted from outside the pool are spread round-robin over the deques.
+ * A thread blocked in TaskGroup::wait() helps by running pending tasks, so nested
+ * fork/join (a task spawning and waiting on sub-tasks) cannot deadlock.
+ */
+class ThreadPool {
+public:
+    using Task = std::function<void()>;
+
+    explicit ThreadPool(unsigned threadCount = std::thread::hardware_concurrency()) {
+        threadCount = std::max(1u, threadCount);
+        queues_.reserve(threadCount);
+        for (unsigned i = 0; i < threadCount; ++i) {
+            queues_.push_back(std::make_unique<WorkQueue>());
+        }
+        workers_.reserve(threadCount);
+        for (unsigned i = 0; i < threadCount; ++i) {
+            workers_.emplace_back([this, i]() { workerLoop(i); });
+        }
+    }
+
+    ~ThreadPool() {
+        {
+            std::scoped_lock lock(sleepMutex_);
+            stopping_ = true;
+        }
+        sleepCv_.notify_all();
+        // std::jthread joins on destruction, workers drain their queues before leaving
+        workers_.clear();
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    // Process-wide pool sized to the hardware concurrency
+    static ThreadPool& shared() {
+        static ThreadPool pool;
+        return pool;
+    }
+
+    void submit(Task task) {
+        // Count first so that a sleeping worker never misses a task already in a queue
+        pending_.fetch_add(1, std::memory_order_acq_rel);
+
+        unsigned index = (currentPool_ == this)
+            ? currentIndex_
+            : nextQueue_.fetch_add(1, std::memory_order_relaxed) % size();
+        {
+            std::scoped_lock lock(queues_[index]->mutex);
+            queues_[index]->tasks.push_back(std::move(task));
+        }
+        {
+            std::scoped_lock lock(sleepMutex_);
+        }
+        sleepCv_.notify_one();
+    }
+
+    // Runs one pending task on the calling thread, returns false if there was none
+    bool runPendingTask() {
+        Task task;
+        bool found = (currentPool_ == this)
+            ? popTask(currentIndex_, task) || stealTask(currentIndex_, task)
+            : stealTask(0, task);
+        if (found) {
+            task();
+        }
+        return found;
+    }
+
+    unsigned size() const {
+        return static_cast<unsigned>(queues_.size());
+    }
+
+private:
+    struct WorkQueue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    bool popTask(unsigned index, Task& task) {
+        WorkQueue& queue = *queues_[index];
+        std::scoped_lock lock(queue.mutex);
+        if (queue.tasks.empty()) return false;
+        task = std::move(queue.tasks.back());
+        queue.tasks.pop_back();
+        pending_.fetch_sub(1, std::memory_order_acq_rel);
+        return true;
+    }
+
+    // Visits every other queue once, starting next to the thief
+    bool stealTask(unsigned thief, Task& task) {
+        const unsigned n = size();
+        for (unsigned k = 0; k < n; ++k) {
+            WorkQueue& queue = *queues_[(thief + k + 1) % n];
+            std::scoped_lock lock(queue.mutex);
+            if (queue.tasks.empty()) continue;
+            task = std::move(queue.tasks.front());
+            queue.tasks.pop_front();
+            pending_.fetch_sub(1, std::memory_order_acq_rel);
+            return true;
+        }
+        return false;
+    }
+
+    void workerLoop(unsigned index) {
+        currentPool_ = this;
+        currentIndex_ = index;
+
+        while (true) {
+            Task task;
+            if (popTask(index, task) || stealTask(index, task)) {
+                task();
+                continue;
+            }
+
+            std::unique_lock lock(sleepMutex_);
+            sleepCv_.wait(lock, [this]() {
+                return stopping_ || pending_.load(std::memory_order_acquire) > 0;
+            });
+            if (stopping_ && pending_.load(std::memory_order_acquire) == 0) {
+                return;
+            }
+        }
+    }
+
+    std::vector<std::unique_ptr<WorkQueue>> queues_;
+    std::vector<std::jthread> workers_;
+
+    std::mutex sleepMutex_;
+    std::condition_variable sleepCv_;
+    bool stopping_ = false;
+
+    std::atomic<size_t> pending_ {0};
+    std::atomic<unsigned> nextQueue_ {0};
+
+    // Identity of the pool worker running on this thread, if any
+    static inline thread_local ThreadPool* currentPool_ = nullptr;
+    static inline thread_local unsigned currentIndex_ = 0;
+};
+
+/**
+ * @brief TaskGroup class
+ * @details Fork/join helper on top of ThreadPool.
+ * run() may be called from inside running tasks of the same group, wait() returns
+ * once every task of the group (including nested ones) has finished.
+ * The first exception thrown by a task is rethrown by wait().
+ */
+class TaskGroup {
+public:
+    explicit TaskGroup(ThreadPool& pool) : pool_(pool) {}
+
+    ~TaskGroup() {
+        while (pending_.load(std::memory_order_acquire) > 0) {
+            if (!pool_.runPendingTask()) std::this_thread::yield();
+        }
+    }
+
+    TaskGroup(const TaskGroup&) = delete;
+    TaskGroup& operator=(const TaskGroup&) = delete;
+
+    void run(ThreadPool::Task task) {
+        pending_.fetch_add(1, std::memory_order_acq_rel);
+        pool_.submit([this, task = std::move(task)]() {
+            try {
+                task();
+            } catch (...) {
+                std::scoped_lock lock(errorMutex_);
+                if (!error_) error_ = std::current_exception();
+            }
+            pending_.fetch_sub(1, std::memory_order_acq_rel);
+        });
+    }
+
+    void wait() {
+        while (pending_.load(std::memory_order_acquire) > 0) {
+            if (!pool_.runPendingTask()) std::this_thread::yield();
+        }
+        std::scoped_lock lock(errorMutex_);
+        if (error_) {
+            std::rethrow_exception(std::exchange(error_, nullptr));
+        }
+    }
+
+    ThreadPool& pool() const {
+        return pool_;
+    }
+
+private:
+    ThreadPool& pool_;
+    std::atomic<size_t> pending_ {0};
+    std::mutex errorMutex_;
+    std::exception_ptr error_;
+};
+
+} // namespace algolab
@@ -0,0 +1 @@
+#include "timsort.h"
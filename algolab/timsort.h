@@ -0,0 +1,461 @@
+#pragma once
+
+#include <vector>
+#include <algorithm>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+
+namespace algolab {
+
+/**
+ * @brief Timsort: adaptive, stable natural merge sort
+ * @details
+ * Unlike mergeSortAll, which always performs log n passes, Timsort builds on the
+ * order already present in the input:
+ *  - natural runs (non-descending, or strictly descending which are reversed in place)
+ *    are detected left to right; runs shorter than minRun are extended with binary
+ *    insertion sort,
+ *  - runs are pushed on a stack whose lengths keep the invariants
+ *        len[i - 2] > len[i - 1] + len[i]  and  len[i - 1] > len[i],
+ *    so merges stay balanced and the stack is O(log n) deep,
+ *  - merges first trim the prefix / suffix already in place, copy only the shorter run
+ *    to the scratch buffer, and switch to galloping (exponential + binary search) when
+ *    one run keeps winning, adapting the MIN_GALLOP threshold as they go.
+ * A presorted or reversed input is one run and costs n - 1 comparisons; k concatenated
+ * sorted runs cost O(n log k).
+ * Reference: Tim Peters, listsort.txt (CPython), with the corrected merge invariant of
+ * de Gouw et al., "OpenJDK's java.utils.Collection.sort() is broken" (2015).
+ */
+
+namespace sort_custom {
+
+constexpr int TIMSORT_MIN_MERGE = 32;
+constexpr int TIMSORT_MIN_GALLOP = 7;
+
+// Minimum run length: n / minRun is a power of two or slightly less, minRun in [16, 32]
+inline int computeMinRun(int n) {
+    int r = 0;
+    while (n >= TIMSORT_MIN_MERGE) {
+        r |= n & 1;
+        n >>= 1;
+    }
+    return n + r;
+}
+
+// Length of the run starting at arr[low], high exclusive
+// A strictly descending run is reversed; strictness keeps the sort stable.
+template <typename T>
+int countRunAndMakeAscending(std::vector<T>& arr, int low, int high) {
+    int runHigh = low + 1;
+    if (runHigh == high) return 1;
+
+    if (arr[runHigh++] < arr[low]) {
+        while (runHigh < high && arr[runHigh] < arr[runHigh - 1]) ++runHigh;
+        std::reverse(arr.begin() + low, arr.begin() + runHigh);
+    } else {
+        while (runHigh < high && !(arr[runHigh] < arr[runHigh - 1])) ++runHigh;
+    }
+    return runHigh - low;
+}
+
+// Binary insertion sort of arr[low..high), arr[low..start) being already sorted
+template <typename T>
+void binaryInsertionSort(std::vector<T>& arr, int low, int high, int start) {
+    if (start == low) ++start;
+    for (; start < high; ++start) {
+        T pivot = std::move(arr[start]);
+        // Upper bound keeps equal keys in their original order
+        int left = low;
+        int right = start;
+        while (left < right) {
+            int mid = left + (right - left) / 2;
+            if (pivot < arr[mid]) {
+                right = mid;
+            } else {
+                left = mid + 1;
+            }
+        }
+        std::move_backward(arr.begin() + left, arr.begin() + start, arr.begin() + start + 1);
+        arr[left] = std::move(pivot);
+    }
+}
+
+// Next offset of the exponential search, clamped to maxOffset without overflowing
+inline int nextGallopOffset(int offset, int maxOffset) {
+    return offset > maxOffset / 2 ? maxOffset : 2 * offset + 1;
+}
+
+// Position where key goes in the sorted run[0..len), before any equal element
+// The search starts at hint and gallops outwards before the final binary search.
+template <typename T>
+int gallopLeft(const T& key, const T* run, int len, int hint) {
+    int lastOffset = 0;
+    int offset = 1;
+    if (run[hint] < key) {
+        // run[hint] < key: gallop right until run[hint + lastOffset] < key <= run[hint + offset]
+        int maxOffset = len - hint;
+        while (offset < maxOffset && run[hint + offset] < key) {
+            lastOffset = offset;
+            offset = nextGallopOffset(offset, maxOffset);
+        }
+        offset = std::min(offset, maxOffset);
+        lastOffset += hint;
+        offset += hint;
+    } else {
+        // key <= run[hint]: gallop left until run[hint - offset] < key <= run[hint - lastOffset]
+        int maxOffset = hint + 1;
+        while (offset < maxOffset && !(run[hint - offset] < key)) {
+            lastOffset = offset;
+            offset = nextGallopOffset(offset, maxOffset);
+        }
+        offset = std::min(offset, maxOffset);
+        int tmp = lastOffset;
+        lastOffset = hint - offset;
+        offset = hint - tmp;
+    }
+
+    // run[lastOffset] < key <= run[offset]
+    ++lastOffset;
+    while (lastOffset < offset) {
+        int mid = lastOffset + (offset - lastOffset) / 2;
+        if (run[mid] < key) {
+            lastOffset = mid + 1;
+        } else {
+            offset = mid;
+        }
+    }
+    return offset;
+}
+
+// Position where key goes in the sorted run[0..len), after any equal element
+template <typename T>
+int gallopRight(const T& key, const T* run, int len, int hint) {
+    int lastOffset = 0;
+    int offset = 1;
+    if (key < run[hint]) {
+        // Gallop left until run[hint - offset] <= key < run[hint - lastOffset]
+        int maxOffset = hint + 1;
+        while (offset < maxOffset && key < run[hint - offset]) {
+            lastOffset = offset;
+            offset = nextGallopOffset(offset, maxOffset);
+        }
+        offset = std::min(offset, maxOffset);
+        int tmp = lastOffset;
+        lastOffset = hint - offset;
+        offset = hint - tmp;
+    } else {
+        // Gallop right until run[hint + lastOffset] <= key < run[hint + offset]
+        int maxOffset = len - hint;
+        while (offset < maxOffset && !(key < run[hint + offset])) {
+            lastOffset = offset;
+            offset = nextGallopOffset(offset, maxOffset);
+        }
+        offset = std::min(offset, maxOffset);
+        lastOffset += hint;
+        offset += hint;
+    }
+
+    // run[lastOffset] <= key < run[offset]
+    ++lastOffset;
+    while (lastOffset < offset) {
+        int mid = lastOffset + (offset - lastOffset) / 2;
+        if (key < run[mid]) {
+            offset = mid;
+        } else {
+            lastOffset = mid + 1;
+        }
+    }
+    return offset;
+}
+
+/**
+ * @brief Run stack and merge state of one timSortAll call
+ * @details The scratch buffer only ever holds the shorter run of a merge and is
+ * reused across merges.
+ */
+template <typename T>
+class TimSort {
+public:
+    explicit TimSort(std::vector<T>& arr) : arr_(arr) {}
+
+    void pushRun(int base, int len) {
+        runBase_.push_back(base);
+        runLen_.push_back(len);
+    }
+
+    // Merges runs until the stack invariants hold again
+    void mergeCollapse() {
+        while (runLen_.size() > 1) {
+            int k = static_cast<int>(runLen_.size()) - 2;
+            if ((k > 0 && runLen_[k - 1] <= runLen_[k] + runLen_[k + 1])
+                || (k > 1 && runLen_[k - 2] <= runLen_[k - 1] + runLen_[k])) {
+                if (runLen_[k - 1] < runLen_[k + 1]) --k;
+            } else if (runLen_[k] > runLen_[k + 1]) {
+                break;
+            }
+            mergeAt(k);
+        }
+    }
+
+    // Merges all remaining runs, at the end of the input
+    void mergeForceCollapse() {
+        while (runLen_.size() > 1) {
+            int k = static_cast<int>(runLen_.size()) - 2;
+            if (k > 0 && runLen_[k - 1] < runLen_[k + 1]) --k;
+            mergeAt(k);
+        }
+    }
+
+private:
+    // Merges the runs at stack positions i and i + 1
+    void mergeAt(int i) {
+        int base1 = runBase_[i];
+        int len1 = runLen_[i];
+        int base2 = runBase_[i + 1];
+        int len2 = runLen_[i + 1];
+
+        runLen_[i] = len1 + len2;
+        if (i == static_cast<int>(runLen_.size()) - 3) {
+            runBase_[i + 1] = runBase_[i + 2];
+            runLen_[i + 1] = runLen_[i + 2];
+        }
+        runBase_.pop_back();
+        runLen_.pop_back();
+
+        // Elements of run1 not greater than run2's first are already in place
+        int k = gallopRight(arr_[base2], arr_.data() + base1, len1, 0);
+        base1 += k;
+        len1 -= k;
+        if (len1 == 0) return;
+
+        // Elements of run2 not smaller than run1's last are already in place
+        len2 = gallopLeft(arr_[base1 + len1 - 1], arr_.data() + base2, len2, len2 - 1);
+        if (len2 == 0) return;
+
+        if (len1 <= len2) {
+            mergeLow(base1, len1, base2, len2);
+        } else {
+            mergeHigh(base1, len1, base2, len2);
+        }
+    }
+
+    // Merges left to right with run1 in the scratch buffer, len1 <= len2
+    // Preconditions from mergeAt: arr[base2] < arr[base1] and run1's last > run2's last.
+    void mergeLow(int base1, int len1, int base2, int len2) {
+        T* a = arr_.data();
+        tmp_.assign(std::make_move_iterator(a + base1), std::make_move_iterator(a + base1 + len1));
+        T* t = tmp_.data();
+
+        int cursor1 = 0;
+        int cursor2 = base2;
+        int dest = base1;
+
+        a[dest++] = std::move(a[cursor2++]);
+        if (--len2 == 0) {
+            std::move(t, t + len1, a + dest);
+            return;
+        }
+        if (len1 == 1) {
+            std::move(a + cursor2, a + cursor2 + len2, a + dest);
+            a[dest + len2] = std::move(t[cursor1]);
+            return;
+        }
+
+        int minGallop = minGallop_;
+        bool done = false;
+        while (!done) {
+            int count1 = 0; // consecutive wins of run1
+            int count2 = 0; // consecutive wins of run2
+
+            // One element at a time until a run starts winning consistently
+            do {
+                if (a[cursor2] < t[cursor1]) {
+                    a[dest++] = std::move(a[cursor2++]);
+                    ++count2;
+                    count1 = 0;
+                    if (--len2 == 0) { done = true; break; }
+                } else {
+                    a[dest++] = std::move(t[cursor1++]);
+                    ++count1;
+                    count2 = 0;
+                    if (--len1 == 1) { done = true; break; }
+                }
+            } while ((count1 | count2) < minGallop);
+            if (done) break;
+
+            // Galloping: move whole blocks while they stay long enough to pay off
+            do {
+                count1 = gallopRight(a[cursor2], t + cursor1, len1, 0);
+                if (count1 != 0) {
+                    std::move(t + cursor1, t + cursor1 + count1, a + dest);
+                    dest += count1;
+                    cursor1 += count1;
+                    len1 -= count1;
+                    if (len1 <= 1) { done = true; break; }
+                }
+                a[dest++] = std::move(a[cursor2++]);
+                if (--len2 == 0) { done = true; break; }
+
+                count2 = gallopLeft(t[cursor1], a + cursor2, len2, 0);
+                if (count2 != 0) {
+                    std::move(a + cursor2, a + cursor2 + count2, a + dest);
+                    dest += count2;
+                    cursor2 += count2;
+                    len2 -= count2;
+                    if (len2 == 0) { done = true; break; }
+                }
+                a[dest++] = std::move(t[cursor1++]);
+                if (--len1 == 1) { done = true; break; }
+
+                --minGallop;
+            } while (count1 >= TIMSORT_MIN_GALLOP || count2 >= TIMSORT_MIN_GALLOP);
+            if (done) break;
+
+            // Leaving gallop mode is penalised so that it is entered less eagerly
+            minGallop = std::max(minGallop, 0) + 2;
+        }
+        minGallop_ = std::max(minGallop, 1);
+
+        if (len1 == 1) {
+            std::move(a + cursor2, a + cursor2 + len2, a + dest);
+            a[dest + len2] = std::move(t[cursor1]);
+        } else if (len1 == 0) {
+            throw std::invalid_argument("timSortAll: operator< is not a strict weak ordering");
+        } else {
+            std::move(t + cursor1, t + cursor1 + len1, a + dest);
+        }
+    }
+
+    // Merges right to left with run2 in the scratch buffer, len1 > len2
+    void mergeHigh(int base1, int len1, int base2, int len2) {
+        T* a = arr_.data();
+        tmp_.assign(std::make_move_iterator(a + base2), std::make_move_iterator(a + base2 + len2));
+        T* t = tmp_.data();
+
+        int cursor1 = base1 + len1 - 1;
+        int cursor2 = len2 - 1;
+        int dest = base2 + len2 - 1;
+
+        a[dest--] = std::move(a[cursor1--]);
+        if (--len1 == 0) {
+            std::move(t, t + len2, a + dest - (len2 - 1));
+            return;
+        }
+        if (len2 == 1) {
+            dest -= len1;
+            cursor1 -= len1;
+            std::move_backward(a + cursor1 + 1, a + cursor1 + 1 + len1, a + dest + 1 + len1);
+            a[dest] = std::move(t[cursor2]);
+            return;
+        }
+
+        int minGallop = minGallop_;
+        bool done = false;
+        while (!done) {
+            int count1 = 0;
+            int count2 = 0;
+
+            do {
+                if (t[cursor2] < a[cursor1]) {
+                    a[dest--] = std::move(a[cursor1--]);
+                    ++count1;
+                    count2 = 0;
+                    if (--len1 == 0) { done = true; break; }
+                } else {
+                    a[dest--] = std::move(t[cursor2--]);
+                    ++count2;
+                    count1 = 0;
+                    if (--len2 == 1) { done = true; break; }
+                }
+            } while ((count1 | count2) < minGallop);
+            if (done) break;
+
+            do {
+                count1 = len1 - gallopRight(t[cursor2], a + base1, len1, len1 - 1);
+                if (count1 != 0) {
+                    dest -= count1;
+                    cursor1 -= count1;
+                    len1 -= count1;
+                    std::move_backward(a + cursor1 + 1, a + cursor1 + 1 + count1, a + dest + 1 + count1);
+                    if (len1 == 0) { done = true; break; }
+                }
+                a[dest--] = std::move(t[cursor2--]);
+                if (--len2 == 1) { done = true; break; }
+
+                count2 = len2 - gallopLeft(a[cursor1], t, len2, len2 - 1);
+                if (count2 != 0) {
+                    dest -= count2;
+                    cursor2 -= count2;
+                    len2 -= count2;
+                    std::move(t + cursor2 + 1, t + cursor2 + 1 + count2, a + dest + 1);
+                    if (len2 <= 1) { done = true; break; }
+                }
+                a[dest--] = std::move(a[cursor1--]);
+                if (--len1 == 0) { done = true; break; }
+
+                --minGallop;
+            } while (count1 >= TIMSORT_MIN_GALLOP || count2 >= TIMSORT_MIN_GALLOP);
+            if (done) break;
+
+            minGallop = std::max(minGallop, 0) + 2;
+        }
+        minGallop_ = std::max(minGallop, 1);
+
+        if (len2 == 1) {
+            dest -= len1;
+            cursor1 -= len1;
+            std::move_backward(a + cursor1 + 1, a + cursor1 + 1 + len1, a + dest + 1 + len1);
+            a[dest] = std::move(t[cursor2]);
+        } else if (len2 == 0) {
+            throw std::invalid_argument("timSortAll: operator< is not a strict weak ordering");
+        } else {
+            std::move(t, t + len2, a + dest - (len2 - 1));
+        }
+    }
+
+    std::vector<T>& arr_;
+    std::vector<T> tmp_;
+    std::vector<int> runBase_;
+    std::vector<int> runLen_;
+    int minGallop_ = TIMSORT_MIN_GALLOP;
+};
+
+// Public interface
+template <typename T>
+void timSortAll(std::vector<T>& arr) {
+    int n = static_cast<int>(arr.size());
+    if (n < 2) return;
+
+    // Small inputs: one binary insertion sort after the leading run
+    if (n < TIMSORT_MIN_MERGE) {
+        int runLen = countRunAndMakeAscending(arr, 0, n);
+        binaryInsertionSort(arr, 0, n, runLen);
+        return;
+    }
+
+    TimSort<T> state(arr);
+    const int minRun = computeMinRun(n);
+    int low = 0;
+    int remaining = n;
+    do {
+        int runLen = countRunAndMakeAscending(arr, low, n);
+        if (runLen < minRun) {
+            int forced = std::min(remaining, minRun);
+            binaryInsertionSort(arr, low, low + forced, low + runLen);
+            runLen = forced;
+        }
+
+        state.pushRun(low, runLen);
+        state.mergeCollapse();
+
+        low += runLen;
+        remaining -= runLen;
+    } while (remaining != 0);
+
+    state.mergeForceCollapse();
+}
+
+} // namespace sort_custom
+
+} // namespace algolab
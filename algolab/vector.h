@@ -1,16 +1,45 @@
 #pragma once
 
 #include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <cmath>
+#include <cstddef>
 #include <iostream>
 #include <stdexcept>
 #include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
 #include <iterator>
 #include <algorithm> // For std::copy
 #include <numeric>   // For std::accumulate
+#include <vector>
+#include "selection.h"
 
 namespace algolab {
 
-// class template for Vector using Value Storage
+// Types whose objects can be moved to new storage with memcpy (and the old bytes
+// dropped without running a destructor). Trivially copyable types always can;
+// specialize for other types that hold no pointer into themselves.
+template <class T>
+struct is_trivially_relocatable : std::is_trivially_copyable<T> {};
+
+template <class T>
+constexpr bool is_trivially_relocatable_v = is_trivially_relocatable<T>::value;
+
+/**
+ * @brief Vector class
+ * @details Class template for Vector using Value Storage.
+ * Elements live in raw, uninitialized storage: only the first size() slots hold
+ * objects, which are constructed in place by push_back / emplace_back and destroyed
+ * by pop_back, erase, clear and the destructor. An empty Vector allocates its
+ * capacity but constructs nothing.
+ * When the storage grows, elements are moved to the new block with
+ * std::move_if_noexcept (copied if their move constructor may throw, so a failed
+ * reallocation leaves the Vector unchanged). Trivially relocatable types skip the
+ * element loop: the block is grown with realloc, or copied with memcpy.
+ */
 template <class T>
 class Vector {
 private:
@@ -19,27 +48,34 @@ private:
     uint32_t num_elements_;
     uint8_t capacityMethod_;
 
+    // realloc and free only apply to blocks from malloc, which is aligned for any fundamental type
+    static constexpr bool MALLOC_STORAGE = alignof(T) <= alignof(std::max_align_t);
+
 public:
     static constexpr uint32_t DEFAULT_CAPACITY = 1741;
 
     static constexpr uint8_t DEFAULT_CAPACITY_METHOD = 1; // Double
     static constexpr uint8_t LOG_CAPACITY_METHOD = 2; // Log
 
-    constexpr explicit Vector(const uint32_t capacity = DEFAULT_CAPACITY, const uint8_t capacityMethod = DEFAULT_CAPACITY_METHOD) 
-        : ptr_(new T[capacity]), capacity_(capacity), num_elements_(0), capacityMethod_(capacityMethod) {
+    explicit Vector(const uint32_t capacity = DEFAULT_CAPACITY, const uint8_t capacityMethod = DEFAULT_CAPACITY_METHOD) 
+        : ptr_(allocate(capacity)), capacity_(capacity), num_elements_(0), capacityMethod_(capacityMethod) {
     }
 
     virtual ~Vector() {
-        if (ptr_ != nullptr) {
-            delete [] ptr_;
-            ptr_ = nullptr;
-        }
+        destroyAll();
+        deallocate(ptr_);
+        ptr_ = nullptr;
     }
 
     Vector(const Vector<T>& other) 
-        : ptr_(new T[other.capacity_]), capacity_(other.capacity_), num_elements_(other.num_elements_), capacityMethod_(other.capacityMethod_) {
-        
-        std::copy(other.begin(), other.end(), begin());
+        : ptr_(allocate(other.capacity_)), capacity_(other.capacity_), num_elements_(0), capacityMethod_(other.capacityMethod_) {
+        try {
+            std::uninitialized_copy(other.begin(), other.end(), ptr_);
+        } catch (...) {
+            deallocate(ptr_);
+            throw;
+        }
+        num_elements_ = other.num_elements_;
     }
     
     Vector(Vector<T>&& other) noexcept 
@@ -50,21 +86,19 @@ public:
         other.capacity_ = 0;
     }
 
+    // Copy and swap: a throwing element copy leaves this Vector unchanged
     Vector<T>& operator=(const Vector<T>& other) {
         if (this != &other) {
-            delete[] ptr_;
-            ptr_ = new T[other.capacity_];
-            num_elements_ = other.num_elements_;
-            capacity_ = other.capacity_;
-            capacityMethod_ = other.capacityMethod_;
-            std::copy(other.begin(), other.end(), begin());
+            Vector<T> copy(other);
+            swap(copy);
         }
         return *this;
     }
 
     Vector<T>& operator=(Vector<T>&& other) noexcept {
         if (this != &other) {
-            delete [] ptr_;
+            destroyAll();
+            deallocate(ptr_);
             ptr_ = other.ptr_;
             num_elements_ = other.num_elements_;
             capacity_ = other.capacity_;
@@ -108,30 +142,26 @@ public:
     }
 
     void push_back(const T& key) {
-        if (num_elements_ >= capacity_) {
-            resize();
-        }
-        ptr_[num_elements_++] = key;
+        emplace_back(key);
     }
 
     void push_back(T&& value) {
-        if (num_elements_ >= capacity_) {
-            resize();
-        }
-        ptr_[num_elements_++] = std::move(value);
+        emplace_back(std::move(value));
     }
 
     template<typename... Args>
     void emplace_back(Args&&... args) {
-        if (num_elements_ >= capacity_) {
-            resize();
+        if (num_elements_ < capacity_) {
+            std::construct_at(ptr_ + num_elements_, std::forward<Args>(args)...);
+        } else {
+            growAndEmplace(std::forward<Args>(args)...);
         }
-        new (&ptr_[num_elements_++]) T(std::forward<Args>(args)...);
+        ++num_elements_;
     }
 
     void pop_back() {
         if (num_elements_ > 0) {
-            --num_elements_;
+            std::destroy_at(ptr_ + --num_elements_);
         }
     }
 
@@ -146,14 +176,12 @@ public:
         if (index >= num_elements_) {
             throw std::out_of_range("Index out of range");
         }
-        for (uint32_t i = index; i < num_elements_ - 1; ++i) {
-            ptr_[i] = ptr_[i + 1];
-        }
-        --num_elements_;
+        std::move(ptr_ + index + 1, ptr_ + num_elements_, ptr_ + index);
+        pop_back();
     }
 
     void clear() {
-        num_elements_ = 0;
+        destroyAll();
     }
 
     void swap(Vector<T>& other) noexcept {
@@ -168,12 +196,26 @@ public:
         reallocate(newCapacity);
     }
 
+    // Moves the elements to a block of newCapacity slots, newCapacity >= size()
     void reallocate(uint32_t newCapacity) {
-        T* newData = new T[newCapacity];
-        for (size_t i = 0; i < num_elements_; ++i) {
-            newData[i] = std::move(ptr_[i]);
+        if constexpr (is_trivially_relocatable_v<T> && MALLOC_STORAGE) {
+            if (ptr_ != nullptr && newCapacity > 0) {
+                // The allocator may extend the block in place, or copies the bytes itself
+                void* grown = std::realloc(ptr_, sizeof(T) * newCapacity);
+                if (grown == nullptr) throw std::bad_alloc();
+                ptr_ = static_cast<T*>(grown);
+                capacity_ = newCapacity;
+                return;
+            }
+        }
+        T* newData = allocate(newCapacity);
+        try {
+            relocate(ptr_, num_elements_, newData);
+        } catch (...) {
+            deallocate(newData);
+            throw;
         }
-        delete [] ptr_;
+        deallocate(ptr_);
         ptr_ = newData;
         capacity_ = newCapacity;
     }
@@ -193,19 +235,22 @@ public:
     }
 
     // Compute the median of elements
+    // Selects on a copy with sort_select::nthElement in O(n), the vector keeps its order
     double median() const {
         if (num_elements_ == 0) {
             throw std::runtime_error("Cannot compute median of an empty vector");
         }
-        std::vector<T> sorted(begin(), end());
-        std::sort(sorted.begin(), sorted.end());
+        std::vector<T> copy(begin(), end());
+        return medianOf(copy.data(), copy.data() + copy.size());
+    }
 
-        size_t middle = num_elements_ / 2;
-        if (num_elements_ % 2 == 0) {
-            return (sorted[middle - 1] + sorted[middle]) / 2.0;
-        } else {
-            return sorted[middle];
+    // Same as median() without the copy: the middle element(s) are selected in place
+    // and the order of the elements is not preserved
+    double medianInPlace() {
+        if (num_elements_ == 0) {
+            throw std::runtime_error("Cannot compute median of an empty vector");
         }
+        return medianOf(begin(), end());
     }
 
     // Iterators
@@ -220,18 +265,104 @@ public:
     }    
 
 private:
-    // Resize based on capacity method
-    void resize() {
-        uint32_t newCapacity;
-        if (capacityMethod_ == LOG_CAPACITY_METHOD) {
-            newCapacity = capacity_ + static_cast<uint32_t>(std::log2(capacity_));
-        } else {
-            newCapacity = capacity_ == 0 ? 1 : capacity_ * 2;
+    // Median of [first, last), reordering the range
+    static double medianOf(T* first, T* last) {
+        size_t n = static_cast<size_t>(last - first);
+        T* middle = first + n / 2;
+        sort_select::nthElement(first, middle, last);
+        if (n % 2 == 0) {
+            // The lower middle is the largest element left of the upper one
+            return (*std::max_element(first, middle) + *middle) / 2.0;
         }
+        return *middle;
+    }
+
+    // Next capacity based on capacity method (the log method grows by at least one slot)
+    uint32_t grownCapacity() const {
         if (capacity_ > UINT32_MAX / 2) {
             throw std::overflow_error("Exceeded max vector capacity");
         }
-        reserve(newCapacity);
+        if (capacityMethod_ == LOG_CAPACITY_METHOD) {
+            return capacity_ + std::max(1u, static_cast<uint32_t>(std::log2(std::max(capacity_, 1u))));
+        }
+        return capacity_ == 0 ? 1 : capacity_ * 2;
+    }
+
+    // Slow path of emplace_back: the new element is built in the new block before the
+    // old elements move, so args may refer to an element of this Vector
+    template<typename... Args>
+    void growAndEmplace(Args&&... args) {
+        const uint32_t newCapacity = grownCapacity();
+        if constexpr (is_trivially_relocatable_v<T> && MALLOC_STORAGE) {
+            // realloc may free the old block: build the element out of it first
+            T value(std::forward<Args>(args)...);
+            reallocate(newCapacity);
+            std::construct_at(ptr_ + num_elements_, std::move(value));
+        } else {
+            T* newData = allocate(newCapacity);
+            try {
+                std::construct_at(newData + num_elements_, std::forward<Args>(args)...);
+            } catch (...) {
+                deallocate(newData);
+                throw;
+            }
+            try {
+                relocate(ptr_, num_elements_, newData);
+            } catch (...) {
+                std::destroy_at(newData + num_elements_);
+                deallocate(newData);
+                throw;
+            }
+            deallocate(ptr_);
+            ptr_ = newData;
+            capacity_ = newCapacity;
+        }
+    }
+
+    // Moves (or copies, when moving may throw) the count objects at from to the raw
+    // storage at to, then destroys them at from. If a copy throws, from is untouched.
+    static void relocate(T* from, uint32_t count, T* to) {
+        if (count == 0) return;
+        if constexpr (is_trivially_relocatable_v<T>) {
+            std::memcpy(static_cast<void*>(to), static_cast<const void*>(from), sizeof(T) * count);
+        } else {
+            uint32_t built = 0;
+            try {
+                for (; built < count; ++built) {
+                    std::construct_at(to + built, std::move_if_noexcept(from[built]));
+                }
+            } catch (...) {
+                std::destroy(to, to + built);
+                throw;
+            }
+            std::destroy(from, from + count);
+        }
+    }
+
+    void destroyAll() noexcept {
+        std::destroy(ptr_, ptr_ + num_elements_);
+        num_elements_ = 0;
+    }
+
+    // Raw storage for capacity objects, none of them constructed
+    static T* allocate(uint32_t capacity) {
+        if (capacity == 0) return nullptr;
+        if constexpr (MALLOC_STORAGE) {
+            void* block = std::malloc(sizeof(T) * capacity);
+            if (block == nullptr) throw std::bad_alloc();
+            return static_cast<T*>(block);
+        } else {
+            return static_cast<T*>(::operator new(sizeof(T) * capacity, std::align_val_t(alignof(T))));
+        }
+    }
+
+    static void deallocate(T* block) noexcept {
+        if (block == nullptr) return;
+        if constexpr (MALLOC_STORAGE) {
+            std::free(block);
+        } else {
+            ::operator delete(block, std::align_val_t(alignof(T)));
+        }
     }
 };
 
@@ -0,0 +1,175 @@
+#include <gtest/gtest.h>
+#include <iostream>
+#include <chrono>
+#include <vector>
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <numeric>
+#include <string>
+#include "sort.h"
+#include "sort_ranges.h"
+#include "argsort.h"
+#include "vector.h"
+
+/**
+ * @brief ArgsortTest class
+ * @details Test fixture for argsort, applyPermutation and sortByKey (algolab::sort_key)
+ * Uses 128-byte quote records, where moving whole records during the sort dominates,
+ * and compares sortByKey with introsorting the records themselves.
+ */
+namespace {
+
+struct WideQuote {
+    double price;
+    int32_t venue;
+    uint32_t seq;
+    char payload[112];
+};
+
+static_assert(sizeof(WideQuote) == 128);
+
+} // namespace
+
+class ArgsortTest : public ::testing::Test {
+protected:
+    static constexpr int N = 1000000;
+
+    static std::vector<WideQuote> quotes(int n) {
+        auto prices = algolab::generateRandomNumbers<int>(n, 0, 100000);
+        auto venues = algolab::generateRandomNumbers<int>(n, 0, 50);
+        std::vector<WideQuote> result(n);
+        for (int i = 0; i < n; ++i) {
+            result[i].price = prices[i] / 100.0;
+            result[i].venue = venues[i];
+            result[i].seq = static_cast<uint32_t>(i);
+            result[i].payload[0] = static_cast<char>(i);
+        }
+        return result;
+    }
+
+    static double timeMs(const std::function<void()>& func) {
+        auto start = std::chrono::high_resolution_clock::now();
+        func();
+        auto end = std::chrono::high_resolution_clock::now();
+        return std::chrono::duration<double, std::milli>(end - start).count();
+    }
+};
+
+TEST_F(ArgsortTest, ArgsortReturnsSortingPermutation) {
+    std::vector<int> values = {40, 10, 30, 10, 20};
+    EXPECT_EQ(algolab::sort_key::argsort(values), (std::vector<size_t>{1, 3, 4, 2, 0}));
+    EXPECT_EQ(algolab::sort_key::argsort(values, std::ranges::greater{}), (std::vector<size_t>{0, 2, 4, 1, 3}));
+
+    std::vector<std::string> words = {"pear", "apple", "fig"};
+    EXPECT_EQ(algolab::sort_key::argsort(words), (std::vector<size_t>{1, 2, 0}));
+    EXPECT_TRUE(algolab::sort_key::argsort(std::vector<int>{}).empty());
+}
+
+TEST_F(ArgsortTest, ArgsortIsStableForPackedAndPairedKeys) {
+    auto data = quotes(100000);
+
+    // int venue: packed radix path; double price: (key, index) pair path
+    for (auto perm : {algolab::sort_key::argsort(data, {}, &WideQuote::venue),
+                      algolab::sort_key::argsort(data, {}, &WideQuote::price)}) {
+        std::vector<size_t> check = perm;
+        std::sort(check.begin(), check.end());
+        std::vector<size_t> identity(data.size());
+        std::iota(identity.begin(), identity.end(), size_t(0));
+        ASSERT_EQ(check, identity);
+    }
+
+    auto perm = algolab::sort_key::argsort(data, {}, &WideQuote::venue);
+    for (size_t i = 1; i < perm.size(); ++i) {
+        const auto& a = data[perm[i - 1]];
+        const auto& b = data[perm[i]];
+        ASSERT_LE(a.venue, b.venue);
+        if (a.venue == b.venue) {
+            ASSERT_LT(a.seq, b.seq);
+        }
+    }
+}
+
+TEST_F(ArgsortTest, ApplyPermutationGathersInPlace) {
+    std::vector<std::string> words = {"d", "b", "a", "e", "c"};
+    algolab::sort_key::applyPermutation(words, {2, 1, 4, 0, 3});
+    EXPECT_EQ(words, (std::vector<std::string>{"a", "b", "c", "d", "e"}));
+
+    algolab::Vector<int> vec;
+    for (int v : {30, 10, 20}) vec.push_back(v);
+    algolab::sort_key::applyPermutation(vec, algolab::sort_key::argsort(vec));
+    EXPECT_EQ(vec[0], 10);
+    EXPECT_EQ(vec[1], 20);
+    EXPECT_EQ(vec[2], 30);
+
+    std::vector<int> values = {1, 2, 3};
+    EXPECT_THROW(algolab::sort_key::applyPermutation(values, {0, 1}), std::invalid_argument);
+    EXPECT_THROW(algolab::sort_key::applyPermutation(values, {1, 1, 0}), std::invalid_argument);
+    EXPECT_THROW(algolab::sort_key::applyPermutation(values, {0, 5, 1}), std::invalid_argument);
+}
+
+// An invalid permutation must not lose records, whichever step it fails at
+TEST_F(ArgsortTest, ApplyPermutationKeepsRecordsOnInvalidPermutation) {
+    const std::vector<std::string> input = {"alpha", "beta", "gamma", "delta", "epsilon"};
+    const std::vector<std::vector<size_t>> invalid = {
+        {1, 1, 2, 3, 4}, {1, 2, 0, 3, 9}, {3, 0, 1, 2, 2}, {4, 2, 1, 0, 1}, {0, 2, 3, 1, 1}};
+    for (const auto& perm : invalid) {
+        std::vector<std::string> words = input;
+        EXPECT_THROW(algolab::sort_key::applyPermutation(words, perm), std::invalid_argument);
+        std::vector<std::string> sorted = words;
+        std::vector<std::string> expected = input;
+        std::sort(sorted.begin(), sorted.end());
+        std::sort(expected.begin(), expected.end());
+        EXPECT_EQ(sorted, expected);
+    }
+}
+
+// -0.0 and +0.0 compare equal, so both radix paths keep their input order
+TEST_F(ArgsortTest, SignedZerosKeepInputOrder) {
+    struct Rec {
+        double key;
+        float narrow;
+        char tag;
+    };
+    std::vector<Rec> recs = {{0.0, 0.0f, 'a'}, {-0.0, -0.0f, 'b'}, {1.0, 1.0f, 'c'}, {-0.0, -0.0f, 'd'}, {0.0, 0.0f, 'e'}};
+    const std::vector<size_t> expected = {0, 1, 3, 4, 2};
+    EXPECT_EQ(algolab::sort_key::argsort(recs, {}, &Rec::key), expected);
+    EXPECT_EQ(algolab::sort_key::argsort(recs, {}, &Rec::narrow), expected);
+
+    algolab::sort_key::sortByKey(recs, {}, &Rec::key);
+    std::string tags;
+    for (const Rec& rec : recs) tags += rec.tag;
+    EXPECT_EQ(tags, "abdec");
+}
+
+TEST_F(ArgsortTest, SortByKeyIsStable) {
+    auto data = quotes(N);
+    algolab::sort_key::sortByKey(data, {}, &WideQuote::price);
+
+    for (size_t i = 1; i < data.size(); ++i) {
+        ASSERT_LE(data[i - 1].price, data[i].price);
+        if (data[i - 1].price == data[i].price) {
+            ASSERT_LT(data[i - 1].seq, data[i].seq);
+        }
+        ASSERT_EQ(data[i].payload[0], static_cast<char>(data[i].seq)) << "Record torn at index " << i;
+    }
+}
+
+TEST_F(ArgsortTest, BenchmarkSortByKeyAgainstRecordSort) {
+    auto data = quotes(N);
+
+    auto byRecord = data;
+    double recordMs = timeMs([&]() { algolab::ranges::introSortAll(byRecord, {}, &WideQuote::price); });
+
+    auto byPrice = data;
+    double priceMs = timeMs([&]() { algolab::sort_key::sortByKey(byPrice, {}, &WideQuote::price); });
+
+    auto byVenue = data;
+    double venueMs = timeMs([&]() { algolab::sort_key::sortByKey(byVenue, {}, &WideQuote::venue); });
+
+    std::cout << "1M x 128-byte records: IntroSort on records " << recordMs << " ms, sortByKey (double price) "
+              << priceMs << " ms, sortByKey (int venue, radix) " << venueMs << " ms\n";
+    for (size_t i = 0; i < data.size(); ++i) {
+        ASSERT_EQ(byRecord[i].price, byPrice[i].price);
+    }
+}
@@ -0,0 +1,141 @@
+#include <gtest/gtest.h>
+#include <iostream>
+#include <chrono>
+#include <vector>
+#include <algorithm>
+#include <random>
+#include <string>
+#include "sort.h"
+#include "sort_iterative.h"
+#include "introsort.h"
+#include "block_partition.h"
+
+/**
+ * @brief BlockPartitionTest class
+ * @details Test fixture for the branchless block partitioner
+ * Checks the partition invariant on random, duplicate-heavy and presorted input,
+ * and benchmarks the Classic and Block schemes of introsort and iterative quicksort.
+ */
+class BlockPartitionTest : public ::testing::Test {
+protected:
+    template <typename T>
+    void expectPartitioned(std::vector<T> vec) {
+        std::vector<T> sorted = vec;
+        std::sort(sorted.begin(), sorted.end());
+
+        int p = algolab::blockPartition(vec, 0, static_cast<int>(vec.size()) - 1);
+        for (int i = 0; i < p; ++i) {
+            ASSERT_TRUE(vec[i] < vec[p]) << "left element " << i;
+        }
+        for (int i = p + 1; i < static_cast<int>(vec.size()); ++i) {
+            ASSERT_FALSE(vec[i] < vec[p]) << "right element " << i;
+        }
+
+        // Partitioning only permutes
+        std::sort(vec.begin(), vec.end());
+        EXPECT_EQ(vec, sorted);
+    }
+
+    template <typename Func>
+    double timeMs(Func&& func) {
+        auto start = std::chrono::high_resolution_clock::now();
+        func();
+        auto end = std::chrono::high_resolution_clock::now();
+        return std::chrono::duration<double, std::milli>(end - start).count();
+    }
+};
+
+TEST_F(BlockPartitionTest, PartitionsRandomInput) {
+    for (int n : {3, 4, 17, 64, 65, 128, 129, 1000, 100000}) {
+        expectPartitioned(algolab::generateRandomNumbers<int>(n, 0, 1000000));
+    }
+}
+
+TEST_F(BlockPartitionTest, PartitionsDuplicatesAndPresortedInput) {
+    expectPartitioned(algolab::generateRandomNumbers<int>(10000, 0, 3));
+    expectPartitioned(std::vector<int>(1000, 5));
+
+    std::vector<int> ascending(5000);
+    for (int i = 0; i < 5000; ++i) ascending[i] = i;
+    expectPartitioned(ascending);
+
+    std::vector<int> descending(ascending.rbegin(), ascending.rend());
+    expectPartitioned(descending);
+}
+
+TEST_F(BlockPartitionTest, PartitionLeftGathersEqualKeys) {
+    auto vec = algolab::generateRandomNumbers<int>(5000, 7, 12);
+    vec[0] = 7;
+    int p = algolab::partitionLeft(vec, 0, static_cast<int>(vec.size()) - 1);
+    for (int i = 0; i <= p; ++i) {
+        ASSERT_EQ(vec[i], 7) << "left element " << i;
+    }
+    for (int i = p + 1; i < static_cast<int>(vec.size()); ++i) {
+        ASSERT_GT(vec[i], 7) << "right element " << i;
+    }
+}
+
+// Equal keys all went right before the partition-left step: one element per level
+TEST_F(BlockPartitionTest, SortsAllEqualAndFewDistinctKeys) {
+    for (int maxValue : {0, 1, 4}) {
+        auto vec = algolab::generateRandomNumbers<int>(1000000, 0, maxValue);
+        auto expected = vec;
+        std::sort(expected.begin(), expected.end());
+
+        auto intro = vec;
+        double introMs = timeMs([&]() {
+            algolab::sort_custom::introSortAll<int, algolab::PartitionScheme::Block>(intro);
+        });
+        EXPECT_EQ(intro, expected) << "max value " << maxValue;
+
+        double iterMs = timeMs([&]() { algolab::sort_iter::quickSortAll<int, algolab::PartitionScheme::Block>(vec); });
+        EXPECT_EQ(vec, expected) << "max value " << maxValue;
+
+        std::cout << "Block schemes (1M int, 0.." << maxValue << ") time: IntroSort " << introMs
+                  << " ms, QuickSortIterative " << iterMs << " ms\n";
+    }
+
+    std::vector<std::string> words(200000, "same");
+    algolab::sort_iter::quickSortAll<std::string, algolab::PartitionScheme::Block>(words);
+    EXPECT_EQ(words, std::vector<std::string>(200000, "same"));
+}
+
+TEST_F(BlockPartitionTest, PartitionsStrings) {
+    std::vector<std::string> vec;
+    for (int value : algolab::generateRandomNumbers<int>(2000, 0, 500)) {
+        vec.push_back("key" + std::to_string(value));
+    }
+    expectPartitioned(vec);
+}
+
+// Random keys mispredict about every other branch of the classic partition loops,
+// the block scheme only branches on loop exits
+// (compare with: perf stat -e branch-misses ./algolabtests --gtest_filter='BlockPartition*')
+TEST_F(BlockPartitionTest, BenchmarkClassicVsBlock) {
+    auto data = algolab::generateRandomNumbers<int>(2000000, 0, 1000000000);
+
+    auto vec = data;
+    double introClassic = timeMs([&]() { algolab::sort_custom::introSortAll(vec); });
+    EXPECT_TRUE(std::is_sorted(vec.begin(), vec.end()));
+
+    vec = data;
+    double introBlock = timeMs([&]() {
+        algolab::sort_custom::introSortAll<int, algolab::PartitionScheme::Block>(vec);
+    });
+    EXPECT_TRUE(std::is_sorted(vec.begin(), vec.end()));
+
+    vec = data;
+    double iterClassic = timeMs([&]() { algolab::sort_iter::quickSortAll(vec); });
+    EXPECT_TRUE(std::is_sorted(vec.begin(), vec.end()));
+
+    vec = data;
+    double iterBlock = timeMs([&]() {
+        algolab::sort_iter::quickSortAll<int, algolab::PartitionScheme::Block>(vec);
+    });
+    EXPECT_TRUE(std::is_sorted(vec.begin(), vec.end()));
+
+    std::cout << "IntroSort Classic (2M int) time: " << introClassic << " ms\n";
+    std::cout << "IntroSort Block (2M int) time: " << introBlock << " ms\n";
+    std::cout << "QuickSortIterative Classic (2M int) time: " << iterClassic << " ms\n";
+    std::cout << "QuickSortIterative Block (2M int) time: " << iterBlock << " ms\n";
+}
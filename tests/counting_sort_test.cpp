@@ -0,0 +1,130 @@
+#include <gtest/gtest.h>
+#include <iostream>
+#include <chrono>
+#include <vector>
+#include <algorithm>
+#include <limits>
+#include <cstdint>
+#include <utility>
+#include "sort.h"
+#include "introsort.h"
+#include "radix_sort.h"
+#include "counting_sort.h"
+
+namespace sc = algolab::sort_count;
+
+namespace {
+
+template <typename T>
+std::vector<T> sortedCopy(std::vector<T> vec) {
+    std::sort(vec.begin(), vec.end());
+    return vec;
+}
+
+struct Order {
+    int quantity;
+    int id;
+    bool operator==(const Order&) const = default;
+};
+
+} // namespace
+
+TEST(CountingSortTest, SortsSmallRangesOfEveryWidth) {
+    algolab::ThreadPool pool(4);
+    auto ints = algolab::generateRandomNumbers<int>(100000, 0, 10000);
+    auto expected = sortedCopy(ints);
+    EXPECT_TRUE(sc::tryCountingSort(ints));
+    EXPECT_EQ(ints, expected);
+
+    auto negative = algolab::generateRandomNumbers<int64_t>(100000, -30000, 30000);
+    auto expected64 = sortedCopy(negative);
+    EXPECT_TRUE(sc::tryCountingSortOn(negative, pool));
+    EXPECT_EQ(negative, expected64);
+
+    // The full range of a narrow type, both ends included
+    std::vector<int8_t> bytes;
+    for (int i = 0; i < 5000; ++i) bytes.push_back(static_cast<int8_t>(i * 37));
+    bytes.push_back(std::numeric_limits<int8_t>::min());
+    bytes.push_back(std::numeric_limits<int8_t>::max());
+    auto expectedBytes = sortedCopy(bytes);
+    EXPECT_TRUE(sc::tryCountingSort(bytes));
+    EXPECT_EQ(bytes, expectedBytes);
+
+    std::vector<uint16_t> shorts(70000);
+    for (size_t i = 0; i < shorts.size(); ++i) shorts[i] = static_cast<uint16_t>(i * 7919);
+    auto expectedShorts = sortedCopy(shorts);
+    EXPECT_TRUE(sc::tryCountingSortOn(shorts, pool));
+    EXPECT_EQ(shorts, expectedShorts);
+}
+
+TEST(CountingSortTest, WideRangeFallsBackToRadix) {
+    auto data = algolab::generateRandomNumbers<int>(100000, std::numeric_limits<int>::min(), std::numeric_limits<int>::max());
+    auto untouched = data;
+    EXPECT_FALSE(sc::tryCountingSort(data));
+    EXPECT_EQ(data, untouched);
+
+    // Narrow range but far fewer elements than values
+    std::vector<int> sparse {60000, 3, 12, 40000, 0, 7, 9, 1, 2, 5, 8, 4, 6, 11, 10, 13};
+    for (int i = 0; i < 64; ++i) sparse.push_back(i * 500);
+    untouched = sparse;
+    EXPECT_FALSE(sc::tryCountingSort(sparse));
+    EXPECT_EQ(sparse, untouched);
+
+    auto expected = sortedCopy(data);
+    sc::countingSortAll(data);
+    EXPECT_EQ(data, expected);
+}
+
+TEST(CountingSortTest, StableByKeyOnPool) {
+    algolab::ThreadPool pool(4);
+    auto quantities = algolab::generateRandomNumbers<int>(600000, -500, 500);
+    std::vector<Order> orders;
+    for (size_t i = 0; i < quantities.size(); ++i) orders.push_back({quantities[i], static_cast<int>(i)});
+
+    auto expected = orders;
+    std::stable_sort(expected.begin(), expected.end(), [](const Order& a, const Order& b) { return a.quantity < b.quantity; });
+
+    auto sequential = orders;
+    EXPECT_TRUE(sc::tryStableCountingSort(sequential, &Order::quantity));
+    EXPECT_EQ(sequential, expected);
+
+    sc::stableCountingSortOn(orders, &Order::quantity, pool);
+    EXPECT_EQ(orders, expected);
+
+    // Keys too far apart: sort_key::sortByKey keeps the sort stable
+    std::vector<std::pair<int64_t, int>> wide {{int64_t(1) << 40, 0}, {-1, 1}, {int64_t(1) << 40, 2}, {-1, 3}};
+    sc::stableCountingSortAll(wide, [](const auto& p) { return p.first; });
+    EXPECT_EQ(wide, (std::vector<std::pair<int64_t, int>>{{-1, 1}, {-1, 3}, {int64_t(1) << 40, 0}, {int64_t(1) << 40, 2}}));
+}
+
+TEST(CountingSortTest, BenchmarkAgainstIntroSortAndRadix) {
+    auto data = algolab::generateRandomNumbers<int>(4000000, 0, 10000);
+
+    auto vec = data;
+    auto start = std::chrono::high_resolution_clock::now();
+    algolab::sort_custom::introSortAll(vec);
+    auto end = std::chrono::high_resolution_clock::now();
+    std::cout << "IntroSort (int 0..10000, 4M) time: " << std::chrono::duration<double, std::milli>(end - start).count() << " ms\n";
+    auto expected = vec;
+
+    vec = data;
+    start = std::chrono::high_resolution_clock::now();
+    algolab::sort_radix::radixSortAll(vec);
+    end = std::chrono::high_resolution_clock::now();
+    std::cout << "Radix Sort (int 0..10000, 4M) time: " << std::chrono::duration<double, std::milli>(end - start).count() << " ms\n";
+
+    vec = data;
+    start = std::chrono::high_resolution_clock::now();
+    EXPECT_TRUE(sc::tryCountingSort(vec));
+    end = std::chrono::high_resolution_clock::now();
+    std::cout << "Counting Sort (int 0..10000, 4M, 1 thread) time: " << std::chrono::duration<double, std::milli>(end - start).count() << " ms\n";
+    EXPECT_EQ(vec, expected);
+
+    vec = data;
+    start = std::chrono::high_resolution_clock::now();
+    sc::countingSortAll(vec);
+    end = std::chrono::high_resolution_clock::now();
+    std::cout << "Counting Sort (int 0..10000, 4M, " << algolab::ThreadPool::shared().size()
+              << " threads) time: " << std::chrono::duration<double, std::milli>(end - start).count() << " ms\n";
+    EXPECT_EQ(vec, expected);
+}
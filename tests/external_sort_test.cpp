@@ -0,0 +1,147 @@
+#include <gtest/gtest.h>
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <string>
+#include "sort.h"
+#include "external_sort.h"
+
+/**
+ * @brief ExternalSortTest class
+ * @details Test fixture for the external-memory sort
+ * Writes binary files of fixed-width records to a scratch directory on local disk,
+ * sorts them with a memory budget much smaller than the file, and checks the output
+ * against std::sort. The scratch directory is removed after each test.
+ */
+namespace {
+
+struct Record {
+    uint64_t key;
+    uint64_t payload;
+
+    bool operator<(const Record& other) const { return key < other.key; }
+    bool operator>(const Record& other) const { return key > other.key; }
+    bool operator==(const Record& other) const { return key == other.key && payload == other.payload; }
+};
+
+} // namespace
+
+class ExternalSortTest : public ::testing::Test {
+protected:
+    std::filesystem::path dir;
+
+    void SetUp() override {
+        dir = std::filesystem::temp_directory_path()
+            / ("algolab_external_sort_test_" + std::to_string(std::random_device{}()));
+        std::filesystem::create_directories(dir);
+    }
+
+    void TearDown() override {
+        std::filesystem::remove_all(dir);
+    }
+
+    template <typename T>
+    static void writeFile(const std::filesystem::path& path, const std::vector<T>& records) {
+        std::ofstream out(path, std::ios::binary);
+        out.write(reinterpret_cast<const char*>(records.data()), records.size() * sizeof(T));
+    }
+
+    template <typename T>
+    static std::vector<T> readFile(const std::filesystem::path& path) {
+        std::vector<T> records(std::filesystem::file_size(path) / sizeof(T));
+        std::ifstream in(path, std::ios::binary);
+        in.read(reinterpret_cast<char*>(records.data()), records.size() * sizeof(T));
+        return records;
+    }
+
+    static std::vector<Record> randomRecords(size_t count) {
+        std::mt19937_64 eng(std::random_device{}());
+        std::vector<Record> records(count);
+        for (size_t i = 0; i < count; ++i) {
+            records[i] = {eng(), i};
+        }
+        return records;
+    }
+
+    algolab::sort_external::ExternalSortConfig config(size_t budgetBytes) const {
+        algolab::sort_external::ExternalSortConfig cfg;
+        cfg.memoryBudgetBytes = budgetBytes;
+        cfg.tempDirectory = dir;
+        return cfg;
+    }
+
+    // Only the test's own input and output files should remain
+    size_t filesInDir() const {
+        return static_cast<size_t>(std::distance(std::filesystem::directory_iterator(dir),
+                                                 std::filesystem::directory_iterator()));
+    }
+};
+
+TEST_F(ExternalSortTest, SortsManyRuns) {
+    auto records = randomRecords(1 << 20); // 16 MB
+    writeFile(dir / "input.bin", records);
+
+    auto stats = algolab::sort_external::externalSort<Record>(dir / "input.bin", dir / "output.bin", config(1 << 20));
+    std::cout << "ExternalSort 16 MB, 1 MB budget: " << stats.runs << " runs, "
+              << stats.runFormationSeconds * 1000 << " ms run formation, "
+              << stats.mergeSeconds * 1000 << " ms merge, "
+              << stats.throughputMBps() << " MB/s\n";
+
+    std::sort(records.begin(), records.end());
+    EXPECT_EQ(readFile<Record>(dir / "output.bin"), records);
+    EXPECT_EQ(stats.records, records.size());
+    EXPECT_EQ(stats.runs, 32u);
+    // A 1 MB budget holds the blocks of 7 runs: 32 runs, then 5, then the output
+    EXPECT_EQ(stats.mergePasses, 2u);
+    EXPECT_GT(stats.throughputMBps(), 0.0);
+    EXPECT_EQ(filesInDir(), 2u) << "Temporary runs were not removed";
+}
+
+TEST_F(ExternalSortTest, MergesInPassesWithSmallFanIn) {
+    auto records = randomRecords(1 << 19); // 8 MB, 16 runs
+    writeFile(dir / "input.bin", records);
+
+    auto cfg = config(1 << 20);
+    cfg.maxFanIn = 3;
+    auto stats = algolab::sort_external::externalSort<Record>(dir / "input.bin", dir / "output.bin", cfg);
+
+    std::sort(records.begin(), records.end());
+    EXPECT_EQ(readFile<Record>(dir / "output.bin"), records);
+    EXPECT_EQ(stats.runs, 16u);
+    EXPECT_EQ(stats.mergePasses, 3u); // 16 -> 6 -> 2 -> 1
+    EXPECT_EQ(filesInDir(), 2u) << "Temporary runs were not removed";
+}
+
+TEST_F(ExternalSortTest, SortsInMemoryWhenBudgetAllows) {
+    auto values = algolab::generateRandomNumbers<int>(100000, -1000000, 1000000);
+    writeFile(dir / "input.bin", values);
+
+    auto stats = algolab::sort_external::externalSort<int>(dir / "input.bin", dir / "output.bin", config(8 << 20));
+
+    std::sort(values.begin(), values.end());
+    EXPECT_EQ(readFile<int>(dir / "output.bin"), values);
+    EXPECT_EQ(stats.runs, 1u);
+    EXPECT_EQ(stats.mergePasses, 0u);
+    EXPECT_EQ(filesInDir(), 2u);
+}
+
+TEST_F(ExternalSortTest, HandlesEmptyInput) {
+    writeFile(dir / "input.bin", std::vector<int>{});
+
+    auto stats = algolab::sort_external::externalSort<int>(dir / "input.bin", dir / "output.bin", config(1 << 20));
+
+    EXPECT_EQ(stats.runs, 0u);
+    EXPECT_TRUE(std::filesystem::exists(dir / "output.bin"));
+    EXPECT_EQ(std::filesystem::file_size(dir / "output.bin"), 0u);
+}
+
+TEST_F(ExternalSortTest, RejectsTruncatedRecords) {
+    std::ofstream(dir / "input.bin", std::ios::binary) << "abc";
+
+    EXPECT_THROW(algolab::sort_external::externalSort<Record>(dir / "input.bin", dir / "output.bin", config(1 << 20)),
+                 std::invalid_argument);
+}
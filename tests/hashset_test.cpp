@@ -198,4 +198,34 @@ TEST_F(HashSetTest, MarketQuotesTest2) {
     auto total_end = now();
     duration = total_end - total_start;
     std::cout << "Custom HashSet time: " << duration.count() << " seconds" << std::endl;
-}
\ No newline at end of file
+}
+TEST(HashSetBulkTest, BulkConstructorFromUniqueKeys) {
+    std::vector<uint64_t> keys(200000);
+    for (uint64_t i = 0; i < keys.size(); ++i) keys[i] = i * 7919;
+
+    algolab::HashSet<uint64_t> set(algolab::uniqueKeys, keys.begin(), keys.end());
+    EXPECT_EQ(set.size(), keys.size());
+    EXPECT_LE(set.load_factor(), 0.7);
+    for (uint64_t key : keys) ASSERT_TRUE(set.search(key));
+    EXPECT_FALSE(set.search(1));
+}
+
+TEST_F(HashSetTest, InsertUniqueSkipsKeysAlreadyPresent) {
+    std::vector<int> keys {10, 11, 65, 12, 4958, 13};
+    EXPECT_EQ(hashsetInt.insertUnique(keys.begin(), keys.end()), 3u);
+    EXPECT_EQ(hashsetInt.size(), 8u);
+    for (int key : keys) EXPECT_TRUE(hashsetInt.search(key));
+    EXPECT_TRUE(hashsetInt.search(561));
+}
+
+// Equivalent to keep inserting; the growth of the first keys must survive the rehash
+TEST(HashSetBulkTest, InsertUniqueGrowsAnExistingSet) {
+    algolab::HashSet<int> set;
+    for (int i = 0; i < 100; ++i) set.insert(i);
+    std::vector<int> more;
+    for (int i = 100; i < 50000; ++i) more.push_back(i);
+
+    EXPECT_EQ(set.insertUnique(more.begin(), more.end()), more.size());
+    EXPECT_EQ(set.size(), 50000u);
+    for (int i = 0; i < 50000; ++i) ASSERT_TRUE(set.search(i));
+}
@@ -0,0 +1,167 @@
+#include <gtest/gtest.h>
+#include <iostream>
+#include <chrono>
+#include <vector>
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <memory>
+#include <string>
+#include "sort.h"
+#include "introsort.h"
+#include "heapsort.h"
+
+/**
+ * @brief HeapSortTest class
+ * @details Test fixture for the heapsort engine (algolab::sort_heap)
+ * Checks every arity / sift combination against std::sort, the heap shape built by
+ * makeHeap, the comparison count of Floyd's bottom-up sift, and benchmarks the
+ * engine against std::make_heap + std::sort_heap and the binary heapSort in sort.h.
+ */
+namespace {
+
+struct CountingLess {
+    long long* comparisons;
+
+    bool operator()(int a, int b) const {
+        ++*comparisons;
+        return a < b;
+    }
+};
+
+using algolab::sort_heap::HeapSift;
+
+} // namespace
+
+class HeapSortTest : public ::testing::Test {
+protected:
+    static constexpr int N = 1000000;
+
+    template <int Arity, HeapSift Sift>
+    static void expectSortsLikeStdSort() {
+        for (int n : {0, 1, 2, 3, 5, 8, 9, 17, 64, 65, 1000, 4097}) {
+            for (int maxValue : {3, n}) {
+                auto data = algolab::generateRandomNumbers<int>(n, 0, maxValue);
+                auto expected = data;
+                std::sort(expected.begin(), expected.end());
+                algolab::sort_heap::heapSort<Arity, Sift>(data.begin(), data.end());
+                ASSERT_EQ(data, expected) << "Arity " << Arity << " n=" << n << " max=" << maxValue;
+            }
+        }
+    }
+
+    template <int Arity>
+    static bool isHeap(const std::vector<int>& heap) {
+        for (size_t i = 1; i < heap.size(); ++i) {
+            if (heap[(i - 1) / Arity] < heap[i]) return false;
+        }
+        return true;
+    }
+
+    static double timeMs(const std::function<void()>& func) {
+        auto start = std::chrono::high_resolution_clock::now();
+        func();
+        auto end = std::chrono::high_resolution_clock::now();
+        return std::chrono::duration<double, std::milli>(end - start).count();
+    }
+};
+
+TEST_F(HeapSortTest, SortsWithEveryArityAndSift) {
+    expectSortsLikeStdSort<2, HeapSift::TopDown>();
+    expectSortsLikeStdSort<2, HeapSift::BottomUp>();
+    expectSortsLikeStdSort<3, HeapSift::BottomUp>();
+    expectSortsLikeStdSort<4, HeapSift::TopDown>();
+    expectSortsLikeStdSort<4, HeapSift::BottomUp>();
+    expectSortsLikeStdSort<8, HeapSift::TopDown>();
+    expectSortsLikeStdSort<8, HeapSift::BottomUp>();
+}
+
+TEST_F(HeapSortTest, MakeHeapBuildsDaryHeap) {
+    auto data = algolab::generateRandomNumbers<int>(10000, 0, 1000);
+
+    auto binary = data;
+    algolab::sort_heap::makeHeap<2>(binary.begin(), binary.end());
+    EXPECT_TRUE(isHeap<2>(binary));
+    EXPECT_TRUE(std::is_heap(binary.begin(), binary.end()));
+
+    auto quaternary = data;
+    algolab::sort_heap::makeHeap<4>(quaternary.begin(), quaternary.end());
+    EXPECT_TRUE(isHeap<4>(quaternary));
+
+    auto octonary = data;
+    algolab::sort_heap::makeHeap<8>(octonary.begin(), octonary.end());
+    EXPECT_TRUE(isHeap<8>(octonary));
+    EXPECT_EQ(octonary.front(), *std::max_element(data.begin(), data.end()));
+}
+
+TEST_F(HeapSortTest, HonoursComparatorAndMoveOnlyTypes) {
+    std::vector<std::string> words = {"pear", "apple", "fig", "kiwi", "banana", "cherry"};
+    algolab::sort_heap::heapSort(words.begin(), words.end(), std::greater<>{});
+    EXPECT_EQ(words, (std::vector<std::string>{"pear", "kiwi", "fig", "cherry", "banana", "apple"}));
+
+    std::vector<std::unique_ptr<int>> owned;
+    for (int value : {5, 3, 9, 1, 7}) owned.push_back(std::make_unique<int>(value));
+    algolab::sort_heap::heapSort(owned.begin(), owned.end(),
+                                 [](const auto& a, const auto& b) { return *a < *b; });
+    for (size_t i = 0; i < owned.size(); ++i) {
+        EXPECT_EQ(*owned[i], std::vector<int>({1, 3, 5, 7, 9})[i]);
+    }
+}
+
+TEST_F(HeapSortTest, BottomUpHalvesComparisons) {
+    auto data = algolab::generateRandomNumbers<int>(N, 0, N);
+    const double nLogN = N * std::log2(static_cast<double>(N));
+
+    long long topDown = 0;
+    auto a = data;
+    algolab::sort_heap::heapSort<2, HeapSift::TopDown>(a.begin(), a.end(), CountingLess{&topDown});
+
+    long long bottomUp = 0;
+    auto b = data;
+    algolab::sort_heap::heapSort<2, HeapSift::BottomUp>(b.begin(), b.end(), CountingLess{&bottomUp});
+
+    std::cout << "1M int binary heapsort comparisons / n log2 n: top-down " << topDown / nLogN
+              << ", bottom-up " << bottomUp / nLogN << "\n";
+    EXPECT_TRUE(std::is_sorted(b.begin(), b.end()));
+    EXPECT_GT(topDown / nLogN, 1.6);
+    EXPECT_LT(bottomUp / nLogN, 1.2);
+}
+
+TEST_F(HeapSortTest, IntrosortDepthLimitFallback) {
+    // A depth limit of 0 sends the whole range straight to the heapsort fallback
+    auto data = algolab::generateRandomNumbers<int>(N, 0, N);
+    auto expected = data;
+    std::sort(expected.begin(), expected.end());
+
+    algolab::sort_custom::introsort(data, 0, N - 1, 0);
+    EXPECT_EQ(data, expected);
+}
+
+TEST_F(HeapSortTest, BenchmarkAgainstStdHeapAndRecursiveHeapify) {
+    auto data = algolab::generateRandomNumbers<int>(N, 0, N);
+
+    auto stdHeap = data;
+    double stdMs = timeMs([&]() {
+        std::make_heap(stdHeap.begin(), stdHeap.end());
+        std::sort_heap(stdHeap.begin(), stdHeap.end());
+    });
+
+    auto classic = data;
+    double classicMs = timeMs([&]() { algolab::heapSort(classic); });
+
+    auto binary = data;
+    double binaryMs = timeMs([&]() {
+        algolab::sort_heap::heapSort<2, HeapSift::BottomUp>(binary.begin(), binary.end());
+    });
+
+    auto quaternary = data;
+    double quaternaryMs = timeMs([&]() { algolab::sort_heap::heapSortAll(quaternary); });
+
+    auto octonary = data;
+    double octonaryMs = timeMs([&]() { algolab::sort_heap::heapSortAll<int, 8>(octonary); });
+
+    std::cout << "1M int: std heap " << stdMs << " ms, sort.h heapSort " << classicMs << " ms, binary bottom-up "
+              << binaryMs << " ms, 4-ary " << quaternaryMs << " ms, 8-ary " << octonaryMs << " ms\n";
+    EXPECT_EQ(quaternary, stdHeap);
+    EXPECT_EQ(octonary, stdHeap);
+}
@@ -0,0 +1,108 @@
+#include <gtest/gtest.h>
+#include <iostream>
+#include <chrono>
+#include <vector>
+#include <algorithm>
+#include <string>
+#include "sort.h"
+#include "introsort.h"
+#include "incremental_sort.h"
+
+using algolab::sort_incremental::IncrementalSort;
+
+/**
+ * @brief IncrementalSortTest class
+ * @details Tests for the resumable introsort in algolab::sort_incremental
+ * Drives the sort with small work and time budgets and checks that every step
+ * stays close to its budget.
+ */
+class IncrementalSortTest : public ::testing::Test {
+protected:
+    // Steps through the whole sort with the given budget, returns the largest overshoot
+    template <typename T>
+    size_t sortInSteps(IncrementalSort<T>& sorter, size_t budget) {
+        size_t overshoot = 0;
+        while (!sorter.done()) {
+            size_t before = sorter.workDone();
+            sorter.step(budget);
+            size_t used = sorter.workDone() - before;
+            EXPECT_GT(used, 0u);
+            overshoot = std::max(overshoot, used > budget ? used - budget : 0);
+        }
+        return overshoot;
+    }
+};
+
+TEST_F(IncrementalSortTest, SortsInBoundedSteps) {
+    auto vec = algolab::generateRandomNumbers<int>(200000, -100000, 100000);
+    auto expected = vec;
+    std::sort(expected.begin(), expected.end());
+
+    IncrementalSort<int> sorter(vec);
+    EXPECT_FALSE(sorter.done());
+    size_t overshoot = sortInSteps(sorter, 500);
+    EXPECT_EQ(vec, expected);
+    EXPECT_LE(overshoot, static_cast<size_t>(algolab::sort_custom::INTROSORT_INSERTION_THRESHOLD + 1));
+}
+
+// Depth limit 0 and 3: the whole input, or ranges below three partitions, are heapsorted sift by sift
+TEST_F(IncrementalSortTest, HeapsortFallbackIsIncrementalToo) {
+    for (int depthLimit : {0, 3}) {
+        auto vec = algolab::generateRandomNumbers<double>(50000, -1.0, 1.0);
+        auto expected = vec;
+        std::sort(expected.begin(), expected.end());
+
+        IncrementalSort<double> sorter(vec, depthLimit);
+        size_t overshoot = sortInSteps(sorter, 100);
+        EXPECT_EQ(vec, expected);
+        EXPECT_LE(overshoot, 20u);
+    }
+}
+
+TEST_F(IncrementalSortTest, FinishNowAfterSomeSteps) {
+    std::vector<std::string> words;
+    for (int value : algolab::generateRandomNumbers<int>(30000, 0, 1000000)) {
+        words.push_back("order-" + std::to_string(value));
+    }
+    auto expected = words;
+    std::sort(expected.begin(), expected.end());
+
+    IncrementalSort<std::string> sorter(words);
+    for (int i = 0; i < 50; ++i) sorter.step(1000);
+    EXPECT_FALSE(sorter.done());
+    sorter.finishNow();
+    EXPECT_TRUE(sorter.done());
+    EXPECT_EQ(words, expected);
+
+    std::vector<int> tiny {1};
+    IncrementalSort<int> empty(tiny);
+    EXPECT_TRUE(empty.done());
+    EXPECT_TRUE(empty.step(10));
+}
+
+// A 200us slice per tick, as an event loop would spend it
+TEST_F(IncrementalSortTest, BenchmarkTimeSlicedTicks) {
+    auto vec = algolab::generateRandomNumbers<int>(2000000, 0, 1000000000);
+    auto expected = vec;
+    auto start = std::chrono::high_resolution_clock::now();
+    algolab::sort_custom::introSortAll(expected);
+    auto end = std::chrono::high_resolution_clock::now();
+    std::cout << "IntroSort (2M) time: " << std::chrono::duration<double, std::milli>(end - start).count() << " ms\n";
+
+    IncrementalSort<int> sorter(vec);
+    int ticks = 0;
+    double longest = 0.0;
+    double total = 0.0;
+    while (!sorter.done()) {
+        auto tickStart = std::chrono::high_resolution_clock::now();
+        sorter.stepFor(std::chrono::microseconds(200));
+        auto tickEnd = std::chrono::high_resolution_clock::now();
+        double tick = std::chrono::duration<double, std::micro>(tickEnd - tickStart).count();
+        longest = std::max(longest, tick);
+        total += tick;
+        ++ticks;
+    }
+    std::cout << "IncrementalSort (2M, 200us slices): " << ticks << " ticks, " << total / 1000.0
+              << " ms in total, longest tick " << longest << " us\n";
+    EXPECT_EQ(vec, expected);
+}
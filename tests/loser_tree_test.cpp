@@ -0,0 +1,182 @@
+#include <gtest/gtest.h>
+#include <iostream>
+#include <chrono>
+#include <vector>
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <iterator>
+#include <ranges>
+#include <span>
+#include <string>
+#include <utility>
+#include "sort.h"
+#include "loser_tree.h"
+
+/**
+ * @brief LoserTreeTest class
+ * @details Tests for the loser tree and the k-way merges built on it
+ * Merges spans, iterator pairs, vectors and pull-based streams, checks stability
+ * and the ceil(log2 k) comparisons per element, and compares merging 1000 shards
+ * with sorting their concatenation.
+ */
+namespace {
+
+// Pull stream of first, first + step, ... (count values), never materialised
+struct ArithmeticStream {
+    using value_type = long long;
+
+    long long current;
+    long long step;
+    int remaining;
+
+    bool next(long long& value) {
+        if (remaining == 0) return false;
+        value = current;
+        current += step;
+        --remaining;
+        return true;
+    }
+};
+
+struct CountingLess {
+    long long* comparisons;
+
+    bool operator()(int a, int b) const {
+        ++*comparisons;
+        return a < b;
+    }
+};
+
+} // namespace
+
+class LoserTreeTest : public ::testing::Test {
+protected:
+    static std::vector<std::vector<int>> sortedShards(int shards, int perShard) {
+        std::vector<std::vector<int>> result;
+        for (int i = 0; i < shards; ++i) {
+            auto shard = algolab::generateRandomNumbers<int>(perShard, 0, 1000000);
+            std::sort(shard.begin(), shard.end());
+            result.push_back(std::move(shard));
+        }
+        return result;
+    }
+
+    static std::vector<int> concatenated(const std::vector<std::vector<int>>& shards) {
+        std::vector<int> result;
+        for (const auto& shard : shards) result.insert(result.end(), shard.begin(), shard.end());
+        return result;
+    }
+};
+
+TEST_F(LoserTreeTest, MergesSortedSources) {
+    std::vector<std::vector<int>> sources = {{1, 4, 9}, {}, {2, 2, 8, 10}, {0, 3}, {5}};
+    algolab::LoserTree<int> tree(sources.size());
+    std::vector<size_t> positions(sources.size(), 0);
+    for (size_t i = 0; i < sources.size(); ++i) {
+        if (!sources[i].empty()) tree.setKey(i, sources[i][positions[i]++]);
+    }
+    tree.build();
+
+    std::vector<int> merged;
+    while (!tree.empty()) {
+        size_t source = tree.winner();
+        merged.push_back(tree.top());
+        if (positions[source] < sources[source].size()) {
+            tree.replaceTop(sources[source][positions[source]++]);
+        } else {
+            tree.removeTop();
+        }
+    }
+    EXPECT_EQ(merged, (std::vector<int>{0, 1, 2, 2, 3, 4, 5, 8, 9, 10}));
+}
+
+TEST_F(LoserTreeTest, MergesVectorsSpansAndIteratorPairs) {
+    for (int k : {0, 1, 2, 3, 7, 64, 100}) {
+        auto shards = sortedShards(k, 500);
+        auto expected = concatenated(shards);
+        std::sort(expected.begin(), expected.end());
+
+        std::vector<int> fromVectors;
+        algolab::kWayMerge(shards, std::back_inserter(fromVectors));
+        EXPECT_EQ(fromVectors, expected) << k << " vectors";
+
+        std::vector<std::span<const int>> spans(shards.begin(), shards.end());
+        std::vector<int> fromSpans(expected.size());
+        auto end = algolab::kWayMerge(spans, fromSpans.begin());
+        EXPECT_EQ(end, fromSpans.end());
+        EXPECT_EQ(fromSpans, expected) << k << " spans";
+
+        std::vector<std::ranges::subrange<std::vector<int>::const_iterator>> pairs;
+        for (const auto& shard : shards) pairs.emplace_back(shard.cbegin(), shard.cend());
+        std::vector<int> fromPairs;
+        algolab::kWayMerge(pairs, std::back_inserter(fromPairs));
+        EXPECT_EQ(fromPairs, expected) << k << " iterator pairs";
+    }
+}
+
+TEST_F(LoserTreeTest, MergesPullStreamsIntoSink) {
+    // Stream i yields i, i + 10, i + 20...: the merge is 0, 1, 2, ... without gaps
+    std::vector<ArithmeticStream> streams;
+    for (int i = 0; i < 10; ++i) streams.push_back({i, 10, 10000});
+
+    long long expected = 0;
+    bool inOrder = true;
+    size_t count = algolab::mergeSources(streams, [&](long long value) {
+        inOrder = inOrder && value == expected++;
+    });
+
+    EXPECT_EQ(count, 100000u);
+    EXPECT_TRUE(inOrder);
+}
+
+TEST_F(LoserTreeTest, MergeIsStableAndHonoursComparator) {
+    // Descending shards of (key, shard) pairs, merged by key only with a descending comparator
+    using Entry = std::pair<int, int>;
+    std::vector<std::vector<Entry>> shards(5);
+    for (int s = 0; s < 5; ++s) {
+        for (int key = 100; key > 0; key -= 1 + s % 2) shards[s].push_back({key, s});
+    }
+    auto byKeyDesc = [](const Entry& a, const Entry& b) { return a.first > b.first; };
+
+    std::vector<Entry> merged;
+    algolab::kWayMerge(shards, std::back_inserter(merged), byKeyDesc);
+
+    std::vector<Entry> reference;
+    for (const auto& shard : shards) reference.insert(reference.end(), shard.begin(), shard.end());
+    std::stable_sort(reference.begin(), reference.end(), byKeyDesc);
+    EXPECT_EQ(merged, reference);
+}
+
+TEST_F(LoserTreeTest, UsesLogKComparisonsPerElement) {
+    constexpr int k = 1000;
+    auto shards = sortedShards(k, 100);
+    long long comparisons = 0;
+
+    std::vector<int> merged;
+    algolab::kWayMerge(shards, std::back_inserter(merged), CountingLess{&comparisons});
+
+    // Initial tournament is k - 1 matches, every element then replays one leaf-to-root path
+    const long long perElement = static_cast<long long>(std::ceil(std::log2(k)));
+    EXPECT_TRUE(std::is_sorted(merged.begin(), merged.end()));
+    EXPECT_LE(comparisons, k - 1 + static_cast<long long>(merged.size()) * perElement);
+}
+
+TEST_F(LoserTreeTest, BenchmarkMergeVersusSortingConcatenation) {
+    auto shards = sortedShards(1000, 1000);
+    auto sorted = concatenated(shards);
+
+    auto start = std::chrono::high_resolution_clock::now();
+    std::sort(sorted.begin(), sorted.end());
+    auto sortEnd = std::chrono::high_resolution_clock::now();
+
+    std::vector<int> merged;
+    merged.reserve(sorted.size());
+    algolab::kWayMerge(shards, std::back_inserter(merged));
+    auto mergeEnd = std::chrono::high_resolution_clock::now();
+
+    std::cout << "1000 shards x 1000 int: std::sort of concatenation "
+              << std::chrono::duration<double, std::milli>(sortEnd - start).count() << " ms, kWayMerge "
+              << std::chrono::duration<double, std::milli>(mergeEnd - sortEnd).count() << " ms\n";
+    EXPECT_EQ(merged, sorted);
+}
@@ -113,6 +113,37 @@ TEST_F(MergeSortTest, SortRandomNumbers) {
     EXPECT_TRUE(isSorted(randomNumbers_flt));
 }
 
+// Equal keys keep their input order across insertion-sorted runs and merge passes
+TEST_F(MergeSortTest, SortIsStable) {
+    struct ByKey {
+        std::pair<int, int> item;
+        bool operator<(const ByKey& other) const { return item.first < other.item.first; }
+    };
+    std::vector<ByKey> keyed;
+    for (int i = 0; i < 1000; ++i) {
+        keyed.push_back({{randomNumbers_int[i] % 10, i}});
+    }
+
+    algolab::mergeSortAll(keyed);
+    for (size_t i = 1; i < keyed.size(); ++i) {
+        ASSERT_LE(keyed[i - 1].item.first, keyed[i].item.first);
+        if (keyed[i - 1].item.first == keyed[i].item.first) {
+            ASSERT_LT(keyed[i - 1].item.second, keyed[i].item.second);
+        }
+    }
+}
+
+// Only arr[left..right] is sorted, the buffer is reused and the rest is left untouched
+TEST_F(MergeSortTest, BottomUpSortsSubRange) {
+    std::vector<int> vec = randomNumbers_int;
+    std::vector<int> buffer(vec.size());
+    std::vector<int> expected = vec;
+    std::sort(expected.begin() + 100, expected.begin() + 20001);
+
+    algolab::mergeSortBottomUp(vec, buffer, 100, 20000);
+    EXPECT_EQ(vec, expected);
+}
+
 TEST_F(MergeSortTest, /*DISABLED_*/BenchmarkSortRandom) {
     auto start = std::chrono::high_resolution_clock::now();
     algolab::mergeSortAll(randomNumbers_int);
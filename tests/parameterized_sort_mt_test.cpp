@@ -62,87 +62,228 @@ protected:
 class SortingParameterizedTestMtInt: public SortingParameterizedTestMt<int, NamedSortInt> {
 protected:
     std::vector<int> generateRandom() const override {
-        return algolab::generateRandomNumbers<int>(10000, 0, 10000);
+        return algolab::generateRandomNumbers<int>(1000000, 0, 10000);
     }
 };
 
-// class SortingParameterizedTestMtFloat: public SortingParameterizedTestMt<float, NamedSortFloat> {
-// protected:    
-//     std::vector<float> generateRandom() const override {
-//         return algolab::generateRandomNumbers<float>(50000, 0.0f, 10000.0f);
-//     }
-// };
+class SortingParameterizedTestMtFloat: public SortingParameterizedTestMt<float, NamedSortFloat> {
+protected:    
+    std::vector<float> generateRandom() const override {
+        return algolab::generateRandomNumbers<float>(1000000, 0.0f, 10000.0f);
+    }
+};
 
-// TEST_P(SortingParameterizedTestMtInt, SortsRandomCorrectly) {
-//      std::vector<int> vec = generateRandom();
-//     auto sort = GetParam().func;
+TEST_P(SortingParameterizedTestMtInt, SortsRandomCorrectly) {
+    std::vector<int> vec = generateRandom();
+    auto sort = GetParam().func;
     
-//     auto start = std::chrono::high_resolution_clock::now();
-//     sort(vec);
-//     auto end = std::chrono::high_resolution_clock::now();
+    auto start = std::chrono::high_resolution_clock::now();
+    sort(vec);
+    auto end = std::chrono::high_resolution_clock::now();
 
-//     logTiming(GetParam().name + " (SortsRandomCorrectly)", start, end);
+    logTiming(GetParam().name + " (SortsRandomCorrectly)", start, end);
+
+    EXPECT_TRUE(isSorted(vec));
+}
 
-//     EXPECT_TRUE(isSorted(vec));
-// }
+TEST(SortMtDebugTest, RunSingleQuickSort) {
+    auto vec = algolab::generateRandomNumbers<int>(10000, 0, 10000);
+    algolab::sort_mt::quickSortAll(vec);
+    EXPECT_TRUE(std::is_sorted(vec.begin(), vec.end()));
+}
+
+// Small cutoff on a dedicated pool, so thousands of tasks get stolen between workers
+TEST(SortMtDebugTest, RunIntroSortOnDedicatedPool) {
+    algolab::ThreadPool pool(4);
+    auto vec = algolab::generateRandomNumbers<int>(200000, 0, 10000);
+    algolab::sort_mt::introSortOn(vec, pool, 256);
+    EXPECT_TRUE(std::is_sorted(vec.begin(), vec.end()));
+}
+
+// Below the insertion threshold parallelIntrosort leaves ranges to introsort whatever
+// the cutoff, partition keeps its sentinels
+TEST(SortMtDebugTest, IntroSortOnTinyCutoff) {
+    algolab::ThreadPool pool(4);
+    for (int cutoff : {-1, 0, 1, 2}) {
+        auto vec = algolab::generateRandomNumbers<int>(20000, 0, 1000);
+        auto expected = vec;
+        std::sort(expected.begin(), expected.end());
+        auto sampled = vec;
+        algolab::sort_mt::introSortOn(vec, pool, cutoff);
+        EXPECT_EQ(vec, expected) << "cutoff " << cutoff;
+        algolab::sort_mt::sampleSortOn(sampled, pool, cutoff);
+        EXPECT_EQ(sampled, expected) << "cutoff " << cutoff;
+    }
+
+    for (int n : {2, 3, 17}) {
+        auto vec = algolab::generateRandomNumbers<int>(n, 0, 10);
+        auto expected = vec;
+        std::sort(expected.begin(), expected.end());
+        {
+            algolab::TaskGroup group(pool);
+            algolab::sort_mt::parallelIntrosort(vec, 0, n - 1, 8, group, 0);
+            group.wait();
+        }
+        EXPECT_EQ(vec, expected) << "n = " << n;
+    }
+}
 
-// TEST(SortMtDebugTest, RunSingleQuickSort) {
-//     auto vec = algolab::generateRandomNumbers<int>(10000, 0, 10000);
-//     algolab::sort_mt::quickSortAll(vec);
-//     EXPECT_TRUE(std::is_sorted(vec.begin(), vec.end()));
-// }
+// Equal keys must keep their input order, including across merge-path slices
+TEST(SortMtDebugTest, MergeSortIsStable) {
+    struct Item {
+        int key;
+        int seq;
+        bool operator<(const Item& other) const { return key < other.key; }
+        bool operator<=(const Item& other) const { return key <= other.key; }
+    };
+
+    auto keys = algolab::generateRandomNumbers<int>(300000, 0, 50);
+    std::vector<Item> items;
+    items.reserve(keys.size());
+    for (size_t i = 0; i < keys.size(); ++i) {
+        items.push_back({keys[i], static_cast<int>(i)});
+    }
+
+    algolab::ThreadPool pool(4);
+    algolab::sort_mt::mergeSortOn(items, pool, 512);
+
+    for (size_t i = 1; i < items.size(); ++i) {
+        ASSERT_LE(items[i - 1].key, items[i].key);
+        if (items[i - 1].key == items[i].key) {
+            ASSERT_LT(items[i - 1].seq, items[i].seq);
+        }
+    }
+}
+
+// A zero cutoff used to divide by zero when slicing the merges
+TEST(SortMtDebugTest, MergeSortOnTinyCutoff) {
+    algolab::ThreadPool pool(4);
+    for (int cutoff : {0, 1}) {
+        auto vec = algolab::generateRandomNumbers<int>(20000, 0, 1000);
+        auto expected = vec;
+        std::stable_sort(expected.begin(), expected.end());
+        algolab::sort_mt::mergeSortOn(vec, pool, cutoff);
+        EXPECT_EQ(vec, expected) << "cutoff " << cutoff;
+    }
+}
+
+// Small cutoff on a dedicated pool: 32 buckets, classified and scattered by 16 blocks
+TEST(SortMtDebugTest, SampleSortOnDedicatedPool) {
+    algolab::ThreadPool pool(4);
+    for (int maxValue : {1000000, 100, 0}) {
+        auto vec = algolab::generateRandomNumbers<int>(300000, 0, maxValue);
+        auto expected = vec;
+        std::sort(expected.begin(), expected.end());
+        algolab::sort_mt::sampleSortOn(vec, pool, 1024);
+        EXPECT_EQ(vec, expected) << "max value " << maxValue;
+    }
+}
 
-// TEST_P(SortingParameterizedTestMtInt, HandlesEmptyVector) {
-//     std::vector<int> vec;
-//     auto sort = GetParam().func;
+// Heavy duplicates go to equality buckets, the remaining keys still get sorted
+TEST(SortMtDebugTest, SampleSortSkewedAndStrings) {
+    algolab::ThreadPool pool(4);
+    auto vec = algolab::generateRandomNumbers<int>(200000, 0, 1000000);
+    for (size_t i = 0; i < vec.size(); i += 2) vec[i] = 424242;
+    auto expected = vec;
+    std::sort(expected.begin(), expected.end());
+    algolab::sort_mt::sampleSortOn(vec, pool, 1024);
+    EXPECT_EQ(vec, expected);
+
+    std::vector<std::string> words;
+    for (int value : algolab::generateRandomNumbers<int>(50000, 0, 5000)) {
+        words.push_back("w" + std::to_string(value));
+    }
+    auto sortedWords = words;
+    std::sort(sortedWords.begin(), sortedWords.end());
+    algolab::sort_mt::sampleSortOn(words, pool, 512);
+    EXPECT_EQ(words, sortedWords);
+}
+
+TEST(SortMtBenchmark, SampleSortVersusIntroSortMt) {
+    auto intro = algolab::generateRandomNumbers<int>(4000000, 0, 1000000);
+    auto sample = intro;
+
+    auto start = std::chrono::high_resolution_clock::now();
+    algolab::sort_mt::introSortAll(intro);
+    auto end = std::chrono::high_resolution_clock::now();
+    logTiming(std::format("IntroSortMt {} threads 4M items", algolab::ThreadPool::shared().size()), start, end);
+
+    start = std::chrono::high_resolution_clock::now();
+    algolab::sort_mt::sampleSortAll(sample);
+    end = std::chrono::high_resolution_clock::now();
+    logTiming(std::format("SampleSortMt {} threads 4M items", algolab::ThreadPool::shared().size()), start, end);
+
+    EXPECT_EQ(intro, sample);
+}
+
+TEST(SortMtBenchmark, IntroSortSequentialVsParallel) {
+    auto seq = algolab::generateRandomNumbers<int>(4000000, 0, 1000000);
+    auto par = seq;
+
+    auto start = std::chrono::high_resolution_clock::now();
+    algolab::sort_custom::introSortAll(seq);
+    auto end = std::chrono::high_resolution_clock::now();
+    logTiming("IntroSort sequential 4M items", start, end);
+
+    start = std::chrono::high_resolution_clock::now();
+    algolab::sort_mt::introSortAll(par);
+    end = std::chrono::high_resolution_clock::now();
+    logTiming(std::format("IntroSortMt {} threads 4M items", algolab::ThreadPool::shared().size()), start, end);
+
+    EXPECT_EQ(seq, par);
+}
+
+TEST_P(SortingParameterizedTestMtInt, HandlesEmptyVector) {
+    std::vector<int> vec;
+    auto sort = GetParam().func;
     
-//     auto start = std::chrono::high_resolution_clock::now();
-//     sort(vec);
-//     auto end = std::chrono::high_resolution_clock::now();
+    auto start = std::chrono::high_resolution_clock::now();
+    sort(vec);
+    auto end = std::chrono::high_resolution_clock::now();
 
-//     logTiming(GetParam().name + " (HandlesEmptyVector)", start, end);
+    logTiming(GetParam().name + " (HandlesEmptyVector)", start, end);
 
-//     EXPECT_TRUE(isSorted(vec));
-// }
+    EXPECT_TRUE(isSorted(vec));
+}
 
-// TEST_P(SortingParameterizedTestMtInt, HandlesSingleElement) {
-//     std::vector<int> vec = {42};
-//     auto sort = GetParam().func;
+TEST_P(SortingParameterizedTestMtInt, HandlesSingleElement) {
+    std::vector<int> vec = {42};
+    auto sort = GetParam().func;
     
-//     auto start = std::chrono::high_resolution_clock::now();
-//     sort(vec);
-//     auto end = std::chrono::high_resolution_clock::now();
+    auto start = std::chrono::high_resolution_clock::now();
+    sort(vec);
+    auto end = std::chrono::high_resolution_clock::now();
 
-//     logTiming(GetParam().name + " (HandlesSingleElement)", start, end);
+    logTiming(GetParam().name + " (HandlesSingleElement)", start, end);
 
-//     EXPECT_TRUE(isSorted(vec));
-// }
+    EXPECT_TRUE(isSorted(vec));
+}
 
-// TEST_P(SortingParameterizedTestMtInt, HandlesAlreadySorted) {
-//     std::vector<int> vec = {1, 2, 3, 4, 5};
-//     auto sort = GetParam().func;
+TEST_P(SortingParameterizedTestMtInt, HandlesAlreadySorted) {
+    std::vector<int> vec = {1, 2, 3, 4, 5};
+    auto sort = GetParam().func;
     
-//     auto start = std::chrono::high_resolution_clock::now();
-//     sort(vec);
-//     auto end = std::chrono::high_resolution_clock::now();
+    auto start = std::chrono::high_resolution_clock::now();
+    sort(vec);
+    auto end = std::chrono::high_resolution_clock::now();
 
-//     logTiming(GetParam().name + " (HandlesAlreadySorted)", start, end);
+    logTiming(GetParam().name + " (HandlesAlreadySorted)", start, end);
 
-//     EXPECT_TRUE(isSorted(vec));
-// }
+    EXPECT_TRUE(isSorted(vec));
+}
 
-// TEST_P(SortingParameterizedTestMtInt, HandlesReverseSorted) {
-//     std::vector<int> vec = {9, 7, 5, 3, 1};
-//     auto sort = GetParam().func;
+TEST_P(SortingParameterizedTestMtInt, HandlesReverseSorted) {
+    std::vector<int> vec = {9, 7, 5, 3, 1};
+    auto sort = GetParam().func;
     
-//     auto start = std::chrono::high_resolution_clock::now();
-//     sort(vec);
-//     auto end = std::chrono::high_resolution_clock::now();
+    auto start = std::chrono::high_resolution_clock::now();
+    sort(vec);
+    auto end = std::chrono::high_resolution_clock::now();
 
-//     logTiming(GetParam().name + " (HandlesReverseSorted)", start, end);
+    logTiming(GetParam().name + " (HandlesReverseSorted)", start, end);
 
-//     EXPECT_TRUE(isSorted(vec));
-// }
+    EXPECT_TRUE(isSorted(vec));
+}
 
 // ---- Instantiation ---- //
 
@@ -151,89 +292,95 @@ std::string NameFromStruct(const ::testing::TestParamInfo<NamedSortType>& info)
     return info.param.name;
 }
 
-// INSTANTIATE_TEST_SUITE_P(
-//     SortImplementations,
-//     SortingParameterizedTestMtInt,
-//     ::testing::Values(
-//         NamedSortInt{"QuickSortMt", algolab::sort_mt::quickSortAll<int>}
-//     ),
-//     NameFromStruct<NamedSortInt>
-// );
-
-
-// TEST_P(SortingParameterizedTestMtFloat, SortsRandomCorrectly) {
-//     std::vector<float> vec = generateRandom();
-//     auto sort = GetParam().func;
+INSTANTIATE_TEST_SUITE_P(
+    SortImplementations,
+    SortingParameterizedTestMtInt,
+    ::testing::Values(
+        NamedSortInt{"QuickSortMt", algolab::sort_mt::quickSortAll<int>},
+        NamedSortInt{"IntroSortMt", algolab::sort_mt::introSortAll<int>},
+        NamedSortInt{"MergeSortMt", algolab::sort_mt::mergeSortAll<int>},
+        NamedSortInt{"SampleSortMt", algolab::sort_mt::sampleSortAll<int>}
+    ),
+    NameFromStruct<NamedSortInt>
+);
+
+
+TEST_P(SortingParameterizedTestMtFloat, SortsRandomCorrectly) {
+    std::vector<float> vec = generateRandom();
+    auto sort = GetParam().func;
     
-//     auto start = std::chrono::high_resolution_clock::now();
-//     sort(vec);
-//     auto end = std::chrono::high_resolution_clock::now();
+    auto start = std::chrono::high_resolution_clock::now();
+    sort(vec);
+    auto end = std::chrono::high_resolution_clock::now();
 
-//     logTiming(GetParam().name + " (SortsRandomCorrectly)", start, end);
+    logTiming(GetParam().name + " (SortsRandomCorrectly)", start, end);
 
-//     EXPECT_TRUE(isSorted(vec));
-// }
+    EXPECT_TRUE(isSorted(vec));
+}
 
-// TEST_P(SortingParameterizedTestMtFloat, HandlesEmptyVector) {
-//     std::vector<float> vec;
-//     auto sort = GetParam().func;
+TEST_P(SortingParameterizedTestMtFloat, HandlesEmptyVector) {
+    std::vector<float> vec;
+    auto sort = GetParam().func;
     
-//     auto start = std::chrono::high_resolution_clock::now();
-//     sort(vec);
-//     auto end = std::chrono::high_resolution_clock::now();
+    auto start = std::chrono::high_resolution_clock::now();
+    sort(vec);
+    auto end = std::chrono::high_resolution_clock::now();
 
-//     logTiming(GetParam().name + " (HandlesEmptyVector)", start, end);
+    logTiming(GetParam().name + " (HandlesEmptyVector)", start, end);
 
-//     EXPECT_TRUE(isSorted(vec));
-// }
+    EXPECT_TRUE(isSorted(vec));
+}
 
 
-// TEST_P(SortingParameterizedTestMtFloat, HandlesSingleElement) {
-//     std::vector<float> vec = {42.2};
-//     auto sort = GetParam().func;
+TEST_P(SortingParameterizedTestMtFloat, HandlesSingleElement) {
+    std::vector<float> vec = {42.2};
+    auto sort = GetParam().func;
     
-//     auto start = std::chrono::high_resolution_clock::now();
-//     sort(vec);
-//     auto end = std::chrono::high_resolution_clock::now();
+    auto start = std::chrono::high_resolution_clock::now();
+    sort(vec);
+    auto end = std::chrono::high_resolution_clock::now();
 
-//     logTiming(GetParam().name + " (HandlesSingleElement)", start, end);
+    logTiming(GetParam().name + " (HandlesSingleElement)", start, end);
 
-//     EXPECT_TRUE(isSorted(vec));
-// }
+    EXPECT_TRUE(isSorted(vec));
+}
 
-// TEST_P(SortingParameterizedTestMtFloat, HandlesAlreadySorted) {
-//     std::vector<float> vec = {1.2, 2.1, 3.4, 4.7, 5.9};
-//     auto sort = GetParam().func;
+TEST_P(SortingParameterizedTestMtFloat, HandlesAlreadySorted) {
+    std::vector<float> vec = {1.2, 2.1, 3.4, 4.7, 5.9};
+    auto sort = GetParam().func;
     
-//     auto start = std::chrono::high_resolution_clock::now();
-//     sort(vec);
-//     auto end = std::chrono::high_resolution_clock::now();
+    auto start = std::chrono::high_resolution_clock::now();
+    sort(vec);
+    auto end = std::chrono::high_resolution_clock::now();
 
-//     logTiming(GetParam().name + " (HandlesAlreadySorted)", start, end);
+    logTiming(GetParam().name + " (HandlesAlreadySorted)", start, end);
 
-//     EXPECT_TRUE(isSorted(vec));
-// }
+    EXPECT_TRUE(isSorted(vec));
+}
 
-// TEST_P(SortingParameterizedTestMtFloat, HandlesReverseSorted) {
-//     std::vector<float> vec = {9.34f, 7.1f, 5.044f, 3.3f, 1.201f};
-//     auto sort = GetParam().func;
+TEST_P(SortingParameterizedTestMtFloat, HandlesReverseSorted) {
+    std::vector<float> vec = {9.34f, 7.1f, 5.044f, 3.3f, 1.201f};
+    auto sort = GetParam().func;
     
-//     auto start = std::chrono::high_resolution_clock::now();
-//     sort(vec);
-//     auto end = std::chrono::high_resolution_clock::now();
+    auto start = std::chrono::high_resolution_clock::now();
+    sort(vec);
+    auto end = std::chrono::high_resolution_clock::now();
 
-//     logTiming(GetParam().name + " (HandlesReverseSorted)", start, end);
+    logTiming(GetParam().name + " (HandlesReverseSorted)", start, end);
 
-//     EXPECT_TRUE(isSorted(vec));
-// }
+    EXPECT_TRUE(isSorted(vec));
+}
 
 // ---- Instantiation ---- //
 
-// INSTANTIATE_TEST_SUITE_P(
-//     SortImplementations,
-//     SortingParameterizedTestMtFloat,
-//     ::testing::Values(
-//         NamedSortFloat{"QuickSortMt", algolab::sort_mt::quickSortAll<float>}
-//     ),
-//     NameFromStruct<NamedSortFloat>
-// );
\ No newline at end of file
+INSTANTIATE_TEST_SUITE_P(
+    SortImplementations,
+    SortingParameterizedTestMtFloat,
+    ::testing::Values(
+        NamedSortFloat{"QuickSortMt", algolab::sort_mt::quickSortAll<float>},
+        NamedSortFloat{"IntroSortMt", algolab::sort_mt::introSortAll<float>},
+        NamedSortFloat{"MergeSortMt", algolab::sort_mt::mergeSortAll<float>},
+        NamedSortFloat{"SampleSortMt", algolab::sort_mt::sampleSortAll<float>}
+    ),
+    NameFromStruct<NamedSortFloat>
+);
\ No newline at end of file
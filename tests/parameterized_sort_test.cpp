@@ -11,6 +11,13 @@
 #include "sort.h"
 #include "sort_iterative.h"
 #include "introsort.h"
+#include "pdqsort.h"
+#include "timsort.h"
+#include "heapsort.h"
+#include "radix_sort.h"
+#include "sort_ranges.h"
+#include "string_sort.h"
+#include "sort_dispatch.h"
 #include "benchmark_logger.h"
 
 // inline void printTiming(const std::string& label,
@@ -48,6 +55,43 @@ void stdSortWrapper(std::vector<T>& vec) {
     std::sort(vec.begin(), vec.end());
 }
 
+// algolab::ranges entry points are overloaded templates, wrap them for std::function
+template <typename T>
+void rangesIntroSortWrapper(std::vector<T>& vec) {
+    algolab::ranges::introSortAll(vec);
+}
+
+template <typename T>
+void rangesMergeSortWrapper(std::vector<T>& vec) {
+    algolab::ranges::mergeSortAll(vec.begin(), vec.end());
+}
+
+template <typename T>
+void rangesHeapSortWrapper(std::vector<T>& vec) {
+    algolab::ranges::heapSort(vec);
+}
+
+template <typename T>
+void rangesQuickSortWrapper(std::vector<T>& vec) {
+    algolab::ranges::quickSortAll(vec.begin(), vec.end());
+}
+
+// algolab::sort_string entry points take any string range
+template <typename T>
+void multikeyQuickSortWrapper(std::vector<T>& vec) {
+    algolab::sort_string::multikeyQuickSortAll(vec);
+}
+
+template <typename T>
+void stringRadixSortWrapper(std::vector<T>& vec) {
+    algolab::sort_string::stringRadixSortAll(vec);
+}
+
+template <typename T>
+void lcpMergeSortWrapper(std::vector<T>& vec) {
+    algolab::sort_string::lcpMergeSortAll(vec);
+}
+
 using SortFunctionInt = std::function<void(std::vector<int>&)>;
 using SortFunctionFloat = std::function<void(std::vector<float>&)>;
 using SortFunctionString = std::function<void(std::vector<std::string>&)>;
@@ -320,7 +364,21 @@ INSTANTIATE_TEST_SUITE_P(
         NamedSortInt{"SelectionSort", algolab::selectionSort<int>},
         NamedSortInt{"HeapSort", algolab::heapSort<int>},
         NamedSortInt{"StdSort", stdSortWrapper<int>},
-        NamedSortInt{"IntroSort", algolab::sort_custom::introSortAll<int>}
+        NamedSortInt{"IntroSort", algolab::sort_custom::introSortAll<int>},
+        NamedSortInt{"IntroSortBlock", algolab::sort_custom::introSortAll<int, algolab::PartitionScheme::Block>},
+        NamedSortInt{"PdqSort", algolab::sort_custom::pdqSortAll<int>},
+        NamedSortInt{"TimSort", algolab::sort_custom::timSortAll<int>},
+        NamedSortInt{"QuickSortIterativeBlock", algolab::sort_iter::quickSortAll<int, algolab::PartitionScheme::Block>},
+        NamedSortInt{"RadixSortLSD", algolab::sort_radix::radixSortAll<int>},
+        NamedSortInt{"RadixSortMSD", algolab::sort_radix::msdRadixSortAll<int>},
+        NamedSortInt{"HeapSortBinaryTopDown", algolab::sort_heap::heapSortAll<int, 2, algolab::sort_heap::HeapSift::TopDown>},
+        NamedSortInt{"HeapSort4AryBottomUp", algolab::sort_heap::heapSortAll<int>},
+        NamedSortInt{"HeapSort8AryBottomUp", algolab::sort_heap::heapSortAll<int, 8>},
+        NamedSortInt{"RangesIntroSort", rangesIntroSortWrapper<int>},
+        NamedSortInt{"RangesMergeSort", rangesMergeSortWrapper<int>},
+        NamedSortInt{"RangesHeapSort", rangesHeapSortWrapper<int>},
+        NamedSortInt{"RangesQuickSort", rangesQuickSortWrapper<int>},
+        NamedSortInt{"Dispatch", algolab::sort<int>}
     ),
     NameFromStruct<NamedSortInt>
 );
@@ -336,7 +394,21 @@ INSTANTIATE_TEST_SUITE_P(
         NamedSortFloat{"SelectionSort", algolab::selectionSort<float>},
         NamedSortFloat{"HeapSort", algolab::heapSort<float>},
         NamedSortFloat{"StdSort", stdSortWrapper<float>},
-        NamedSortFloat{"IntroSort", algolab::sort_custom::introSortAll<float>}
+        NamedSortFloat{"IntroSort", algolab::sort_custom::introSortAll<float>},
+        NamedSortFloat{"IntroSortBlock", algolab::sort_custom::introSortAll<float, algolab::PartitionScheme::Block>},
+        NamedSortFloat{"PdqSort", algolab::sort_custom::pdqSortAll<float>},
+        NamedSortFloat{"TimSort", algolab::sort_custom::timSortAll<float>},
+        NamedSortFloat{"QuickSortIterativeBlock", algolab::sort_iter::quickSortAll<float, algolab::PartitionScheme::Block>},
+        NamedSortFloat{"RadixSortLSD", algolab::sort_radix::radixSortAll<float>},
+        NamedSortFloat{"RadixSortMSD", algolab::sort_radix::msdRadixSortAll<float>},
+        NamedSortFloat{"HeapSortBinaryTopDown", algolab::sort_heap::heapSortAll<float, 2, algolab::sort_heap::HeapSift::TopDown>},
+        NamedSortFloat{"HeapSort4AryBottomUp", algolab::sort_heap::heapSortAll<float>},
+        NamedSortFloat{"HeapSort8AryBottomUp", algolab::sort_heap::heapSortAll<float, 8>},
+        NamedSortFloat{"RangesIntroSort", rangesIntroSortWrapper<float>},
+        NamedSortFloat{"RangesMergeSort", rangesMergeSortWrapper<float>},
+        NamedSortFloat{"RangesHeapSort", rangesHeapSortWrapper<float>},
+        NamedSortFloat{"RangesQuickSort", rangesQuickSortWrapper<float>},
+        NamedSortFloat{"Dispatch", algolab::sort<float>}
     ),
     NameFromStruct<NamedSortFloat>
 );
@@ -351,7 +423,22 @@ INSTANTIATE_TEST_SUITE_P(
         NamedSortString{"QuickSortIterative", algolab::sort_iter::quickSortAll<std::string>},
         NamedSortString{"SelectionSort", algolab::selectionSort<std::string>},
         NamedSortString{"HeapSort", algolab::heapSort<std::string>},
-        NamedSortString{"StdSort", stdSortWrapper<std::string>}
+        NamedSortString{"StdSort", stdSortWrapper<std::string>},
+        NamedSortString{"IntroSortBlock", algolab::sort_custom::introSortAll<std::string, algolab::PartitionScheme::Block>},
+        NamedSortString{"PdqSort", algolab::sort_custom::pdqSortAll<std::string>},
+        NamedSortString{"TimSort", algolab::sort_custom::timSortAll<std::string>},
+        NamedSortString{"QuickSortIterativeBlock", algolab::sort_iter::quickSortAll<std::string, algolab::PartitionScheme::Block>},
+        NamedSortString{"HeapSortBinaryTopDown", algolab::sort_heap::heapSortAll<std::string, 2, algolab::sort_heap::HeapSift::TopDown>},
+        NamedSortString{"HeapSort4AryBottomUp", algolab::sort_heap::heapSortAll<std::string>},
+        NamedSortString{"HeapSort8AryBottomUp", algolab::sort_heap::heapSortAll<std::string, 8>},
+        NamedSortString{"RangesIntroSort", rangesIntroSortWrapper<std::string>},
+        NamedSortString{"RangesMergeSort", rangesMergeSortWrapper<std::string>},
+        NamedSortString{"RangesHeapSort", rangesHeapSortWrapper<std::string>},
+        NamedSortString{"RangesQuickSort", rangesQuickSortWrapper<std::string>},
+        NamedSortString{"MultikeyQuickSort", multikeyQuickSortWrapper<std::string>},
+        NamedSortString{"StringRadixSort", stringRadixSortWrapper<std::string>},
+        NamedSortString{"LcpMergeSort", lcpMergeSortWrapper<std::string>},
+        NamedSortString{"Dispatch", algolab::sort<std::string>}
     ),
     NameFromStruct<NamedSortString>
 );
\ No newline at end of file
@@ -0,0 +1,92 @@
+#include <gtest/gtest.h>
+#include <iostream>
+#include <chrono>
+#include <vector>
+#include <algorithm>
+#include <random>
+#include <string>
+#include <functional>
+#include "sort.h"
+#include "introsort.h"
+#include "pdqsort.h"
+
+/**
+ * @brief PdqSortTest class
+ * @details Test fixture for the pattern-defeating introsort mode
+ * Runs pdqSortAll on the input patterns it is designed for (presorted, reversed,
+ * few unique keys, organ pipe, sawtooth) and compares it with introSortAll.
+ */
+class PdqSortTest : public ::testing::Test {
+protected:
+    static constexpr int N = 1000000;
+
+    std::vector<std::pair<std::string, std::vector<int>>> patterns() const {
+        std::vector<std::pair<std::string, std::vector<int>>> result;
+
+        std::vector<int> ascending(N);
+        for (int i = 0; i < N; ++i) ascending[i] = i;
+        result.push_back({"Ascending", ascending});
+
+        result.push_back({"Descending", std::vector<int>(ascending.rbegin(), ascending.rend())});
+
+        std::vector<int> nearlySorted = ascending;
+        auto positions = algolab::generateRandomNumbers<int>(100, 0, N - 1);
+        for (size_t i = 0; i + 1 < positions.size(); i += 2) {
+            std::swap(nearlySorted[positions[i]], nearlySorted[positions[i + 1]]);
+        }
+        result.push_back({"NearlySorted", nearlySorted});
+
+        result.push_back({"FewUnique", algolab::generateRandomNumbers<int>(N, 0, 8)});
+        result.push_back({"AllEqual", std::vector<int>(N, 42)});
+
+        std::vector<int> organPipe(N);
+        for (int i = 0; i < N; ++i) organPipe[i] = i < N / 2 ? i : N - i;
+        result.push_back({"OrganPipe", organPipe});
+
+        std::vector<int> sawtooth(N);
+        for (int i = 0; i < N; ++i) sawtooth[i] = i % 1000;
+        result.push_back({"Sawtooth", sawtooth});
+
+        result.push_back({"Random", algolab::generateRandomNumbers<int>(N, 0, N)});
+        return result;
+    }
+
+    static double timeMs(const std::function<void()>& func) {
+        auto start = std::chrono::high_resolution_clock::now();
+        func();
+        auto end = std::chrono::high_resolution_clock::now();
+        return std::chrono::duration<double, std::milli>(end - start).count();
+    }
+};
+
+TEST_F(PdqSortTest, SortsPatterns) {
+    for (auto& [name, data] : patterns()) {
+        std::vector<int> expected = data;
+        std::sort(expected.begin(), expected.end());
+
+        algolab::sort_custom::pdqSortAll(data);
+        EXPECT_EQ(data, expected) << name;
+    }
+}
+
+TEST_F(PdqSortTest, SortsDuplicateHeavyStrings) {
+    std::vector<std::string> vec;
+    for (int value : algolab::generateRandomNumbers<int>(20000, 0, 20)) {
+        vec.push_back("symbol" + std::to_string(value));
+    }
+    algolab::sort_custom::pdqSortAll(vec);
+    EXPECT_TRUE(std::is_sorted(vec.begin(), vec.end()));
+}
+
+TEST_F(PdqSortTest, BenchmarkPatternsAgainstIntroSort) {
+    for (auto& [name, data] : patterns()) {
+        std::vector<int> intro = data;
+        std::vector<int> pdq = data;
+
+        double introMs = timeMs([&]() { algolab::sort_custom::introSortAll(intro); });
+        double pdqMs = timeMs([&]() { algolab::sort_custom::pdqSortAll(pdq); });
+
+        std::cout << name << " (1M int): IntroSort " << introMs << " ms, PdqSort " << pdqMs << " ms\n";
+        EXPECT_EQ(intro, pdq) << name;
+    }
+}
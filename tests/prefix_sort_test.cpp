@@ -0,0 +1,203 @@
+#include <gtest/gtest.h>
+#include <iostream>
+#include <chrono>
+#include <vector>
+#include <algorithm>
+#include <limits>
+#include <random>
+#include <string>
+#include <string_view>
+#include "sort.h"
+#include "sort_ranges.h"
+#include "prefix_sort.h"
+
+namespace sp = algolab::sort_prefix;
+
+/**
+ * @brief PrefixSortTest class
+ * @details Tests for the key-prefix caching sorts in algolab::sort_prefix
+ * Checks the order against std::sort / std::stable_sort and counts how many full
+ * comparisons the cached prefixes save.
+ */
+namespace {
+
+struct MarketQuote {
+    std::string symbol;
+    double price;
+    int id;
+};
+
+// Composite order: symbol, then price
+struct QuoteLess {
+    size_t* calls;
+    bool operator()(const MarketQuote& a, const MarketQuote& b) const {
+        ++*calls;
+        if (a.symbol != b.symbol) return a.symbol < b.symbol;
+        return a.price < b.price;
+    }
+};
+
+// Prefix of the leading field only: never complete, the price decides ties
+struct SymbolPrefix {
+    sp::KeyPrefix operator()(const MarketQuote& quote) const {
+        sp::KeyPrefix prefix = sp::NormalizedPrefix {}(quote.symbol);
+        prefix.complete = false;
+        return prefix;
+    }
+};
+
+} // namespace
+
+class PrefixSortTest : public ::testing::Test {
+protected:
+    std::vector<std::string> words(size_t n, size_t sharedPrefix, size_t maxExtra = 12) const {
+        std::mt19937 rng(7);
+        std::vector<std::string> result(n, std::string(sharedPrefix, 'x'));
+        for (auto& word : result) {
+            size_t extra = rng() % maxExtra;
+            for (size_t i = 0; i < extra; ++i) word.push_back(static_cast<char>('a' + rng() % 26));
+        }
+        return result;
+    }
+
+    std::vector<MarketQuote> quotes(size_t n) const {
+        static const char* symbols[] = {"AAPL", "MSFT", "GOOGL", "AMZN", "BRK.B", "NVDA", "TSLA", "META"};
+        auto prices = algolab::generateRandomNumbers<int>(static_cast<int>(n), 0, 500);
+        std::vector<MarketQuote> result;
+        for (size_t i = 0; i < n; ++i) {
+            result.push_back({symbols[prices[i] % 8], prices[i] / 4.0, static_cast<int>(i)});
+        }
+        return result;
+    }
+};
+
+TEST_F(PrefixSortTest, NormalizedPrefixOrdersLikeKeys) {
+    sp::NormalizedPrefix prefix;
+    EXPECT_LT(prefix(-3).bits, prefix(2).bits);
+    EXPECT_LT(prefix(-1.5).bits, prefix(-0.5).bits);
+    EXPECT_LT(prefix(1.0f).bits, prefix(2.0f).bits);
+    EXPECT_TRUE(prefix(42u).complete);
+
+    EXPECT_LT(prefix(std::string_view("ab")).bits, prefix(std::string_view("abc")).bits);
+    EXPECT_LT(prefix(std::string_view("ab")).bits, prefix(std::string_view("b")).bits);
+    EXPECT_LT(prefix(std::string_view("a\x7f")).bits, prefix(std::string_view("a\x80")).bits);
+    EXPECT_TRUE(prefix(std::string_view("AAPL")).complete);
+    EXPECT_FALSE(prefix(std::string_view("ABCDEFG")).complete);
+    EXPECT_EQ(prefix(std::string_view("ABCDEFGH")).bits, prefix(std::string_view("ABCDEFGZ")).bits);
+}
+
+TEST_F(PrefixSortTest, SortsStringsLikeStdSort) {
+    for (size_t shared : {0, 3, 10}) {
+        auto vec = words(20000, shared);
+        auto expected = vec;
+        std::sort(expected.begin(), expected.end());
+
+        auto intro = vec;
+        sp::prefixIntroSortAll(intro);
+        EXPECT_EQ(intro, expected);
+
+        sp::prefixMergeSortAll(vec);
+        EXPECT_EQ(vec, expected);
+    }
+}
+
+TEST_F(PrefixSortTest, SortsProjectedArithmeticKeys) {
+    auto vec = quotes(50000);
+    sp::prefixIntroSortAll(vec, std::ranges::greater {}, &MarketQuote::price,
+                           [](double price) { return sp::NormalizedPrefix {}(-price); });
+    EXPECT_TRUE(std::is_sorted(vec.begin(), vec.end(),
+                               [](const MarketQuote& a, const MarketQuote& b) { return a.price > b.price; }));
+
+    sp::prefixMergeSortAll(vec, {}, &MarketQuote::id);
+    for (size_t i = 0; i < vec.size(); ++i) ASSERT_EQ(vec[i].id, static_cast<int>(i));
+}
+
+// The default prefix only follows ascending order: other comparators sort without it
+TEST_F(PrefixSortTest, CustomComparatorWithDefaultPrefix) {
+    auto vec = words(20000, 2);
+    auto expected = vec;
+    std::sort(expected.begin(), expected.end(), std::greater<> {});
+
+    auto intro = vec;
+    sp::prefixIntroSortAll(intro, std::ranges::greater {});
+    EXPECT_EQ(intro, expected);
+
+    sp::prefixMergeSortAll(vec, std::ranges::greater {});
+    EXPECT_EQ(vec, expected);
+
+    auto byPrice = quotes(20000);
+    auto stable = byPrice;
+    auto descending = [](double a, double b) { return a > b; };
+    std::stable_sort(stable.begin(), stable.end(),
+                     [&](const MarketQuote& a, const MarketQuote& b) { return descending(a.price, b.price); });
+    sp::prefixMergeSortAll(byPrice, descending, &MarketQuote::price);
+    for (size_t i = 0; i < byPrice.size(); ++i) ASSERT_EQ(byPrice[i].id, stable[i].id);
+}
+
+// -0.0 and +0.0 compare equal: the stable sort keeps their input order
+TEST_F(PrefixSortTest, SignedZerosAreStable) {
+    sp::NormalizedPrefix prefix;
+    EXPECT_EQ(prefix(-0.0).bits, prefix(0.0).bits);
+    EXPECT_EQ(prefix(-0.0f).bits, prefix(0.0f).bits);
+    EXPECT_FALSE(prefix(std::numeric_limits<double>::quiet_NaN()).complete);
+
+    std::vector<MarketQuote> vec = {{"a", 0.0, 0}, {"b", -0.0, 1}, {"c", 1.0, 2}, {"d", -0.0, 3}, {"e", 0.0, 4}};
+    sp::prefixMergeSortAll(vec, {}, &MarketQuote::price);
+    std::string symbols;
+    for (const MarketQuote& quote : vec) symbols += quote.symbol;
+    EXPECT_EQ(symbols, "abdec");
+}
+
+TEST_F(PrefixSortTest, CompositeKeysAreStableAndSaveComparisons) {
+    auto vec = quotes(100000);
+    auto expected = vec;
+    size_t stdCalls = 0;
+    std::stable_sort(expected.begin(), expected.end(), QuoteLess {&stdCalls});
+
+    size_t plainCalls = 0;
+    auto plain = vec;
+    algolab::ranges::mergeSortAll(plain, QuoteLess {&plainCalls});
+
+    size_t prefixCalls = 0;
+    sp::prefixMergeSortAll(vec, QuoteLess {&prefixCalls}, {}, SymbolPrefix {});
+    ASSERT_EQ(vec.size(), expected.size());
+    for (size_t i = 0; i < vec.size(); ++i) ASSERT_EQ(vec[i].id, expected[i].id);
+
+    // Only quotes of the same symbol reach the comparator
+    std::cout << "Composite key comparisons (100K): mergeSortAll " << plainCalls << ", prefixMergeSortAll "
+              << prefixCalls << "\n";
+    EXPECT_LT(prefixCalls, plainCalls);
+}
+
+TEST_F(PrefixSortTest, BenchmarkStringsAgainstIntroSort) {
+    // Heap-allocated strings (past the small string buffer) whose prefixes mostly differ
+    auto data = words(1000000, 0, 32);
+    for (auto& word : data) word += "-XNYS-2026-10-16";
+
+    auto vec = data;
+    auto start = std::chrono::high_resolution_clock::now();
+    algolab::ranges::introSortAll(vec);
+    auto end = std::chrono::high_resolution_clock::now();
+    std::cout << "IntroSort (1M long strings) time: " << std::chrono::duration<double, std::milli>(end - start).count() << " ms\n";
+    auto expected = vec;
+
+    vec = data;
+    start = std::chrono::high_resolution_clock::now();
+    sp::prefixIntroSortAll(vec);
+    end = std::chrono::high_resolution_clock::now();
+    std::cout << "Prefix IntroSort (1M long strings) time: " << std::chrono::duration<double, std::milli>(end - start).count() << " ms\n";
+    EXPECT_EQ(vec, expected);
+
+    vec = data;
+    start = std::chrono::high_resolution_clock::now();
+    algolab::ranges::mergeSortAll(vec);
+    end = std::chrono::high_resolution_clock::now();
+    std::cout << "MergeSort (1M long strings) time: " << std::chrono::duration<double, std::milli>(end - start).count() << " ms\n";
+
+    vec = data;
+    start = std::chrono::high_resolution_clock::now();
+    sp::prefixMergeSortAll(vec);
+    end = std::chrono::high_resolution_clock::now();
+    std::cout << "Prefix MergeSort (1M long strings) time: " << std::chrono::duration<double, std::milli>(end - start).count() << " ms\n";
+    EXPECT_EQ(vec, expected);
+}
@@ -0,0 +1,90 @@
+#include <gtest/gtest.h>
+#include <iostream>
+#include <chrono>
+#include <vector>
+#include <algorithm>
+#include <random>
+#include <limits>
+#include <cstdint>
+#include "sort.h"
+#include "introsort.h"
+#include "radix_sort.h"
+
+/**
+ * @brief RadixSortTest class
+ * @details Test fixture for the LSD and MSD radix sorts
+ * Covers the key transforms: negative integers, full-width unsigned keys
+ * and floating point values on both sides of zero.
+ */
+class RadixSortTest : public ::testing::Test {
+protected:
+    template <typename T>
+    void expectBothSortLikeStd(std::vector<T> vec) {
+        std::vector<T> expected = vec;
+        std::sort(expected.begin(), expected.end());
+
+        std::vector<T> lsd = vec;
+        algolab::sort_radix::radixSortAll(lsd);
+        EXPECT_EQ(lsd, expected);
+
+        std::vector<T> msd = vec;
+        algolab::sort_radix::msdRadixSortAll(msd);
+        EXPECT_EQ(msd, expected);
+    }
+};
+
+TEST_F(RadixSortTest, KeyTransformPreservesOrder) {
+    using algolab::sort_radix::toRadixKey;
+    EXPECT_LT(toRadixKey(-5), toRadixKey(-1));
+    EXPECT_LT(toRadixKey(-1), toRadixKey(0));
+    EXPECT_LT(toRadixKey(std::numeric_limits<int>::min()), toRadixKey(std::numeric_limits<int>::max()));
+    EXPECT_LT(toRadixKey(-2.5f), toRadixKey(-1.0f));
+    EXPECT_LT(toRadixKey(-1.0), toRadixKey(0.0));
+    EXPECT_LT(toRadixKey(0.5), toRadixKey(1e300));
+    EXPECT_LT(toRadixKey(-std::numeric_limits<double>::infinity()), toRadixKey(-1e300));
+}
+
+TEST_F(RadixSortTest, SortsNegativeIntegers) {
+    expectBothSortLikeStd(algolab::generateRandomNumbers<int>(100000, -1000000, 1000000));
+    expectBothSortLikeStd(algolab::generateRandomNumbers<int64_t>(100000, std::numeric_limits<int64_t>::min(), std::numeric_limits<int64_t>::max()));
+}
+
+TEST_F(RadixSortTest, SortsUnsigned64) {
+    expectBothSortLikeStd(algolab::generateRandomNumbers<uint64_t>(100000, 0, std::numeric_limits<uint64_t>::max()));
+}
+
+TEST_F(RadixSortTest, SortsFloatingPoint) {
+    expectBothSortLikeStd(algolab::generateRandomNumbers<float>(100000, -1000.0f, 1000.0f));
+    expectBothSortLikeStd(algolab::generateRandomNumbers<double>(100000, -1e12, 1e12));
+}
+
+TEST_F(RadixSortTest, HandlesSmallAndDuplicateInputs) {
+    expectBothSortLikeStd(std::vector<int>{});
+    expectBothSortLikeStd(std::vector<int>{3, -1, 2});
+    expectBothSortLikeStd(std::vector<int>(1000, 7));
+    expectBothSortLikeStd(algolab::generateRandomNumbers<int>(10000, 0, 3));
+}
+
+TEST_F(RadixSortTest, BenchmarkAgainstIntroSort) {
+    auto data = algolab::generateRandomNumbers<int>(4000000, std::numeric_limits<int>::min(), std::numeric_limits<int>::max());
+
+    auto vec = data;
+    auto start = std::chrono::high_resolution_clock::now();
+    algolab::sort_custom::introSortAll(vec);
+    auto end = std::chrono::high_resolution_clock::now();
+    std::cout << "IntroSort (int, 4M) time: " << std::chrono::duration<double, std::milli>(end - start).count() << " ms\n";
+
+    vec = data;
+    start = std::chrono::high_resolution_clock::now();
+    algolab::sort_radix::radixSortAll(vec);
+    end = std::chrono::high_resolution_clock::now();
+    std::cout << "RadixSortLSD (int, 4M) time: " << std::chrono::duration<double, std::milli>(end - start).count() << " ms\n";
+    EXPECT_TRUE(std::is_sorted(vec.begin(), vec.end()));
+
+    vec = data;
+    start = std::chrono::high_resolution_clock::now();
+    algolab::sort_radix::msdRadixSortAll(vec);
+    end = std::chrono::high_resolution_clock::now();
+    std::cout << "RadixSortMSD (int, 4M) time: " << std::chrono::duration<double, std::milli>(end - start).count() << " ms\n";
+    EXPECT_TRUE(std::is_sorted(vec.begin(), vec.end()));
+}
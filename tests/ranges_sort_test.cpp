@@ -0,0 +1,150 @@
+#include <gtest/gtest.h>
+#include <iostream>
+#include <chrono>
+#include <vector>
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <span>
+#include <string>
+#include "sort.h"
+#include "sort_ranges.h"
+#include "vector.h"
+
+/**
+ * @brief RangesSortTest class
+ * @details Tests for the iterator / range based API in algolab::ranges
+ * Sorts storage the std::vector<T>& API cannot reach (algolab::Vector, raw buffers
+ * through std::span, sub-ranges) and checks comparators and projections.
+ */
+namespace {
+
+struct MarketQuote {
+    uint64_t id;
+    double price;
+};
+
+// Move-only type without a default constructor
+struct Order {
+    std::unique_ptr<int> qty;
+    explicit Order(int q) : qty(std::make_unique<int>(q)) {}
+};
+
+} // namespace
+
+class RangesSortTest : public ::testing::Test {
+protected:
+    static constexpr int N = 100000;
+
+    std::vector<int> input = algolab::generateRandomNumbers<int>(N, -1000000, 1000000);
+
+    std::vector<MarketQuote> quotes() const {
+        auto prices = algolab::generateRandomNumbers<int>(N, 0, 10000);
+        std::vector<MarketQuote> result;
+        result.reserve(prices.size());
+        for (size_t i = 0; i < prices.size(); ++i) {
+            result.push_back(MarketQuote{static_cast<uint64_t>(i), prices[i] / 100.0});
+        }
+        return result;
+    }
+};
+
+TEST_F(RangesSortTest, SortsAlgolabVector) {
+    algolab::Vector<int> vec;
+    for (int value : input) vec.push_back(value);
+
+    algolab::ranges::introSortAll(vec);
+    EXPECT_TRUE(std::is_sorted(vec.begin(), vec.end()));
+
+    algolab::ranges::heapSort(vec, std::ranges::greater{});
+    EXPECT_TRUE(std::is_sorted(vec.begin(), vec.end(), std::greater<int>{}));
+}
+
+TEST_F(RangesSortTest, SortsRawBufferThroughSpan) {
+    std::unique_ptr<int[]> buffer(new int[N]);
+    std::copy(input.begin(), input.end(), buffer.get());
+    std::span<int> view(buffer.get(), N);
+
+    algolab::ranges::quickSortAll(view);
+    EXPECT_TRUE(std::is_sorted(view.begin(), view.end()));
+
+    algolab::ranges::mergeSortAll(view, std::ranges::greater{});
+    EXPECT_TRUE(std::is_sorted(view.begin(), view.end(), std::greater<int>{}));
+}
+
+TEST_F(RangesSortTest, SortsSubRangeOnly) {
+    std::vector<int> expected = input;
+    std::sort(expected.begin() + 1000, expected.end() - 1000);
+
+    algolab::ranges::introSortAll(input.begin() + 1000, input.end() - 1000);
+    EXPECT_EQ(input, expected);
+}
+
+TEST_F(RangesSortTest, SortsByProjection) {
+    auto data = quotes();
+    auto byPrice = [](const MarketQuote& a, const MarketQuote& b) { return a.price < b.price; };
+
+    auto intro = data;
+    algolab::ranges::introSortAll(intro, {}, &MarketQuote::price);
+    EXPECT_TRUE(std::is_sorted(intro.begin(), intro.end(), byPrice));
+
+    auto heap = data;
+    algolab::ranges::heapSort(heap, {}, &MarketQuote::price);
+    EXPECT_TRUE(std::is_sorted(heap.begin(), heap.end(), byPrice));
+
+    auto quick = data;
+    algolab::ranges::quickSortAll(quick.begin(), quick.end(), std::ranges::greater{}, &MarketQuote::price);
+    EXPECT_TRUE(std::is_sorted(quick.rbegin(), quick.rend(), byPrice));
+}
+
+TEST_F(RangesSortTest, MergeSortByProjectionIsStable) {
+    auto data = quotes();
+    algolab::ranges::mergeSortAll(data, {}, &MarketQuote::price);
+
+    for (size_t i = 1; i < data.size(); ++i) {
+        ASSERT_LE(data[i - 1].price, data[i].price);
+        if (data[i - 1].price == data[i].price) {
+            ASSERT_LT(data[i - 1].id, data[i].id) << "Equal prices reordered at index " << i;
+        }
+    }
+}
+
+TEST_F(RangesSortTest, SortsMoveOnlyElements) {
+    std::vector<Order> orders;
+    for (int i = 0; i < 1000; ++i) orders.emplace_back(input[i]);
+    auto qty = [](const Order& o) { return *o.qty; };
+
+    algolab::ranges::mergeSortAll(orders, {}, qty);
+    EXPECT_TRUE(std::ranges::is_sorted(orders, {}, qty));
+
+    algolab::ranges::introSortAll(orders, std::ranges::greater{}, qty);
+    EXPECT_TRUE(std::ranges::is_sorted(orders, std::ranges::greater{}, qty));
+}
+
+TEST_F(RangesSortTest, HandlesEmptyAndSingleElement) {
+    std::vector<int> empty;
+    algolab::ranges::introSortAll(empty);
+    algolab::ranges::mergeSortAll(empty);
+    algolab::ranges::heapSort(empty);
+    algolab::ranges::quickSortAll(empty);
+    EXPECT_TRUE(empty.empty());
+
+    std::vector<int> single {7};
+    algolab::ranges::introSortAll(single);
+    algolab::ranges::mergeSortAll(single);
+    algolab::ranges::heapSort(single);
+    algolab::ranges::quickSortAll(single);
+    EXPECT_EQ(single, std::vector<int>{7});
+}
+
+TEST_F(RangesSortTest, HandlesDuplicates) {
+    auto few = algolab::generateRandomNumbers<int>(N, 0, 4);
+    for (auto sortFn : {+[](std::vector<int>& v) { algolab::ranges::introSortAll(v); },
+                        +[](std::vector<int>& v) { algolab::ranges::mergeSortAll(v); },
+                        +[](std::vector<int>& v) { algolab::ranges::heapSort(v); },
+                        +[](std::vector<int>& v) { algolab::ranges::quickSortAll(v); }}) {
+        auto data = few;
+        sortFn(data);
+        EXPECT_TRUE(std::is_sorted(data.begin(), data.end()));
+    }
+}
@@ -0,0 +1,121 @@
+#include <gtest/gtest.h>
+#include <iostream>
+#include <chrono>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include "sort.h"
+#include "introsort.h"
+#include "segmented_sort.h"
+
+namespace ss = algolab::sort_segment;
+
+namespace {
+
+// Offsets of segments with random sizes in [0, maxSize], plus a few given sizes
+std::vector<size_t> randomOffsets(size_t segments, size_t maxSize, std::vector<size_t> extraSizes = {}) {
+    std::mt19937 rng(12345);
+    std::uniform_int_distribution<size_t> size(0, maxSize);
+    std::vector<size_t> offsets {0};
+    for (size_t i = 0; i < segments; ++i) offsets.push_back(offsets.back() + size(rng));
+    for (size_t extra : extraSizes) offsets.push_back(offsets.back() + extra);
+    return offsets;
+}
+
+template <typename T>
+std::vector<T> sortedBySegment(std::vector<T> data, const std::vector<size_t>& offsets) {
+    for (size_t i = 0; i + 1 < offsets.size(); ++i) {
+        std::sort(data.begin() + offsets[i], data.begin() + offsets[i + 1]);
+    }
+    return data;
+}
+
+} // namespace
+
+TEST(SegmentedSortTest, EveryStrategySize) {
+    auto offsets = randomOffsets(3000, 80, {0, 1, 16, 17, 32, 33, 5000});
+    auto data = algolab::generateRandomNumbers<int>(static_cast<int>(offsets.back()), -1000, 1000);
+    auto expected = sortedBySegment(data, offsets);
+
+    auto sequential = data;
+    ss::segmentedSort(sequential, offsets);
+    EXPECT_EQ(sequential, expected);
+
+    algolab::ThreadPool pool(4);
+    ss::segmentedSortOn(data, offsets, pool);
+    EXPECT_EQ(data, expected);
+}
+
+// Segments above the cutoff are sorted by parallel introsort inside the same task group
+TEST(SegmentedSortTest, HugeSegmentsBetweenSmallOnes) {
+    auto offsets = randomOffsets(1000, 40, {200000, 3, 150000});
+    for (size_t extra : {7, 0, 90000}) offsets.push_back(offsets.back() + extra);
+    auto data = algolab::generateRandomNumbers<double>(static_cast<int>(offsets.back()), -1.0, 1.0);
+    auto expected = sortedBySegment(data, offsets);
+
+    algolab::ThreadPool pool(4);
+    ss::segmentedSortOn(data, offsets, pool, 4096);
+    EXPECT_EQ(data, expected);
+}
+
+TEST(SegmentedSortTest, StringsAndUntouchedTail) {
+    std::vector<std::string> words;
+    for (int value : algolab::generateRandomNumbers<int>(50000, 0, 100000)) {
+        words.push_back("q" + std::to_string(value));
+    }
+    auto offsets = randomOffsets(2000, 20);
+    ASSERT_LT(offsets.back(), words.size());
+    auto expected = sortedBySegment(words, offsets);
+
+    ss::segmentedSortAll(words, offsets);
+    EXPECT_EQ(words, expected);
+}
+
+TEST(SegmentedSortTest, InvalidOffsetsThrow) {
+    std::vector<int> data {3, 2, 1};
+    std::vector<size_t> decreasing {0, 2, 1};
+    std::vector<size_t> pastEnd {0, 4};
+    EXPECT_THROW(ss::segmentedSort(data, decreasing), std::invalid_argument);
+    EXPECT_THROW(ss::segmentedSortAll(data, pastEnd), std::invalid_argument);
+    EXPECT_EQ(data, (std::vector<int>{3, 2, 1}));
+
+    std::vector<size_t> none;
+    ss::segmentedSortAll(data, none);
+    EXPECT_EQ(data, (std::vector<int>{3, 2, 1}));
+}
+
+// One introSortAll per std::vector against one segmented sort of the flat buffer
+TEST(SegmentedSortBenchmark, QuoteListsAgainstIntroSortPerVector) {
+    auto offsets = randomOffsets(200000, 64);
+    auto data = algolab::generateRandomNumbers<double>(static_cast<int>(offsets.back()), 0.0, 1000.0);
+
+    std::vector<std::vector<double>> lists;
+    for (size_t i = 0; i + 1 < offsets.size(); ++i) {
+        lists.emplace_back(data.begin() + offsets[i], data.begin() + offsets[i + 1]);
+    }
+    auto start = std::chrono::high_resolution_clock::now();
+    for (auto& list : lists) algolab::sort_custom::introSortAll(list);
+    auto end = std::chrono::high_resolution_clock::now();
+    std::cout << "IntroSort per vector (200K lists) time: "
+              << std::chrono::duration<double, std::milli>(end - start).count() << " ms\n";
+
+    auto sequential = data;
+    start = std::chrono::high_resolution_clock::now();
+    ss::segmentedSort(sequential, offsets);
+    end = std::chrono::high_resolution_clock::now();
+    std::cout << "Segmented sort (1 thread) time: "
+              << std::chrono::duration<double, std::milli>(end - start).count() << " ms\n";
+
+    start = std::chrono::high_resolution_clock::now();
+    ss::segmentedSortAll(data, offsets);
+    end = std::chrono::high_resolution_clock::now();
+    std::cout << "Segmented sort (" << algolab::ThreadPool::shared().size() << " threads) time: "
+              << std::chrono::duration<double, std::milli>(end - start).count() << " ms\n";
+
+    EXPECT_EQ(data, sequential);
+    for (size_t i = 0; i < lists.size(); ++i) {
+        ASSERT_TRUE(std::equal(lists[i].begin(), lists[i].end(), data.begin() + offsets[i]));
+    }
+}
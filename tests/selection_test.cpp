@@ -0,0 +1,168 @@
+#include <gtest/gtest.h>
+#include <iostream>
+#include <chrono>
+#include <vector>
+#include <algorithm>
+#include <functional>
+#include <string>
+#include <utility>
+#include "sort.h"
+#include "selection.h"
+
+/**
+ * @brief SelectionTest class
+ * @details Test fixture for the selection engine (algolab::sort_select)
+ * Checks nthElement, multiSelect / quantiles, partialSort and topK against a fully
+ * sorted copy on random, presorted, reversed and duplicate-heavy inputs, and compares
+ * median / percentile queries with the copy-and-sort approach they replace.
+ */
+class SelectionTest : public ::testing::Test {
+protected:
+    static constexpr int N = 1000000;
+
+    std::vector<std::pair<std::string, std::vector<int>>> patterns(int n) const {
+        std::vector<std::pair<std::string, std::vector<int>>> result;
+        result.push_back({"Random", algolab::generateRandomNumbers<int>(n, 0, n)});
+        result.push_back({"FewUnique", algolab::generateRandomNumbers<int>(n, 0, 4)});
+
+        std::vector<int> ascending(n);
+        for (int i = 0; i < n; ++i) ascending[i] = i;
+        result.push_back({"Ascending", ascending});
+        result.push_back({"Descending", std::vector<int>(ascending.rbegin(), ascending.rend())});
+
+        std::vector<int> organPipe(n);
+        for (int i = 0; i < n; ++i) organPipe[i] = i < n / 2 ? i : n - i;
+        result.push_back({"OrganPipe", organPipe});
+        return result;
+    }
+
+    static void expectPartitionedAt(const std::vector<int>& data, size_t k, const std::vector<int>& sorted,
+                                    const std::string& label) {
+        ASSERT_EQ(data[k], sorted[k]) << label << " rank " << k;
+        for (size_t i = 0; i < k; ++i) ASSERT_LE(data[i], data[k]) << label << " rank " << k;
+        for (size_t i = k + 1; i < data.size(); ++i) ASSERT_GE(data[i], data[k]) << label << " rank " << k;
+    }
+
+    static double timeMs(const std::function<void()>& func) {
+        auto start = std::chrono::high_resolution_clock::now();
+        func();
+        auto end = std::chrono::high_resolution_clock::now();
+        return std::chrono::duration<double, std::milli>(end - start).count();
+    }
+};
+
+TEST_F(SelectionTest, NthElementPlacesEveryRank) {
+    for (int n : {1, 2, 3, 17, 600, 601, 5000, 100000}) {
+        for (auto& [name, data] : patterns(n)) {
+            std::vector<int> sorted = data;
+            std::sort(sorted.begin(), sorted.end());
+
+            for (size_t k : {size_t(0), size_t(n / 3), size_t(n / 2), size_t(n - 1)}) {
+                std::vector<int> work = data;
+                algolab::sort_select::nthElement(work.begin(), work.begin() + k, work.end());
+                expectPartitionedAt(work, k, sorted, name + " n=" + std::to_string(n));
+            }
+        }
+    }
+}
+
+TEST_F(SelectionTest, NthElementWithComparator) {
+    std::vector<std::string> words;
+    for (int value : algolab::generateRandomNumbers<int>(5000, 0, 100000)) {
+        words.push_back("w" + std::to_string(value));
+    }
+    std::vector<std::string> sorted = words;
+    std::sort(sorted.begin(), sorted.end(), std::greater<>{});
+
+    algolab::sort_select::nthElement(words.begin(), words.begin() + 100, words.end(), std::greater<>{});
+    EXPECT_EQ(words[100], sorted[100]);
+}
+
+TEST_F(SelectionTest, MultiSelectPlacesAllRanks) {
+    for (auto& [name, data] : patterns(N)) {
+        std::vector<int> sorted = data;
+        std::sort(sorted.begin(), sorted.end());
+
+        std::vector<size_t> ranks = {N - 1, 0, N / 2, N / 100, N / 2, 99 * (N / 100), N / 4};
+        algolab::sort_select::multiSelect(data.begin(), data.end(), ranks);
+        for (size_t k : ranks) {
+            EXPECT_EQ(data[k], sorted[k]) << name << " rank " << k;
+        }
+    }
+
+    std::vector<int> small = {3, 1, 2};
+    EXPECT_THROW(algolab::sort_select::multiSelect(small.begin(), small.end(), {3}), std::out_of_range);
+}
+
+TEST_F(SelectionTest, QuantilesInterpolate) {
+    std::vector<double> values = {15, 20, 35, 40, 50};
+    auto q = algolab::sort_select::quantiles(values.begin(), values.end(), {0.0, 0.25, 0.5, 0.4, 1.0});
+    EXPECT_DOUBLE_EQ(q[0], 15.0);
+    EXPECT_DOUBLE_EQ(q[1], 20.0);
+    EXPECT_DOUBLE_EQ(q[2], 35.0);
+    EXPECT_DOUBLE_EQ(q[3], 29.0);
+    EXPECT_DOUBLE_EQ(q[4], 50.0);
+
+    EXPECT_THROW(algolab::sort_select::quantiles(values.begin(), values.end(), {1.5}), std::invalid_argument);
+    std::vector<double> empty;
+    EXPECT_THROW(algolab::sort_select::quantiles(empty.begin(), empty.end(), {0.5}), std::runtime_error);
+}
+
+TEST_F(SelectionTest, PartialSortSortsPrefix) {
+    for (auto& [name, data] : patterns(100000)) {
+        std::vector<int> sorted = data;
+        std::sort(sorted.begin(), sorted.end());
+
+        for (size_t k : {size_t(0), size_t(1), size_t(100), size_t(50000)}) {
+            std::vector<int> work = data;
+            algolab::sort_select::partialSort(work.begin(), work.begin() + k, work.end());
+            EXPECT_TRUE(std::equal(work.begin(), work.begin() + k, sorted.begin())) << name << " k=" << k;
+        }
+    }
+}
+
+TEST_F(SelectionTest, TopKReturnsLargestFirst) {
+    auto prices = algolab::generateRandomNumbers<int>(N, 0, N);
+    std::vector<int> sorted = prices;
+    std::sort(sorted.begin(), sorted.end(), std::greater<>{});
+
+    auto top = algolab::sort_select::topK(prices, 10);
+    EXPECT_EQ(top, std::vector<int>(sorted.begin(), sorted.begin() + 10));
+
+    auto bottom = algolab::sort_select::topK(prices.begin(), prices.end(), 5, std::greater<>{});
+    EXPECT_EQ(bottom, std::vector<int>(sorted.rbegin(), sorted.rbegin() + 5));
+
+    EXPECT_TRUE(algolab::sort_select::topK(prices, 0).empty());
+    EXPECT_EQ(algolab::sort_select::topK(std::vector<int>{2, 1}, 5), (std::vector<int>{2, 1}));
+}
+
+TEST_F(SelectionTest, BenchmarkAgainstFullSort) {
+    auto data = algolab::generateRandomNumbers<int>(N, 0, N);
+
+    std::vector<int> sorted = data;
+    double sortMs = timeMs([&]() { std::sort(sorted.begin(), sorted.end()); });
+
+    std::vector<int> selected = data;
+    double nthMs = timeMs([&]() {
+        algolab::sort_select::nthElement(selected.begin(), selected.begin() + N / 2, selected.end());
+    });
+
+    std::vector<int> stdSelected = data;
+    double stdNthMs = timeMs([&]() {
+        std::nth_element(stdSelected.begin(), stdSelected.begin() + N / 2, stdSelected.end());
+    });
+
+    std::vector<int> percentiles = data;
+    std::vector<double> p;
+    double quantileMs = timeMs([&]() {
+        p = algolab::sort_select::quantiles(percentiles.begin(), percentiles.end(), {0.5, 0.9, 0.99, 0.999});
+    });
+
+    std::vector<int> top;
+    double topMs = timeMs([&]() { top = algolab::sort_select::topK(data, 100); });
+
+    std::cout << "1M int: std::sort " << sortMs << " ms, nthElement " << nthMs << " ms, std::nth_element "
+              << stdNthMs << " ms, 4 quantiles " << quantileMs << " ms, topK(100) " << topMs << " ms\n";
+    EXPECT_EQ(selected[N / 2], sorted[N / 2]);
+    EXPECT_EQ(top.front(), sorted.back());
+}
@@ -0,0 +1,135 @@
+#include <gtest/gtest.h>
+#include <iostream>
+#include <chrono>
+#include <vector>
+#include <algorithm>
+#include <random>
+#include <cmath>
+#include <limits>
+#include "sort.h"
+#include "introsort.h"
+#include "simd_network.h"
+
+/**
+ * @brief SimdNetworkTest class
+ * @details Test fixture for the vectorized sorting networks used by introsort leaves
+ * Tests are skipped when the target has no SSE4.1/AVX2 network for the type.
+ */
+template <typename T>
+class SimdNetworkTest : public ::testing::Test {
+protected:
+    std::vector<T> generate(int num) const {
+        if constexpr (std::is_integral_v<T>) {
+            return algolab::generateRandomNumbers<T>(num, -100, 100);
+        } else {
+            return algolab::generateRandomNumbers<T>(num, -100.0, 100.0);
+        }
+    }
+};
+
+using NetworkTypes = ::testing::Types<int, float, double>;
+TYPED_TEST_SUITE(SimdNetworkTest, NetworkTypes);
+
+TYPED_TEST(SimdNetworkTest, SortsEverySizeUpToSixteen) {
+    if constexpr (!algolab::sort_simd::hasNetwork<TypeParam>) {
+        GTEST_SKIP() << "No vectorized network on this target";
+    } else {
+        for (int n = 0; n <= algolab::sort_simd::NETWORK_SIZE; ++n) {
+            for (int round = 0; round < 200; ++round) {
+                std::vector<TypeParam> vec = this->generate(n);
+                std::vector<TypeParam> expected = vec;
+                std::sort(expected.begin(), expected.end());
+
+                algolab::sort_simd::sortSmall(vec.data(), n);
+                ASSERT_EQ(vec, expected) << "n = " << n;
+            }
+        }
+    }
+}
+
+// Neighbouring elements must not be touched
+TYPED_TEST(SimdNetworkTest, LeavesSurroundingElementsAlone) {
+    if constexpr (!algolab::sort_simd::hasNetwork<TypeParam>) {
+        GTEST_SKIP() << "No vectorized network on this target";
+    } else {
+        std::vector<TypeParam> vec = this->generate(30);
+        std::vector<TypeParam> expected = vec;
+        std::sort(expected.begin() + 7, expected.begin() + 18);
+
+        algolab::sort_simd::sortSmall(vec.data() + 7, 11);
+        EXPECT_EQ(vec, expected);
+    }
+}
+
+// -0.0 and 0.0 compare equal: min/max would keep one of them twice
+TYPED_TEST(SimdNetworkTest, SignedZerosArePermuted) {
+    if constexpr (!algolab::sort_simd::hasNetwork<TypeParam> || !std::is_floating_point_v<TypeParam>) {
+        GTEST_SKIP() << "No vectorized floating point network on this target";
+    } else {
+        std::vector<TypeParam> vec {0.0, -0.0, 3.0, -0.0, 0.0, -1.0, 0.0, -0.0, 2.0, -0.0, 0.0, 0.0, -0.0, 1.0, -2.0, 0.0};
+        algolab::sort_simd::sortSmall(vec.data(), 16);
+        EXPECT_TRUE(std::is_sorted(vec.begin(), vec.end()));
+        EXPECT_EQ(std::count_if(vec.begin(), vec.end(), [](TypeParam x) { return x == 0 && std::signbit(x); }), 5);
+        EXPECT_EQ(std::count_if(vec.begin(), vec.end(), [](TypeParam x) { return x == 0 && !std::signbit(x); }), 6);
+    }
+}
+
+// NaN has no place in the order, but no element may be lost or replaced by padding
+TYPED_TEST(SimdNetworkTest, NaNInputStaysAPermutation) {
+    if constexpr (!algolab::sort_simd::hasNetwork<TypeParam> || !std::is_floating_point_v<TypeParam>) {
+        GTEST_SKIP() << "No vectorized floating point network on this target";
+    } else {
+        const TypeParam nan = std::numeric_limits<TypeParam>::quiet_NaN();
+        for (int n : {5, 12, 16}) {
+            std::vector<TypeParam> vec = this->generate(n);
+            vec[n / 2] = nan;
+            vec[0] = -0.0;
+            auto expected = vec;
+
+            algolab::sort_simd::sortSmall(vec.data(), n);
+            EXPECT_EQ(std::count_if(vec.begin(), vec.end(), [](TypeParam x) { return std::isnan(x); }), 1);
+            EXPECT_EQ(std::count_if(vec.begin(), vec.end(), [](TypeParam x) { return std::isinf(x); }), 0);
+            std::erase_if(expected, [](TypeParam x) { return std::isnan(x); });
+            std::erase_if(vec, [](TypeParam x) { return std::isnan(x); });
+            std::sort(expected.begin(), expected.end());
+            std::sort(vec.begin(), vec.end());
+            EXPECT_EQ(vec, expected) << "n = " << n;
+        }
+    }
+}
+
+TYPED_TEST(SimdNetworkTest, IntroSortWithNetworkLeaves) {
+    std::vector<TypeParam> vec = this->generate(100000);
+    algolab::sort_custom::introSortAll(vec);
+    EXPECT_TRUE(std::is_sorted(vec.begin(), vec.end()));
+}
+
+TEST(SimdNetworkBenchmark, LeafSortAgainstInsertionSort) {
+    if constexpr (!algolab::sort_simd::hasNetwork<int>) {
+        GTEST_SKIP() << "No vectorized network on this target";
+    } else {
+        constexpr int leaves = 200000;
+        constexpr int leafSize = 16;
+        auto data = algolab::generateRandomNumbers<int>(leaves * leafSize, 0, 1000000);
+
+        auto vec = data;
+        auto start = std::chrono::high_resolution_clock::now();
+        for (int i = 0; i < leaves; ++i) {
+            algolab::sort_custom::insertionSort(vec, i * leafSize, (i + 1) * leafSize - 1);
+        }
+        auto end = std::chrono::high_resolution_clock::now();
+        std::cout << "InsertionSort (16-element leaves) time: "
+                  << std::chrono::duration<double, std::milli>(end - start).count() << " ms\n";
+
+        auto net = data;
+        start = std::chrono::high_resolution_clock::now();
+        for (int i = 0; i < leaves; ++i) {
+            algolab::sort_simd::sortSmall(net.data() + i * leafSize, leafSize);
+        }
+        end = std::chrono::high_resolution_clock::now();
+        std::cout << "SIMD network (16-element leaves) time: "
+                  << std::chrono::duration<double, std::milli>(end - start).count() << " ms\n";
+
+        EXPECT_EQ(vec, net);
+    }
+}
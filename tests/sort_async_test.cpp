@@ -0,0 +1,192 @@
+#include <gtest/gtest.h>
+#include <iostream>
+#include <chrono>
+#include <coroutine>
+#include <future>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+#include <algorithm>
+#include "sort.h"
+#include "sort_mt.h"
+#include "sort_async.h"
+
+namespace sa = algolab::sort_async;
+
+namespace {
+
+// Key with an arrival index that the comparison ignores, to observe stability
+struct Tagged {
+    int key = 0;
+    int index = 0;
+    bool operator<(const Tagged& other) const { return key < other.key; }
+    bool operator==(const Tagged&) const = default;
+};
+
+// Fire-and-forget coroutine, enough to co_await a SortFuture in a test
+struct DetachedTask {
+    struct promise_type {
+        DetachedTask get_return_object() { return {}; }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() {}
+        void unhandled_exception() { std::terminate(); }
+    };
+};
+
+DetachedTask sortThenSignal(std::vector<int>& vec, algolab::ThreadPool& pool, std::promise<bool>& result) {
+    co_await sa::introSortAsync(vec, pool);
+    result.set_value(std::is_sorted(vec.begin(), vec.end()));
+}
+
+// Holds the only worker of a pool until release() is called
+class PoolGate {
+public:
+    explicit PoolGate(algolab::ThreadPool& pool) {
+        pool.submit([this]() { released_.get_future().wait(); });
+    }
+    void release() { released_.set_value(); }
+
+private:
+    std::promise<void> released_;
+};
+
+} // namespace
+
+TEST(SortAsync, IntroSortReportsIncreasingProgress) {
+    algolab::ThreadPool pool(4);
+    auto vec = algolab::generateRandomNumbers<int>(300000, 0, 1000000);
+    auto expected = vec;
+    std::sort(expected.begin(), expected.end());
+
+    std::mutex mutex;
+    std::vector<size_t> reports;
+    sa::AsyncSortOptions options;
+    options.grain = 4096;
+    options.onProgress = [&](size_t done, size_t total) {
+        std::scoped_lock lock(mutex);
+        EXPECT_EQ(total, vec.size());
+        reports.push_back(done);
+    };
+
+    auto future = sa::introSortAsync(vec, pool, options);
+    future.get();
+
+    EXPECT_EQ(vec, expected);
+    ASSERT_FALSE(reports.empty());
+    EXPECT_TRUE(std::is_sorted(reports.begin(), reports.end()));
+    EXPECT_EQ(reports.back(), vec.size());
+    EXPECT_EQ(future.progressDone(), future.progressTotal());
+}
+
+TEST(SortAsync, MergeSortIsStable) {
+    algolab::ThreadPool pool(4);
+    auto keys = algolab::generateRandomNumbers<int>(100000, 0, 500);
+    std::vector<Tagged> vec;
+    for (int i = 0; i < static_cast<int>(keys.size()); ++i) vec.push_back({keys[i], i});
+    auto expected = vec;
+    std::stable_sort(expected.begin(), expected.end());
+
+    sa::AsyncSortOptions options;
+    options.grain = 1000;
+    sa::mergeSortAsync(vec, pool, options).get();
+    EXPECT_EQ(vec, expected);
+}
+
+TEST(SortAsync, EmptyAndTinyInputs) {
+    std::vector<int> empty;
+    sa::introSortAsync(empty).get();
+    sa::mergeSortAsync(empty).get();
+
+    std::vector<int> one {7};
+    sa::introSortAsync(one).get();
+    sa::mergeSortAsync(one).get();
+    EXPECT_EQ(one, std::vector<int>{7});
+}
+
+TEST(SortAsync, StopBeforeStartCancels) {
+    algolab::ThreadPool pool(1);
+    auto vec = algolab::generateRandomNumbers<int>(100000, 0, 1000000);
+    auto sortedInput = vec;
+    std::sort(sortedInput.begin(), sortedInput.end());
+
+    PoolGate gate(pool);
+    auto intro = sa::introSortAsync(vec, pool);
+    EXPECT_TRUE(intro.requestStop());
+    EXPECT_FALSE(intro.wait_for(std::chrono::milliseconds(10)));
+    gate.release();
+
+    EXPECT_THROW(intro.get(), sa::SortCancelled);
+    std::sort(vec.begin(), vec.end());
+    EXPECT_EQ(vec, sortedInput);
+}
+
+// A stop requested half way leaves a permutation of the input
+TEST(SortAsync, StopTokenCancelsRunningSort) {
+    algolab::ThreadPool pool(2);
+    for (bool merge : {false, true}) {
+        auto vec = algolab::generateRandomNumbers<int>(400000, 0, 1000000);
+        auto sortedInput = vec;
+        std::sort(sortedInput.begin(), sortedInput.end());
+
+        std::stop_source stop;
+        sa::AsyncSortOptions options;
+        options.grain = 2048;
+        options.stopToken = stop.get_token();
+        options.onProgress = [&stop](size_t done, size_t total) {
+            if (2 * done >= total / 3) stop.request_stop();
+        };
+
+        auto future = merge ? sa::mergeSortAsync(vec, pool, options) : sa::introSortAsync(vec, pool, options);
+        EXPECT_THROW(future.get(), sa::SortCancelled) << (merge ? "merge" : "intro");
+        EXPECT_LT(future.progressDone(), future.progressTotal());
+
+        std::sort(vec.begin(), vec.end());
+        EXPECT_EQ(vec, sortedInput);
+    }
+}
+
+TEST(SortAsync, SorterExceptionReachesFuture) {
+    algolab::ThreadPool pool(2);
+    std::vector<int> vec {3, 1, 2};
+    auto future = sa::sortAsync(vec, pool, [](std::vector<int>&) { throw std::runtime_error("bad comparator"); });
+    EXPECT_THROW(future.get(), std::runtime_error);
+
+    auto sorted = sa::sortAsync(vec, pool, [](std::vector<int>& v) { algolab::mergeSortAll(v); });
+    sorted.get();
+    EXPECT_EQ(vec, (std::vector<int>{1, 2, 3}));
+}
+
+TEST(SortAsync, CoroutineAwaitsSort) {
+    algolab::ThreadPool pool(2);
+    auto vec = algolab::generateRandomNumbers<int>(200000, 0, 1000000);
+
+    std::promise<bool> result;
+    auto sorted = result.get_future();
+    sortThenSignal(vec, pool, result);
+    EXPECT_TRUE(sorted.get());
+}
+
+// Time the calling thread is blocked: only the launch, against the whole sort
+TEST(SortAsyncBenchmark, LaunchLatencyAgainstBlockingSort) {
+    auto blocking = algolab::generateRandomNumbers<int>(4000000, 0, 1000000);
+    auto async = blocking;
+
+    auto start = std::chrono::high_resolution_clock::now();
+    algolab::sort_mt::introSortAll(blocking);
+    auto end = std::chrono::high_resolution_clock::now();
+    std::cout << "IntroSortMt blocking (4M ints) time: "
+              << std::chrono::duration<double, std::milli>(end - start).count() << " ms\n";
+
+    start = std::chrono::high_resolution_clock::now();
+    auto future = sa::introSortAsync(async);
+    end = std::chrono::high_resolution_clock::now();
+    std::cout << "introSortAsync launch time: "
+              << std::chrono::duration<double, std::micro>(end - start).count() << " us\n";
+    future.get();
+    auto done = std::chrono::high_resolution_clock::now();
+    std::cout << "introSortAsync completion time: "
+              << std::chrono::duration<double, std::milli>(done - start).count() << " ms\n";
+
+    EXPECT_EQ(blocking, async);
+}
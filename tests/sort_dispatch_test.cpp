@@ -0,0 +1,225 @@
+#include <gtest/gtest.h>
+#include <iostream>
+#include <chrono>
+#include <vector>
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <string>
+#include <utility>
+#include "sort.h"
+#include "introsort.h"
+#include "sort_dispatch.h"
+
+/**
+ * @brief SortDispatchTest class
+ * @details Test fixture for the adaptive dispatcher algolab::sort
+ * Checks which algorithm is chosen per type, size, presortedness and thread count,
+ * that every path sorts like std::sort, the threshold file round trip, a
+ * calibration run, and benchmarks algolab::sort against introSortAll.
+ */
+class SortDispatchTest : public ::testing::Test {
+protected:
+    static constexpr int N = 1000000;
+
+    std::filesystem::path path;
+
+    void SetUp() override {
+        path = std::filesystem::temp_directory_path()
+            / ("algolab_thresholds_" + std::to_string(::testing::UnitTest::GetInstance()->random_seed()) + ".txt");
+        std::filesystem::remove(path);
+    }
+
+    void TearDown() override {
+        std::filesystem::remove(path);
+    }
+
+    static algolab::SortThresholds testThresholds() {
+        algolab::SortThresholds thresholds;
+        thresholds.insertionMax = 16;
+        thresholds.radixMin = 512;
+        thresholds.stringRadixMin = 256;
+        thresholds.parallelMin = 100000;
+        thresholds.presortedMaxDescents = 1.0 / 32;
+        return thresholds;
+    }
+
+    template <typename T>
+    static void expectSortsLikeStd(std::vector<T> data, algolab::ThreadPool& pool,
+                                   const algolab::SortThresholds& thresholds) {
+        auto expected = data;
+        std::sort(expected.begin(), expected.end());
+        algolab::sortOn(data, pool, thresholds);
+        ASSERT_EQ(data, expected) << "n=" << data.size();
+    }
+
+    static double timeMs(const std::function<void()>& func) {
+        auto start = std::chrono::high_resolution_clock::now();
+        func();
+        auto end = std::chrono::high_resolution_clock::now();
+        return std::chrono::duration<double, std::milli>(end - start).count();
+    }
+};
+
+TEST_F(SortDispatchTest, ChoosesByTypeSizeOrderAndThreads) {
+    using algolab::SortAlgorithm;
+    using algolab::chooseSortAlgorithm;
+    const auto thresholds = testThresholds();
+
+    EXPECT_EQ(chooseSortAlgorithm(std::vector<int>{7}, 1, thresholds), SortAlgorithm::None);
+    EXPECT_EQ(chooseSortAlgorithm(std::vector<int>{3, 1, 2}, 1, thresholds),
+              algolab::sort_simd::hasNetwork<int> ? SortAlgorithm::Network : SortAlgorithm::Insertion);
+    EXPECT_EQ(chooseSortAlgorithm(std::vector<std::string>{"b", "a"}, 1, thresholds), SortAlgorithm::Insertion);
+
+    auto random = algolab::generateRandomNumbers<int>(200000, 0, 1000000);
+    EXPECT_EQ(chooseSortAlgorithm(random, 1, thresholds), SortAlgorithm::Radix);
+    EXPECT_EQ(chooseSortAlgorithm(random, 4, thresholds), SortAlgorithm::Parallel);
+    EXPECT_EQ(chooseSortAlgorithm(std::vector<int>(random.begin(), random.begin() + 100), 4, thresholds),
+              SortAlgorithm::Pdq);
+    EXPECT_EQ(chooseSortAlgorithm(algolab::generateRandomNumbers<double>(5000, -1.0, 1.0), 1, thresholds),
+              SortAlgorithm::Radix);
+
+    auto sorted = random;
+    std::sort(sorted.begin(), sorted.end());
+    EXPECT_EQ(chooseSortAlgorithm(sorted, 4, thresholds), SortAlgorithm::Tim);
+    std::reverse(sorted.begin(), sorted.end());
+    EXPECT_EQ(chooseSortAlgorithm(sorted, 4, thresholds), SortAlgorithm::Tim);
+
+    std::vector<std::string> words;
+    for (int v : algolab::generateRandomNumbers<int>(1000, 0, 1000000)) words.push_back(std::to_string(v));
+    EXPECT_EQ(chooseSortAlgorithm(words, 1, thresholds), SortAlgorithm::StringRadix);
+
+    std::vector<std::pair<int, int>> pairs;
+    for (int v : algolab::generateRandomNumbers<int>(1000, 0, 1000000)) pairs.emplace_back(v, -v);
+    EXPECT_EQ(chooseSortAlgorithm(pairs, 1, thresholds), SortAlgorithm::Pdq);
+
+    auto noRadix = thresholds;
+    noRadix.radixMin = algolab::SORT_NEVER;
+    EXPECT_EQ(chooseSortAlgorithm(random, 1, noRadix), SortAlgorithm::Pdq);
+}
+
+TEST_F(SortDispatchTest, EveryPathSortsLikeStdSort) {
+    algolab::ThreadPool pool(4);
+    const auto thresholds = testThresholds();
+
+    for (int n : {0, 1, 2, 5, 16, 17, 100, 1000, 5000, 300000}) {
+        auto random = algolab::generateRandomNumbers<int>(n, -n, n);
+        expectSortsLikeStd(random, pool, thresholds);
+        expectSortsLikeStd(algolab::generateRandomNumbers<int>(n, 0, 3), pool, thresholds);
+        expectSortsLikeStd(algolab::generateRandomNumbers<double>(n, -1.0, 1.0), pool, thresholds);
+
+        std::sort(random.begin(), random.end());
+        for (int i = 0; i < n / 100; ++i) random[(i * 7919) % n] = i;
+        expectSortsLikeStd(random, pool, thresholds);
+        std::reverse(random.begin(), random.end());
+        expectSortsLikeStd(random, pool, thresholds);
+    }
+
+    std::vector<std::string> words;
+    for (int v : algolab::generateRandomNumbers<int>(20000, 0, 1000000)) words.push_back("K" + std::to_string(v));
+    expectSortsLikeStd(words, pool, thresholds);
+
+    std::vector<std::pair<int, int>> pairs;
+    for (int v : algolab::generateRandomNumbers<int>(20000, 0, 100)) pairs.emplace_back(v, -v);
+    expectSortsLikeStd(pairs, pool, thresholds);
+
+    auto data = algolab::generateRandomNumbers<int>(50000, 0, 1000000);
+    auto expected = data;
+    std::sort(expected.begin(), expected.end());
+    algolab::sort(data);
+    EXPECT_EQ(data, expected);
+}
+
+TEST_F(SortDispatchTest, ThresholdFileRoundTrip) {
+    auto thresholds = testThresholds();
+    thresholds.parallelMin = algolab::SORT_NEVER;
+    thresholds.presortedMaxDescents = 0.0234375;
+    algolab::saveSortThresholds(thresholds, path);
+    EXPECT_EQ(algolab::loadSortThresholds(path), thresholds);
+
+    EXPECT_THROW(algolab::loadSortThresholds(path.string() + ".missing"), std::runtime_error);
+
+    std::ofstream(path) << "radixMin = 2048\n";
+    auto partial = algolab::loadSortThresholds(path);
+    EXPECT_EQ(partial.radixMin, 2048u);
+    EXPECT_EQ(partial.insertionMax, algolab::SortThresholds{}.insertionMax);
+
+    std::ofstream(path) << "radixMin 2048\n";
+    EXPECT_THROW(algolab::loadSortThresholds(path), std::invalid_argument);
+    std::ofstream(path) << "radixMin = lots\n";
+    EXPECT_THROW(algolab::loadSortThresholds(path), std::invalid_argument);
+    std::ofstream(path) << "mergeMin = 10\n";
+    EXPECT_THROW(algolab::loadSortThresholds(path), std::invalid_argument);
+}
+
+// The network sorts a padded copy of 16 elements: a larger networkMax must not reach it
+TEST_F(SortDispatchTest, NetworkMaxIsBoundedByNetworkSize) {
+    const auto previous = algolab::sortThresholds();
+    auto thresholds = testThresholds();
+    thresholds.networkMax = 40;
+    thresholds.insertionMax = 40;
+
+    auto data = algolab::generateRandomNumbers<int>(30, -1000, 1000);
+    EXPECT_EQ(algolab::chooseSortAlgorithm(data, 1, thresholds), algolab::SortAlgorithm::Insertion);
+    algolab::ThreadPool pool(1);
+    expectSortsLikeStd(data, pool, thresholds);
+
+    algolab::setSortThresholds(thresholds);
+    EXPECT_EQ(algolab::sortThresholds().networkMax, static_cast<size_t>(algolab::sort_simd::NETWORK_SIZE));
+    auto expected = data;
+    std::sort(expected.begin(), expected.end());
+    algolab::sort(data);
+    EXPECT_EQ(data, expected);
+    algolab::setSortThresholds(previous);
+
+    std::ofstream(path) << "networkMax = 40\n";
+    EXPECT_THROW(algolab::loadSortThresholds(path), std::invalid_argument);
+}
+
+TEST_F(SortDispatchTest, CalibratesAndPersistsThresholds) {
+    const auto previous = algolab::sortThresholds();
+
+    auto calibrated = algolab::loadOrCalibrateSortThresholds(path);
+    std::cout << "Calibrated: insertionMax " << calibrated.insertionMax << ", radixMin " << calibrated.radixMin
+              << ", stringRadixMin " << calibrated.stringRadixMin << ", parallelMin " << calibrated.parallelMin
+              << ", presortedMaxDescents " << calibrated.presortedMaxDescents << "\n";
+    EXPECT_TRUE(std::filesystem::exists(path));
+    EXPECT_EQ(algolab::sortThresholds(), calibrated);
+    EXPECT_LE(calibrated.insertionMax, 64u);
+    if (algolab::ThreadPool::shared().size() == 1) {
+        EXPECT_EQ(calibrated.parallelMin, algolab::SORT_NEVER);
+    }
+
+    // The second call loads the file instead of measuring again
+    EXPECT_EQ(algolab::loadOrCalibrateSortThresholds(path), calibrated);
+
+    auto data = algolab::generateRandomNumbers<int>(100000, 0, 1000000);
+    auto expected = data;
+    std::sort(expected.begin(), expected.end());
+    algolab::sort(data);
+    EXPECT_EQ(data, expected);
+
+    algolab::setSortThresholds(previous);
+}
+
+TEST_F(SortDispatchTest, BenchmarkAgainstIntroSort) {
+    auto random = algolab::generateRandomNumbers<int>(N, 0, N);
+    auto nearlySorted = random;
+    std::sort(nearlySorted.begin(), nearlySorted.end());
+    for (int i = 0; i < N / 1000; ++i) std::swap(nearlySorted[(i * 7919) % N], nearlySorted[(i * 104729) % N]);
+
+    for (const auto& [label, data] : {std::pair{"random", &random}, std::pair{"nearly sorted", &nearlySorted}}) {
+        auto intro = *data;
+        double introMs = timeMs([&]() { algolab::sort_custom::introSortAll(intro); });
+
+        auto dispatched = *data;
+        auto algorithm = algolab::chooseSortAlgorithm(dispatched, algolab::ThreadPool::shared().size(),
+                                                      algolab::sortThresholds());
+        double dispatchMs = timeMs([&]() { algolab::sort(dispatched); });
+
+        std::cout << "1M int " << label << ": introSortAll " << introMs << " ms, algolab::sort " << dispatchMs
+                  << " ms (algorithm " << static_cast<int>(algorithm) << ")\n";
+        EXPECT_EQ(dispatched, intro);
+    }
+}
@@ -0,0 +1,102 @@
+#include <gtest/gtest.h>
+#include <iostream>
+#include <chrono>
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include "sort.h"
+#include "sort_unique.h"
+#include "hashset.h"
+
+namespace {
+
+template <typename T>
+std::vector<T> sortThenUnique(std::vector<T> vec) {
+    std::sort(vec.begin(), vec.end());
+    vec.erase(std::unique(vec.begin(), vec.end()), vec.end());
+    return vec;
+}
+
+} // namespace
+
+TEST(SortUniqueTest, MatchesSortThenUnique) {
+    for (int n : {0, 1, 2, 31, 32, 33, 100, 1000, 65537}) {
+        for (int range : {1, 10, 1000, 1000000}) {
+            auto vec = algolab::generateRandomNumbers<int>(n, 0, range);
+            auto expected = sortThenUnique(vec);
+            EXPECT_EQ(algolab::sort_custom::sortUnique(vec), expected.size()) << "n = " << n << ", range = " << range;
+            EXPECT_EQ(vec, expected) << "n = " << n << ", range = " << range;
+        }
+    }
+}
+
+TEST(SortUniqueTest, SortedReversedAndAllEqual) {
+    std::vector<int> sorted(10000);
+    for (int i = 0; i < 10000; ++i) sorted[i] = i / 3;
+    std::vector<int> reversed(sorted.rbegin(), sorted.rend());
+    std::vector<int> equal(10000, 42);
+
+    for (auto* vec : {&sorted, &reversed, &equal}) {
+        auto expected = sortThenUnique(*vec);
+        algolab::sort_custom::sortUnique(*vec);
+        EXPECT_EQ(*vec, expected);
+    }
+}
+
+// A negative NaN is sorted first by the radix route and must not swallow the other keys
+TEST(SortUniqueTest, FloatingPointNaNAndSignedZeros) {
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    std::vector<double> vec {3.0, 1.0, -nan, 2.0, 1.0};
+    EXPECT_EQ(algolab::sort_custom::sortUnique(vec), 4u);
+    ASSERT_EQ(vec.size(), 4u);
+    EXPECT_TRUE(std::isnan(vec[0]));
+    EXPECT_EQ(std::vector<double>(vec.begin() + 1, vec.end()), (std::vector<double> {1.0, 2.0, 3.0}));
+
+    std::vector<float> floats {2.0f, nan, -0.0f, 0.0f, -nan, 2.0f, 0.0f};
+    EXPECT_EQ(algolab::sort_custom::sortUnique(floats), 4u);
+    ASSERT_EQ(floats.size(), 4u);
+    EXPECT_TRUE(std::isnan(floats[0]));
+    EXPECT_EQ(floats[1], 0.0f);
+    EXPECT_EQ(floats[2], 2.0f);
+    EXPECT_TRUE(std::isnan(floats[3]));
+}
+
+TEST(SortUniqueTest, Strings) {
+    std::vector<std::string> words;
+    for (int value : algolab::generateRandomNumbers<int>(20000, 0, 3000)) {
+        words.push_back("id-" + std::to_string(value));
+    }
+    auto expected = sortThenUnique(words);
+    algolab::sort_custom::sortUnique(words);
+    EXPECT_EQ(words, expected);
+}
+
+// Old ingest path: sort, unique, then one locked insert per ID; new path: fused
+// sort-unique, then one bulk load
+TEST(SortUniqueBenchmark, IngestIntoHashSet) {
+    auto raw = algolab::generateRandomNumbers<uint64_t>(2000000, 0, 500000);
+
+    auto ids = raw;
+    auto start = std::chrono::high_resolution_clock::now();
+    std::sort(ids.begin(), ids.end());
+    ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+    algolab::HashSet<uint64_t> perKey;
+    for (uint64_t id : ids) perKey.insert(id);
+    auto end = std::chrono::high_resolution_clock::now();
+    std::cout << "std::sort + unique + insert per key time: "
+              << std::chrono::duration<double, std::milli>(end - start).count() << " ms\n";
+
+    auto fused = raw;
+    start = std::chrono::high_resolution_clock::now();
+    algolab::sort_custom::sortUnique(fused);
+    auto mid = std::chrono::high_resolution_clock::now();
+    algolab::HashSet<uint64_t> bulk(algolab::uniqueKeys, fused.begin(), fused.end());
+    end = std::chrono::high_resolution_clock::now();
+    std::cout << "sortUnique time: " << std::chrono::duration<double, std::milli>(mid - start).count()
+              << " ms, bulk load time: " << std::chrono::duration<double, std::milli>(end - mid).count() << " ms\n";
+
+    EXPECT_EQ(fused, ids);
+    EXPECT_EQ(bulk.size(), perKey.size());
+}
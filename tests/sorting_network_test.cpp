@@ -0,0 +1,150 @@
+#include <gtest/gtest.h>
+#include <iostream>
+#include <chrono>
+#include <vector>
+#include <array>
+#include <string>
+#include <algorithm>
+#include <functional>
+#include "sort.h"
+#include "introsort.h"
+#include "sorting_network.h"
+
+namespace net = algolab::sort_network;
+
+/**
+ * @brief SortingNetworkTest class
+ * @details Test fixture for the compile-time sorting networks on fixed-size arrays
+ */
+template <typename T>
+class SortingNetworkTest : public ::testing::Test {
+protected:
+    std::vector<T> generate(int num) const {
+        if constexpr (std::is_integral_v<T>) {
+            return algolab::generateRandomNumbers<T>(num, -100, 100);
+        } else {
+            return algolab::generateRandomNumbers<T>(num, -100.0, 100.0);
+        }
+    }
+};
+
+using NetworkTypes = ::testing::Types<int, long long, float, double>;
+TYPED_TEST_SUITE(SortingNetworkTest, NetworkTypes);
+
+// Sorted in constant evaluation
+constexpr std::array<int, 5> sortedAtCompileTime() {
+    std::array<int, 5> arr{4, 1, 3, 0, 2};
+    net::networkSort(arr);
+    return arr;
+}
+static_assert(sortedAtCompileTime() == std::array<int, 5>{0, 1, 2, 3, 4});
+
+TYPED_TEST(SortingNetworkTest, SortsEverySizeUpToMax) {
+    for (size_t n = 0; n <= net::SORTING_NETWORK_MAX_SIZE; ++n) {
+        for (int round = 0; round < 200; ++round) {
+            std::vector<TypeParam> vec = this->generate(static_cast<int>(n));
+            std::vector<TypeParam> expected = vec;
+            std::sort(expected.begin(), expected.end());
+
+            net::sortSmall(vec.data(), n);
+            ASSERT_EQ(vec, expected) << "n = " << n;
+        }
+    }
+}
+
+TYPED_TEST(SortingNetworkTest, SortsStdArrayAndCArray) {
+    std::vector<TypeParam> data = this->generate(32);
+    std::vector<TypeParam> expected = data;
+    std::sort(expected.begin(), expected.end());
+
+    std::array<TypeParam, 32> arr;
+    std::copy(data.begin(), data.end(), arr.begin());
+    net::networkSort(arr);
+    EXPECT_TRUE(std::equal(arr.begin(), arr.end(), expected.begin()));
+
+    TypeParam raw[32];
+    std::copy(data.begin(), data.end(), raw);
+    net::networkSort(raw);
+    EXPECT_TRUE(std::equal(std::begin(raw), std::end(raw), expected.begin()));
+}
+
+TEST(SortingNetwork, CustomComparatorAndNonArithmeticTypes) {
+    std::array<int, 12> desc{5, 11, 0, 3, 9, 1, 7, 2, 10, 4, 8, 6};
+    net::networkSort(desc, std::greater<>());
+    EXPECT_TRUE(std::is_sorted(desc.begin(), desc.end(), std::greater<>()));
+
+    std::string words[7] = {"pear", "apple", "fig", "kiwi", "banana", "date", "cherry"};
+    net::networkSort(words);
+    EXPECT_TRUE(std::is_sorted(std::begin(words), std::end(words)));
+}
+
+// 0-1 principle for the generated Batcher networks, at run time to keep compilation cheap
+TEST(SortingNetwork, BatcherNetworksSortAllZeroOneInputs) {
+    EXPECT_TRUE(net::sortsAllZeroOne<9>());
+    EXPECT_TRUE(net::sortsAllZeroOne<12>());
+    EXPECT_TRUE(net::sortsAllZeroOne<16>());
+    EXPECT_TRUE(net::sortsAllZeroOne<17>());
+    EXPECT_TRUE(net::sortsAllZeroOne<20>());
+}
+
+// Neighbouring elements must not be touched
+TEST(SortingNetwork, LeavesSurroundingElementsAlone) {
+    std::vector<int> vec = algolab::generateRandomNumbers<int>(40, -100, 100);
+    std::vector<int> expected = vec;
+    std::sort(expected.begin() + 5, expected.begin() + 27);
+
+    net::sortSmall(vec.data() + 5, 22);
+    EXPECT_EQ(vec, expected);
+}
+
+// Past the largest network the range is still sorted
+TEST(SortingNetwork, SortsBeyondMaxSize) {
+    std::vector<int> vec(40);
+    for (int i = 0; i < 40; ++i) vec[i] = 40 - i;
+    std::vector<int> expected = vec;
+    std::sort(expected.begin(), expected.end());
+
+    net::sortSmall(vec.data(), vec.size());
+    EXPECT_EQ(vec, expected);
+
+    std::vector<double> wide = algolab::generateRandomNumbers<double>(100, -1.0, 1.0);
+    net::sortSmall(wide.data(), wide.size(), std::greater<>());
+    EXPECT_TRUE(std::is_sorted(wide.begin(), wide.end(), std::greater<>()));
+}
+
+namespace {
+
+template <size_t N>
+void benchmarkNetworkAgainstInsertionSort(const std::vector<int>& data) {
+    const int arrays = static_cast<int>(data.size() / N);
+    const int size = static_cast<int>(N);
+
+    auto vec = data;
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < arrays; ++i) {
+        algolab::sort_custom::insertionSort(vec, i * size, (i + 1) * size - 1);
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    double insertion = std::chrono::duration<double, std::milli>(end - start).count();
+
+    auto sorted = data;
+    start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < arrays; ++i) {
+        net::networkSortN<N>(sorted.data() + i * N);
+    }
+    end = std::chrono::high_resolution_clock::now();
+    double network = std::chrono::duration<double, std::milli>(end - start).count();
+
+    std::cout << "N = " << N << " (" << net::Network<N>::comparators.size() << " comparators): InsertionSort "
+              << insertion << " ms, network " << network << " ms\n";
+    EXPECT_TRUE(std::equal(vec.begin(), vec.begin() + arrays * N, sorted.begin()));
+}
+
+} // namespace
+
+TEST(SortingNetworkBenchmark, FixedArraysAgainstInsertionSort) {
+    auto data = algolab::generateRandomNumbers<int>(4000000, 0, 1000000);
+    [&]<size_t... N>(std::index_sequence<N...>) {
+        (benchmarkNetworkAgainstInsertionSort<N + 3>(data), ...);
+    }(std::make_index_sequence<net::SORTING_NETWORK_MAX_SIZE - 2>{});
+}
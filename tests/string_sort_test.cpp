@@ -0,0 +1,158 @@
+#include <gtest/gtest.h>
+#include <iostream>
+#include <chrono>
+#include <vector>
+#include <algorithm>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <span>
+#include "sort.h"
+#include "sort_ranges.h"
+#include "string_sort.h"
+
+/**
+ * @brief StringSortTest class
+ * @details Test fixture for the string sorts (algolab::sort_string)
+ * Checks multikey quicksort, MSD radix sort and LCP merge sort against std::sort on
+ * random, prefix-heavy, duplicate and binary keys, the LCP array and stability of the
+ * merge sort, and benchmarks them against introSortAll on order-ID style keys.
+ */
+class StringSortTest : public ::testing::Test {
+protected:
+    static constexpr int N = 1000000;
+
+    // Order IDs sharing a long venue / date prefix, like the keys of an order book
+    static std::vector<std::string> orderIds(int n) {
+        std::vector<std::string> result;
+        result.reserve(n);
+        auto venues = algolab::generateRandomNumbers<int>(n, 0, 3);
+        auto ids = algolab::generateRandomNumbers<int>(n, 0, 99999999);
+        for (int i = 0; i < n; ++i) {
+            result.push_back("XNAS-EQ-2026-10-16-SESSION-" + std::to_string(venues[i]) + "-ORDER-"
+                             + std::to_string(ids[i]));
+        }
+        return result;
+    }
+
+    static std::vector<std::string> randomStrings(int n, int maxLength, int alphabet) {
+        std::vector<std::string> result;
+        auto lengths = algolab::generateRandomNumbers<int>(n, 0, maxLength);
+        for (int length : lengths) {
+            auto chars = algolab::generateRandomNumbers<int>(length, 0, alphabet - 1);
+            std::string s;
+            for (int c : chars) s.push_back(static_cast<char>(alphabet == 256 ? c : 'a' + c));
+            result.push_back(std::move(s));
+        }
+        return result;
+    }
+
+    static void expectAllSortLikeStd(const std::vector<std::string>& input, const std::string& label) {
+        auto expected = input;
+        std::sort(expected.begin(), expected.end());
+
+        auto multikey = input;
+        algolab::sort_string::multikeyQuickSortAll(multikey);
+        EXPECT_EQ(multikey, expected) << label << " multikey";
+
+        auto radix = input;
+        algolab::sort_string::stringRadixSortAll(radix);
+        EXPECT_EQ(radix, expected) << label << " radix";
+
+        auto merge = input;
+        algolab::sort_string::lcpMergeSortAll(merge);
+        EXPECT_EQ(merge, expected) << label << " LCP merge";
+    }
+
+    static double timeMs(const std::function<void()>& func) {
+        auto start = std::chrono::high_resolution_clock::now();
+        func();
+        auto end = std::chrono::high_resolution_clock::now();
+        return std::chrono::duration<double, std::milli>(end - start).count();
+    }
+};
+
+TEST_F(StringSortTest, SortsLikeStdSort) {
+    expectAllSortLikeStd({}, "empty");
+    expectAllSortLikeStd({"solo"}, "single");
+    expectAllSortLikeStd({"b", "", "ab", "a", "", "abc", "b"}, "small");
+    expectAllSortLikeStd(randomStrings(20000, 12, 26), "random");
+    expectAllSortLikeStd(randomStrings(20000, 6, 2), "binary alphabet");
+    expectAllSortLikeStd(randomStrings(20000, 8, 256), "all byte values");
+    expectAllSortLikeStd(orderIds(20000), "order IDs");
+
+    std::vector<std::string> duplicates(5000, "AAPL");
+    for (int i = 0; i < 5000; i += 3) duplicates[i] = "MSFT";
+    expectAllSortLikeStd(duplicates, "duplicates");
+}
+
+TEST_F(StringSortTest, HandlesNestedPrefixes) {
+    // Every string is a prefix of the next one: radix buckets split off one string per level
+    std::vector<std::string> prefixes;
+    for (int length = 0; length < 3000; ++length) prefixes.push_back(std::string(length, 'a'));
+    std::reverse(prefixes.begin(), prefixes.end());
+    expectAllSortLikeStd(prefixes, "nested prefixes");
+}
+
+TEST_F(StringSortTest, SortsStringViewsAndSubranges) {
+    std::string text = "delta alpha charlie bravo echo alpha";
+    std::vector<std::string_view> words;
+    for (size_t start = 0, end; start < text.size(); start = end + 1) {
+        end = std::min(text.find(' ', start), text.size());
+        words.push_back(std::string_view(text).substr(start, end - start));
+    }
+    algolab::sort_string::stringRadixSortAll(words);
+    EXPECT_EQ(words, (std::vector<std::string_view>{"alpha", "alpha", "bravo", "charlie", "delta", "echo"}));
+
+    std::vector<std::string> symbols = {"ZZZ", "MSFT", "AAPL", "IBM", "AAA"};
+    algolab::sort_string::multikeyQuickSortAll(std::span(symbols).subspan(1, 3));
+    EXPECT_EQ(symbols, (std::vector<std::string>{"ZZZ", "AAPL", "IBM", "MSFT", "AAA"}));
+}
+
+TEST_F(StringSortTest, LcpMergeSortIsStableAndReportsLcp) {
+    // Equal contents at distinct addresses: stability shows in the order of the buffers
+    std::vector<std::string> storage = {"ba", "ab", "ba", "abc", "ab", "b"};
+    std::vector<std::string_view> views(storage.begin(), storage.end());
+    std::vector<size_t> lcp;
+    algolab::sort_string::lcpMergeSortAll(views, &lcp);
+
+    EXPECT_EQ(views, (std::vector<std::string_view>{"ab", "ab", "abc", "b", "ba", "ba"}));
+    EXPECT_EQ(views[0].data(), storage[1].data());
+    EXPECT_EQ(views[1].data(), storage[4].data());
+    EXPECT_EQ(views[4].data(), storage[0].data());
+    EXPECT_EQ(views[5].data(), storage[2].data());
+    EXPECT_EQ(lcp, (std::vector<size_t>{0, 2, 2, 0, 1, 2}));
+
+    auto ids = orderIds(50000);
+    algolab::sort_string::lcpMergeSortAll(ids, &lcp);
+    for (size_t i = 1; i < ids.size(); ++i) {
+        auto mismatch = std::mismatch(ids[i - 1].begin(), ids[i - 1].end(), ids[i].begin(), ids[i].end());
+        ASSERT_EQ(lcp[i], static_cast<size_t>(mismatch.first - ids[i - 1].begin()));
+    }
+}
+
+TEST_F(StringSortTest, BenchmarkPrefixHeavyKeys) {
+    auto data = orderIds(N);
+
+    auto intro = data;
+    double introMs = timeMs([&]() { algolab::ranges::introSortAll(intro); });
+
+    auto stdSorted = data;
+    double stdMs = timeMs([&]() { std::sort(stdSorted.begin(), stdSorted.end()); });
+
+    auto multikey = data;
+    double multikeyMs = timeMs([&]() { algolab::sort_string::multikeyQuickSortAll(multikey); });
+
+    auto radix = data;
+    double radixMs = timeMs([&]() { algolab::sort_string::stringRadixSortAll(radix); });
+
+    auto merge = data;
+    double mergeMs = timeMs([&]() { algolab::sort_string::lcpMergeSortAll(merge); });
+
+    std::cout << "1M order IDs (37-byte common prefix): introSortAll " << introMs << " ms, std::sort " << stdMs
+              << " ms, multikey quicksort " << multikeyMs << " ms, MSD radix " << radixMs << " ms, LCP merge sort "
+              << mergeMs << " ms\n";
+    EXPECT_EQ(multikey, intro);
+    EXPECT_EQ(radix, intro);
+    EXPECT_EQ(merge, intro);
+}
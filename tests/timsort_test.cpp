@@ -0,0 +1,159 @@
+#include <gtest/gtest.h>
+#include <iostream>
+#include <chrono>
+#include <vector>
+#include <algorithm>
+#include <random>
+#include <string>
+#include <functional>
+#include "sort.h"
+#include "timsort.h"
+
+/**
+ * @brief TimSortTest class
+ * @details Test fixture for the adaptive Timsort
+ * Checks stability, the comparison count on presorted and concatenated-run inputs
+ * (the quote-feed shape it is meant for), and compares it with mergeSortAll.
+ */
+namespace {
+
+// Quote keyed by venue-local price only, seq records the input order
+struct Quote {
+    int price;
+    int seq;
+
+    static inline long long comparisons = 0;
+
+    bool operator<(const Quote& other) const {
+        ++comparisons;
+        return price < other.price;
+    }
+};
+
+} // namespace
+
+class TimSortTest : public ::testing::Test {
+protected:
+    static constexpr int N = 1000000;
+
+    // k sorted runs of equal length concatenated, like per-venue streams
+    static std::vector<int> concatenatedRuns(int k) {
+        std::vector<int> result;
+        result.reserve(N);
+        for (int run = 0; run < k; ++run) {
+            auto chunk = algolab::generateRandomNumbers<int>(N / k, 0, N);
+            std::sort(chunk.begin(), chunk.end());
+            result.insert(result.end(), chunk.begin(), chunk.end());
+        }
+        return result;
+    }
+
+    static std::vector<Quote> toQuotes(const std::vector<int>& prices) {
+        std::vector<Quote> quotes;
+        quotes.reserve(prices.size());
+        for (size_t i = 0; i < prices.size(); ++i) {
+            quotes.push_back({prices[i], static_cast<int>(i)});
+        }
+        return quotes;
+    }
+
+    static double timeMs(const std::function<void()>& func) {
+        auto start = std::chrono::high_resolution_clock::now();
+        func();
+        auto end = std::chrono::high_resolution_clock::now();
+        return std::chrono::duration<double, std::milli>(end - start).count();
+    }
+};
+
+TEST_F(TimSortTest, ComputeMinRun) {
+    EXPECT_EQ(algolab::sort_custom::computeMinRun(31), 31);
+    EXPECT_EQ(algolab::sort_custom::computeMinRun(64), 16);
+    EXPECT_EQ(algolab::sort_custom::computeMinRun(65), 17);
+    for (int n : {100, 1000, 4096, 123457, N}) {
+        int minRun = algolab::sort_custom::computeMinRun(n);
+        EXPECT_GE(minRun, 16) << n;
+        EXPECT_LE(minRun, 32) << n;
+    }
+}
+
+TEST_F(TimSortTest, IsStable) {
+    auto quotes = toQuotes(algolab::generateRandomNumbers<int>(N, 0, 1000));
+    algolab::sort_custom::timSortAll(quotes);
+
+    for (size_t i = 1; i < quotes.size(); ++i) {
+        ASSERT_LE(quotes[i - 1].price, quotes[i].price);
+        if (quotes[i - 1].price == quotes[i].price) {
+            ASSERT_LT(quotes[i - 1].seq, quotes[i].seq) << "Equal prices reordered at index " << i;
+        }
+    }
+}
+
+TEST_F(TimSortTest, PresortedInputIsLinear) {
+    std::vector<int> prices(N);
+    for (int i = 0; i < N; ++i) prices[i] = i / 4; // ascending with duplicates
+
+    auto ascending = toQuotes(prices);
+    Quote::comparisons = 0;
+    algolab::sort_custom::timSortAll(ascending);
+    EXPECT_EQ(Quote::comparisons, N - 1);
+
+    // Strictly descending: one run, reversed in place
+    std::vector<int> descending(N);
+    for (int i = 0; i < N; ++i) descending[i] = N - i;
+    auto reversed = toQuotes(descending);
+    Quote::comparisons = 0;
+    algolab::sort_custom::timSortAll(reversed);
+    EXPECT_EQ(Quote::comparisons, N - 1);
+    EXPECT_TRUE(std::is_sorted(reversed.begin(), reversed.end()));
+}
+
+TEST_F(TimSortTest, ConcatenatedRunsAreCheap) {
+    constexpr int runs = 8;
+    auto quotes = toQuotes(concatenatedRuns(runs));
+    Quote::comparisons = 0;
+    algolab::sort_custom::timSortAll(quotes);
+
+    // Run detection plus log2(8) = 3 merge levels, instead of log2(N) ~ 20 for a merge sort
+    EXPECT_LE(Quote::comparisons, static_cast<long long>(N) * 4);
+    EXPECT_TRUE(std::is_sorted(quotes.begin(), quotes.end()));
+}
+
+TEST_F(TimSortTest, SortsPatterns) {
+    std::vector<std::pair<std::string, std::vector<int>>> patterns;
+    patterns.push_back({"Runs8", concatenatedRuns(8)});
+    patterns.push_back({"Runs1000", concatenatedRuns(1000)});
+    patterns.push_back({"FewUnique", algolab::generateRandomNumbers<int>(N, 0, 8)});
+
+    std::vector<int> organPipe(N);
+    for (int i = 0; i < N; ++i) organPipe[i] = i < N / 2 ? i : N - i;
+    patterns.push_back({"OrganPipe", organPipe});
+
+    std::vector<int> sawtooth(N);
+    for (int i = 0; i < N; ++i) sawtooth[i] = i % 1000;
+    patterns.push_back({"Sawtooth", sawtooth});
+
+    for (auto& [name, data] : patterns) {
+        std::vector<int> expected = data;
+        std::sort(expected.begin(), expected.end());
+
+        algolab::sort_custom::timSortAll(data);
+        EXPECT_EQ(data, expected) << name;
+    }
+}
+
+TEST_F(TimSortTest, BenchmarkAgainstMergeSort) {
+    std::vector<std::pair<std::string, std::vector<int>>> inputs;
+    inputs.push_back({"Runs8", concatenatedRuns(8)});
+    inputs.push_back({"Random", algolab::generateRandomNumbers<int>(N, 0, N)});
+
+    for (auto& [name, data] : inputs) {
+        std::vector<int> merge = data;
+        std::vector<int> tim = data;
+
+        double mergeMs = timeMs([&]() { algolab::mergeSortAll(merge); });
+        double timMs = timeMs([&]() { algolab::sort_custom::timSortAll(tim); });
+
+        std::cout << name << " (1M int): MergeSort " << mergeMs << " ms, TimSort " << timMs << " ms\n";
+        EXPECT_EQ(merge, tim) << name;
+    }
+}
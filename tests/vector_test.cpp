@@ -1,6 +1,9 @@
 
 #include <gtest/gtest.h>
 #include <vector>
+#include <string>
+#include <chrono>
+#include <stdexcept>
 #include "vector.h"
 #include <thread>
 #include <mutex>
@@ -68,6 +71,25 @@ TEST(VectorTest, AverageAndMedian) {
     EXPECT_DOUBLE_EQ(v.median(), 2.5);
 }
 
+TEST(VectorTest, MedianSelectsInPlace) {
+    algolab::Vector<int> v;
+    for (int i = 100000; i > 0; --i) v.push_back(i % 1000);
+
+    EXPECT_DOUBLE_EQ(v.median(), 499.5);
+    EXPECT_EQ(v[0], 0) << "median() must not reorder the vector";
+    EXPECT_EQ(v[1], 999);
+
+    EXPECT_DOUBLE_EQ(v.medianInPlace(), 499.5);
+    v.push_back(1000);
+    EXPECT_DOUBLE_EQ(v.medianInPlace(), 500.0);
+
+    algolab::Vector<int> small;
+    for (int value : {5, 1, 4, 2, 3}) small.push_back(value);
+    EXPECT_DOUBLE_EQ(small.median(), 3.0);
+    EXPECT_EQ(small[0], 5);
+    EXPECT_EQ(small[4], 3);
+}
+
 TEST(VectorTest, EmplaceBackWithPerson) {
     algolab::Vector<Person> people;
     
@@ -87,6 +109,121 @@ TEST(VectorTest, EmplaceBackWithPerson) {
     EXPECT_EQ(people[2].name, "Charlie");
 }
 
+namespace {
+
+// Counts the live objects and how they were made; copies throw once copiesBeforeThrow runs out
+struct Tracked {
+    static inline int live = 0;
+    static inline int copies = 0;
+    static inline int moves = 0;
+    static inline int copiesBeforeThrow = -1;
+    int value;
+
+    explicit Tracked(int v) : value(v) { ++live; }
+    Tracked(const Tracked& other) : value(other.value) {
+        if (copiesBeforeThrow-- == 0) throw std::runtime_error("copy failed");
+        ++live;
+        ++copies;
+    }
+    // Not noexcept: growing a Vector must copy instead, to keep its strong guarantee
+    Tracked(Tracked&& other) : value(other.value) { ++live; ++moves; }
+    Tracked& operator=(const Tracked&) = default;
+    Tracked& operator=(Tracked&&) = default;
+    ~Tracked() { --live; }
+
+    static void reset() {
+        live = copies = moves = 0;
+        copiesBeforeThrow = -1;
+    }
+};
+
+} // namespace
+
+TEST(VectorTest, ConstructsOnlyLiveElements) {
+    Tracked::reset();
+    {
+        algolab::Vector<Tracked> v(4);
+        EXPECT_EQ(Tracked::live, 0) << "an empty Vector holds no objects";
+
+        for (int i = 0; i < 1000; ++i) v.emplace_back(i);
+        EXPECT_EQ(Tracked::live, 1000);
+        // Every growth relocated the elements by copy, the throwing move was never used
+        EXPECT_EQ(Tracked::moves, 0);
+        EXPECT_GT(Tracked::copies, 0);
+
+        v.pop_back();
+        v.erase(0);
+        EXPECT_EQ(Tracked::live, 998);
+        EXPECT_EQ(v[0].value, 1);
+        EXPECT_EQ(v.back().value, 998);
+
+        algolab::Vector<Tracked> copy = v;
+        EXPECT_EQ(Tracked::live, 2 * 998);
+        copy.clear();
+        EXPECT_EQ(Tracked::live, 998);
+        copy = v;
+        v.shrink_to_fit();
+        EXPECT_EQ(v.capacity(), 998u);
+        EXPECT_EQ(Tracked::live, 2 * 998);
+    }
+    EXPECT_EQ(Tracked::live, 0);
+}
+
+// A copy failing halfway through reserve leaves the Vector as it was
+TEST(VectorTest, ReserveKeepsElementsWhenACopyThrows) {
+    Tracked::reset();
+    {
+        algolab::Vector<Tracked> v(8);
+        for (int i = 0; i < 8; ++i) v.emplace_back(i);
+        Tracked::copiesBeforeThrow = 5;
+        EXPECT_THROW(v.reserve(64), std::runtime_error);
+        EXPECT_EQ(v.capacity(), 8u);
+        EXPECT_EQ(v.size(), 8u);
+        EXPECT_EQ(Tracked::live, 8);
+        for (int i = 0; i < 8; ++i) EXPECT_EQ(v[i].value, i);
+
+        Tracked::copiesBeforeThrow = -1;
+        v.reserve(64);
+        EXPECT_EQ(v.capacity(), 64u);
+        EXPECT_EQ(v.back().value, 7);
+    }
+    EXPECT_EQ(Tracked::live, 0);
+}
+
+TEST(VectorTest, PushBackOwnElementWhileGrowing) {
+    algolab::Vector<std::string> words(1);
+    words.push_back(std::string(40, 'q'));
+    for (int i = 0; i < 6; ++i) words.push_back(words[0]); // Reallocates at sizes 1, 2 and 4
+    EXPECT_EQ(words.size(), 7u);
+    EXPECT_EQ(words.back(), std::string(40, 'q'));
+
+    algolab::Vector<int> ints(1, algolab::Vector<int>::LOG_CAPACITY_METHOD);
+    ints.push_back(7);
+    for (int i = 0; i < 100; ++i) ints.push_back(ints[i]); // realloc path
+    EXPECT_EQ(ints.size(), 101u);
+    EXPECT_EQ(ints.back(), 7);
+}
+
+namespace {
+
+// Move-only, no default constructor
+struct Ticket {
+    std::unique_ptr<int> id;
+    explicit Ticket(int i) : id(std::make_unique<int>(i)) {}
+};
+
+} // namespace
+
+TEST(VectorTest, HoldsTypesWithoutDefaultConstructor) {
+    algolab::Vector<Ticket> tickets(2);
+    for (int i = 0; i < 100; ++i) tickets.emplace_back(i);
+    EXPECT_EQ(*tickets[99].id, 99);
+
+    algolab::Vector<Ticket> moved = std::move(tickets);
+    EXPECT_EQ(*moved.front().id, 0);
+    EXPECT_EQ(tickets.size(), 0u);
+}
+
 TEST(VectorBenchmark, CompareWithStdVector) {
     constexpr size_t N = 1'000'000;
 
@@ -169,3 +306,53 @@ TEST(MemoryFootprintTest, CompareVectorMemoryUsage) {
 
     EXPECT_EQ(stdVec.size(), myVec.size());
 }
+
+namespace {
+
+struct MarketQuote {
+    std::string symbol;
+    double price;
+    uint64_t id;
+};
+
+} // namespace
+
+// Construction of empty Vectors and growth of string / struct Vectors against std::vector
+TEST(VectorBenchmark, ConstructAndGrowNonTrivialTypes) {
+    constexpr int EMPTY = 10000;
+    constexpr int N = 200000;
+
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < EMPTY; ++i) {
+        algolab::Vector<std::string> empty;
+        EXPECT_TRUE(empty.empty());
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    std::cout << "algolab::Vector<std::string> 10K empty constructions time: "
+              << std::chrono::duration<double, std::milli>(end - start).count() << " ms\n";
+
+    start = std::chrono::high_resolution_clock::now();
+    algolab::Vector<std::string> strings(1);
+    for (int i = 0; i < N; ++i) strings.push_back("quote-" + std::to_string(i) + "-XNYS-2026");
+    end = std::chrono::high_resolution_clock::now();
+    std::cout << "algolab::Vector<std::string> 200K push_back time: "
+              << std::chrono::duration<double, std::milli>(end - start).count() << " ms\n";
+
+    start = std::chrono::high_resolution_clock::now();
+    std::vector<std::string> stdStrings;
+    for (int i = 0; i < N; ++i) stdStrings.push_back("quote-" + std::to_string(i) + "-XNYS-2026");
+    end = std::chrono::high_resolution_clock::now();
+    std::cout << "std::vector<std::string> 200K push_back time: "
+              << std::chrono::duration<double, std::milli>(end - start).count() << " ms\n";
+
+    start = std::chrono::high_resolution_clock::now();
+    algolab::Vector<MarketQuote> quotes(1);
+    for (int i = 0; i < N; ++i) quotes.emplace_back(MarketQuote{"AAPL", 100.0 + i, static_cast<uint64_t>(i)});
+    end = std::chrono::high_resolution_clock::now();
+    std::cout << "algolab::Vector<MarketQuote> 200K emplace_back time: "
+              << std::chrono::duration<double, std::milli>(end - start).count() << " ms\n";
+
+    EXPECT_EQ(strings.size(), stdStrings.size());
+    EXPECT_EQ(strings.back(), stdStrings.back());
+    EXPECT_EQ(quotes.back().id, static_cast<uint64_t>(N - 1));
+}